@@ -9,7 +9,8 @@ CPP_SRCS += \
 ../src/specifiers/function_declaration.cpp \
 ../src/specifiers/function_type_specifier.cpp \
 ../src/specifiers/primitive_type_specifier.cpp \
-../src/specifiers/sum_type_specifier.cpp 
+../src/specifiers/sum_type_specifier.cpp \
+../src/specifiers/type_specifier.cpp 
 
 OBJS += \
 ./src/specifiers/array_type_specifier.o \
@@ -17,7 +18,8 @@ OBJS += \
 ./src/specifiers/function_declaration.o \
 ./src/specifiers/function_type_specifier.o \
 ./src/specifiers/primitive_type_specifier.o \
-./src/specifiers/sum_type_specifier.o 
+./src/specifiers/sum_type_specifier.o \
+./src/specifiers/type_specifier.o 
 
 CPP_DEPS += \
 ./src/specifiers/array_type_specifier.d \
@@ -25,7 +27,8 @@ CPP_DEPS += \
 ./src/specifiers/function_declaration.d \
 ./src/specifiers/function_type_specifier.d \
 ./src/specifiers/primitive_type_specifier.d \
-./src/specifiers/sum_type_specifier.d 
+./src/specifiers/sum_type_specifier.d \
+./src/specifiers/type_specifier.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
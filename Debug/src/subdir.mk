@@ -4,76 +4,130 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/allocation_counter.cpp \
+../src/arena.cpp \
 ../src/array.cpp \
 ../src/assert.cpp \
+../src/atom.cpp \
+../src/benchmark.cpp \
+../src/bytecode.cpp \
+../src/compiler.cpp \
 ../src/compound_type.cpp \
 ../src/compound_type_instance.cpp \
+../src/cycle_collector.cpp \
 ../src/defaults.cpp \
 ../src/driver.cpp \
 ../src/error.cpp \
 ../src/execution_context.cpp \
+../src/frame_layout.cpp \
+../src/frame_pool.cpp \
 ../src/function.cpp \
 ../src/indent.cpp \
 ../src/member_declaration.cpp \
 ../src/member_definition.cpp \
 ../src/member_instantiation.cpp \
 ../src/newt.cpp \
+../src/performance_counters.cpp \
+../src/persistent_vector.cpp \
+../src/profiler.cpp \
+../src/program_cache.cpp \
+../src/script.cpp \
+../src/statistics.cpp \
 ../src/sum.cpp \
 ../src/symbol.cpp \
 ../src/symbol_context.cpp \
 ../src/symbol_context_list.cpp \
 ../src/symbol_table.cpp \
+../src/syntax_tree_reader.cpp \
+../src/syntax_tree_writer.cpp \
 ../src/type.cpp \
 ../src/type_table.cpp \
-../src/utils.cpp 
+../src/utils.cpp \
+../src/virtual_machine.cpp 
 
 OBJS += \
+./src/allocation_counter.o \
+./src/arena.o \
 ./src/array.o \
 ./src/assert.o \
+./src/atom.o \
+./src/benchmark.o \
+./src/bytecode.o \
+./src/compiler.o \
 ./src/compound_type.o \
 ./src/compound_type_instance.o \
+./src/cycle_collector.o \
 ./src/defaults.o \
 ./src/driver.o \
 ./src/error.o \
 ./src/execution_context.o \
+./src/frame_layout.o \
+./src/frame_pool.o \
 ./src/function.o \
 ./src/indent.o \
 ./src/member_declaration.o \
 ./src/member_definition.o \
 ./src/member_instantiation.o \
 ./src/newt.o \
+./src/performance_counters.o \
+./src/persistent_vector.o \
+./src/profiler.o \
+./src/program_cache.o \
+./src/script.o \
+./src/statistics.o \
 ./src/sum.o \
 ./src/symbol.o \
 ./src/symbol_context.o \
 ./src/symbol_context_list.o \
 ./src/symbol_table.o \
+./src/syntax_tree_reader.o \
+./src/syntax_tree_writer.o \
 ./src/type.o \
 ./src/type_table.o \
-./src/utils.o 
+./src/utils.o \
+./src/virtual_machine.o 
 
 CPP_DEPS += \
+./src/allocation_counter.d \
+./src/arena.d \
 ./src/array.d \
 ./src/assert.d \
+./src/atom.d \
+./src/benchmark.d \
+./src/bytecode.d \
+./src/compiler.d \
 ./src/compound_type.d \
 ./src/compound_type_instance.d \
+./src/cycle_collector.d \
 ./src/defaults.d \
 ./src/driver.d \
 ./src/error.d \
 ./src/execution_context.d \
+./src/frame_layout.d \
+./src/frame_pool.d \
 ./src/function.d \
 ./src/indent.d \
 ./src/member_declaration.d \
 ./src/member_definition.d \
 ./src/member_instantiation.d \
 ./src/newt.d \
+./src/performance_counters.d \
+./src/persistent_vector.d \
+./src/profiler.d \
+./src/program_cache.d \
+./src/script.d \
+./src/statistics.d \
 ./src/sum.d \
 ./src/symbol.d \
 ./src/symbol_context.d \
 ./src/symbol_context_list.d \
 ./src/symbol_table.d \
+./src/syntax_tree_reader.d \
+./src/syntax_tree_writer.d \
 ./src/type.d \
 ./src/type_table.d \
-./src/utils.d 
+./src/utils.d \
+./src/virtual_machine.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
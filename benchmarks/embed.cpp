@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//benchmark: load a script through the embedding API and call one of its
+//functions repeatedly, as a service evaluating it per request would
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <allocation_counter.h>
+#include <script.h>
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		std::cerr << "Usage: " << argv[0] << " <iterations> <script>"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const int iterations = atoi(argv[1]);
+	std::vector<std::string> errors;
+
+	auto start = std::chrono::steady_clock::now();
+	auto script = Script::Load(argv[2], errors);
+	auto end = std::chrono::steady_clock::now();
+	if (!script) {
+		for (auto error : errors) {
+			std::cerr << error << std::endl;
+		}
+		return EXIT_FAILURE;
+	}
+	std::cout << "load: "
+			<< std::chrono::duration<double, std::milli>(end - start).count()
+			<< " ms" << std::endl;
+
+	auto function = script->GetFunction("scale");
+	if (!function) {
+		std::cerr << "No function 'scale' with primitive parameters found."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<ScriptValue> arguments(2);
+	arguments[1] = ScriptValue(0.5);
+	ScriptValue result;
+	double total = 0;
+	const size_t allocations = AllocationCounter::GetCount();
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) {
+		arguments[0] = ScriptValue(i);
+		if (!function->Call(arguments, result, errors)) {
+			for (auto error : errors) {
+				std::cerr << error << std::endl;
+			}
+			return EXIT_FAILURE;
+		}
+		total += result.GetDouble();
+	}
+	end = std::chrono::steady_clock::now();
+
+	const double nanoseconds =
+			std::chrono::duration<double, std::nano>(end - start).count();
+	std::cout << iterations << " calls: " << nanoseconds / 1e6 << " ms, "
+			<< nanoseconds / iterations << " ns/call, "
+			<< static_cast<double>(AllocationCounter::GetCount()
+					- allocations) / iterations << " allocations/call"
+			<< std::endl;
+
+	//so that the calls can't be optimized away, and as a check on the results
+	std::cout << "total: " << total << std::endl;
+	return EXIT_SUCCESS;
+}
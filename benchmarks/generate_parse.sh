@@ -0,0 +1,27 @@
+#!/bin/bash
+# benchmark: generate a script of the given number of lines (default 100000)
+# that exercises declarations, expressions, control flow and function literals,
+# for timing the parser with `newt --parse-only`
+
+lines=${1:-100000}
+
+awk -v lines="$lines" 'BEGIN {
+	print "// generated parser benchmark"
+	count = 1
+	for (i = 0; count + 10 <= lines; i++) {
+		print "v" i ":int = (" i " + 3) * 2 - " i " / 7"
+		print "s" i ":string = \"line \" + " i
+		print "if (v" i " > 10 && v" i " < 100000) {"
+		print "\tv" i " = v" i " + 1"
+		print "} else {"
+		print "\tv" i " -= 1"
+		print "}"
+		print "f" i " := (a:int, b:double = 1.5) -> double {"
+		print "\treturn a * b + v" i
+		print "}"
+		count += 10
+	}
+	for (; count < lines; count++) {
+		print "//"
+	}
+}'
@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//benchmark: load and run a script repeatedly on 1, 2, 4... threads at once,
+//each load parsing and executing it afresh, and report how the throughput
+//scales. The scripts' output goes to stdout and the report to stderr.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <script.h>
+
+namespace {
+const bool Run(const std::string& file_name, const int iterations) {
+	for (int i = 0; i < iterations; i++) {
+		std::vector<std::string> errors;
+		auto script = Script::Load(file_name, errors);
+		if (!script) {
+			for (auto error : errors) {
+				std::cerr << error << std::endl;
+			}
+			return false;
+		}
+	}
+	return true;
+}
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 3) {
+		std::cerr << "Usage: " << argv[0]
+				<< " <iterations> <script> [max threads]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const int iterations = atoi(argv[1]);
+	const std::string file_name = argv[2];
+	int max_threads = argc > 3 ? atoi(argv[3]) : 0;
+	if (max_threads <= 0) {
+		max_threads = std::max(1U, std::thread::hardware_concurrency());
+	}
+
+	//fail early, and warm up the process-wide tables
+	if (!Run(file_name, 1)) {
+		return EXIT_FAILURE;
+	}
+
+	std::vector<int> counts;
+	for (int threads = 1; threads < max_threads; threads *= 2) {
+		counts.push_back(threads);
+	}
+	counts.push_back(max_threads);
+
+	double base_rate = 0;
+	for (const int threads : counts) {
+		std::atomic<bool> failed(false);
+		std::vector<std::thread> workers;
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < threads; i++) {
+			workers.push_back(std::thread([&]() {
+				if (!Run(file_name, iterations)) {
+					failed = true;
+				}
+			}));
+		}
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		auto end = std::chrono::steady_clock::now();
+		if (failed) {
+			return EXIT_FAILURE;
+		}
+
+		const double seconds =
+				std::chrono::duration<double>(end - start).count();
+		const double rate = threads * iterations / seconds;
+		if (threads == 1) {
+			base_rate = rate;
+		}
+		std::cerr << threads << " threads: " << rate << " runs/s, speedup "
+				<< rate / base_rate << ", efficiency "
+				<< 100 * rate / base_rate / threads << "%" << std::endl;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <allocation_counter.h>
+#include <cstdlib>
+#include <new>
+
+#include <statistics.h>
+
+namespace {
+//per thread, so that counting shares no cache line between threads
+thread_local size_t allocation_count = 0;
+}
+
+//count every allocation made through the global operator new;
+//the array and nothrow forms are implemented in terms of this one
+void* operator new(std::size_t size) {
+	allocation_count++;
+	STATISTICS_ADD(ALLOCATED_BYTES, size);
+	void* result = std::malloc(size ? size : 1);
+	if (!result) {
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+const size_t AllocationCounter::GetCount() {
+	return allocation_count;
+}
@@ -0,0 +1,41 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALLOCATION_COUNTER_H_
+#define ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+/**
+ * Counts the allocations made through the global operator new, which this
+ * object replaces. It is linked into the newt binary but kept out of
+ * libnewt.a, so that linking the library leaves a host's operator new alone.
+ * A host that wants newt's allocation figures links it explicitly and
+ * installs GetCount with Benchmark::SetAllocationHook.
+ */
+class AllocationCounter {
+public:
+	/**
+	 * The number of allocations made through operator new so far by the calling
+	 * thread.
+	 */
+	static const size_t GetCount();
+};
+
+#endif /* ALLOCATION_COUNTER_H_ */
@@ -0,0 +1,42 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <arena.h>
+
+Arena::Arena() :
+		m_chunks(), m_position(0), m_end(0), m_allocated(0) {
+}
+
+Arena::~Arena() {
+	for (auto chunk : m_chunks) {
+		::operator delete(chunk);
+	}
+}
+
+void* Arena::AllocateChunk(const size_t size, const size_t alignment) {
+	//oversized requests get a chunk of their own
+	const size_t chunk_size =
+			size + alignment > CHUNK_SIZE ? size + alignment : CHUNK_SIZE;
+	void* chunk = ::operator new(chunk_size);
+	m_chunks.push_back(chunk);
+
+	m_position = reinterpret_cast<uintptr_t>(chunk);
+	m_end = m_position + chunk_size;
+	return Allocate(size, alignment);
+}
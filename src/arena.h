@@ -0,0 +1,127 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * A bump allocator for objects that share a single lifetime, such as the nodes of
+ * a parsed program.
+ *
+ * Allocation advances a pointer into the current chunk. Individual objects are
+ * never freed; all of the arena's memory is released at once when it is destroyed,
+ * so nothing allocated from an arena may outlive it.
+ */
+class Arena {
+public:
+	Arena();
+	virtual ~Arena();
+
+	void* Allocate(const size_t size, const size_t alignment) {
+		uintptr_t position = (m_position + alignment - 1) & ~(alignment - 1);
+		if (position + size > m_end) {
+			return AllocateChunk(size, alignment);
+		}
+
+		m_position = position + size;
+		m_allocated += size;
+		return reinterpret_cast<void*>(position);
+	}
+
+	const size_t GetAllocatedSize() const {
+		return m_allocated;
+	}
+
+private:
+	Arena(const Arena& other) = delete;
+	Arena& operator=(const Arena& other) = delete;
+
+	void* AllocateChunk(const size_t size, const size_t alignment);
+
+	static const size_t CHUNK_SIZE = 64 * 1024;
+
+	std::vector<void*> m_chunks;
+	uintptr_t m_position;
+	uintptr_t m_end;
+	size_t m_allocated;
+};
+
+/**
+ * A standard allocator backed by an arena. Deallocation is a no-op.
+ */
+template<typename T> class ArenaAllocator {
+public:
+	typedef T value_type;
+
+	template<typename U> struct rebind {
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator(Arena& arena) :
+			m_arena(&arena) {
+	}
+
+	template<typename U> ArenaAllocator(const ArenaAllocator<U>& other) :
+			m_arena(other.GetArena()) {
+	}
+
+	T* allocate(const size_t count) {
+		return static_cast<T*>(m_arena->Allocate(count * sizeof(T),
+				alignof(T)));
+	}
+
+	void deallocate(T* pointer, const size_t count) {
+	}
+
+	//constructing through the allocator lets friend classes
+	//keep their constructors private
+	template<typename U, typename ... Args> void construct(U* pointer,
+			Args&&... args) {
+		::new ((void*) pointer) U(std::forward<Args>(args)...);
+	}
+
+	template<typename U> void destroy(U* pointer) {
+		pointer->~U();
+	}
+
+	Arena* GetArena() const {
+		return m_arena;
+	}
+
+	template<typename U> const bool operator==(
+			const ArenaAllocator<U>& other) const {
+		return m_arena == other.GetArena();
+	}
+
+	template<typename U> const bool operator!=(
+			const ArenaAllocator<U>& other) const {
+		return m_arena != other.GetArena();
+	}
+
+private:
+	Arena* m_arena;
+};
+
+#endif /* ARENA_H_ */
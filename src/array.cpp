@@ -18,81 +18,251 @@
  */
 
 #include <array.h>
+#include <persistent_vector.h>
+#include <cycle_collector.h>
 
-const string Array::ToString(const TypeTable& type_table,
-		const Indent& indent) const {
-	ostringstream os;
+namespace {
 
-	const_shared_ptr<TypeSpecifier> element_type = GetElementType();
-	int size = GetSize();
+/**
+ * Conversions between values and the unboxed elements an array stores.
+ *
+ * SHARED_DEFAULT indicates whether a single default element may be shared by
+ * every slot that is filled with defaults; it may not for values, since struct
+ * instances are updated in place.
+ */
+template<class T> struct ArrayElement;
 
-	Indent child_indent = indent + 1;
+template<> struct ArrayElement<bool> {
+	static const bool SHARED_DEFAULT = true;
 
-	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
-					element_type);
-	if (as_primitive) {
-		const BasicType basic_type = as_primitive->GetBasicType();
-		switch (basic_type) {
-		case INT: {
-			for (int i = 0; i < size; i++) {
-				os << child_indent << "[" << i << "] "
-						<< *(GetValue<int>(i, type_table)) << endl;
-			}
-			break;
-		}
-		case DOUBLE: {
-			for (int i = 0; i < size; i++) {
-				os << child_indent << "[" << i << "] "
-						<< *(GetValue<double>(i, type_table)) << endl;
-			}
-			break;
-		}
-		case STRING: {
-			for (int i = 0; i < size; i++) {
-				os << child_indent << "[" << i << "] \""
-						<< *(GetValue<string>(i, type_table)) << "\"" << endl;
-			}
-			break;
+	static const bool FromValue(const Value& value) {
+		return value.GetBoolean();
+	}
+
+	static const Value ToValue(const bool element) {
+		return Value(element);
+	}
+
+	static void Write(ostream& os, const bool element) {
+		os << (element ? 1 : 0);
+	}
+};
+
+template<> struct ArrayElement<int> {
+	static const bool SHARED_DEFAULT = true;
+
+	static const int FromValue(const Value& value) {
+		return value.GetInt();
+	}
+
+	static const Value ToValue(const int element) {
+		return Value(element);
+	}
+
+	static void Write(ostream& os, const int element) {
+		os << element;
+	}
+};
+
+template<> struct ArrayElement<double> {
+	static const bool SHARED_DEFAULT = true;
+
+	static const double FromValue(const Value& value) {
+		return value.GetDouble();
+	}
+
+	static const Value ToValue(const double element) {
+		return Value(element);
+	}
+
+	static void Write(ostream& os, const double element) {
+		os << element;
+	}
+};
+
+template<> struct ArrayElement<plain_shared_ptr<string>> {
+	static const bool SHARED_DEFAULT = true;
+
+	static const plain_shared_ptr<string> FromValue(const Value& value) {
+		return value.GetReference<string>();
+	}
+
+	static const Value ToValue(const plain_shared_ptr<string>& element) {
+		return Value(element);
+	}
+
+	static void Write(ostream& os, const plain_shared_ptr<string>& element) {
+		os << "\"" << *element << "\"";
+	}
+};
+
+template<> struct ArrayElement<Value> {
+	static const bool SHARED_DEFAULT = false;
+
+	static const Value& FromValue(const Value& value) {
+		return value;
+	}
+
+	static const Value& ToValue(const Value& element) {
+		return element;
+	}
+};
+
+template<class T> class TypedArray: public Array {
+public:
+	TypedArray(const_shared_ptr<ArrayTypeSpecifier> type_specifier,
+			const PersistentVector<T>& elements) :
+			Array(type_specifier), m_elements(elements) {
+	}
+
+	virtual const string ToString(const TypeTable& type_table,
+			const Indent& indent) const;
+
+	virtual const Value GetValue(const int index,
+			const TypeTable& type_table) const {
+		if (0 <= index && index < GetSize()) {
+			return ArrayElement<T>::ToValue(m_elements.Get(index));
+		} else {
+			return GetElementType()->DefaultValue(type_table);
 		}
-		default:
-			break;
+	}
+
+	virtual const_shared_ptr<Array> WithValue(const int index,
+			const Value& value, const TypeTable& type_table) const {
+		const T element = ArrayElement<T>::FromValue(value);
+		if (index < GetSize()) {
+			return make_shared<TypedArray<T>>(GetTypeSpecifier(),
+					m_elements.WithValue(index, element));
+		} else {
+			//fill with default values
+			const_shared_ptr<TypeSpecifier> element_type = GetElementType();
+			const T default_element = ArrayElement<T>::FromValue(
+					element_type->DefaultValue(type_table));
+			auto elements = m_elements.WithAppended(index - GetSize(),
+					[&default_element, &element_type, &type_table]() {
+						return ArrayElement<T>::SHARED_DEFAULT ?
+								default_element :
+								ArrayElement<T>::FromValue(
+										element_type->DefaultValue(
+												type_table));
+					}).WithAppended(1, [&element]() {
+						return element;
+					});
+			return make_shared<TypedArray<T>>(GetTypeSpecifier(), elements);
 		}
-		os << "end array";
 	}
 
-	const_shared_ptr<ArrayTypeSpecifier> as_array = std::dynamic_pointer_cast<
-			const ArrayTypeSpecifier>(element_type);
+	virtual const int GetSize() const {
+		return m_elements.GetSize();
+	}
+
+	virtual void Trace(Tracer& tracer) const;
+
+private:
+	const PersistentVector<T> m_elements;
+};
+
+template<class T> const string TypedArray<T>::ToString(
+		const TypeTable& type_table, const Indent& indent) const {
+	ostringstream os;
+
+	Indent child_indent = indent + 1;
+
+	int i = 0;
+	m_elements.ForEach([&os, &child_indent, &i](const T& element) {
+		os << child_indent << "[" << i++ << "] ";
+		ArrayElement<T>::Write(os, element);
+		os << endl;
+	});
+	os << "end array";
+
+	return os.str();
+}
+
+template<> const string TypedArray<Value>::ToString(
+		const TypeTable& type_table, const Indent& indent) const {
+	ostringstream os;
+
+	const_shared_ptr<TypeSpecifier> element_type = GetElementType();
+
+	Indent child_indent = indent + 1;
+	int i = 0;
+
+	const_shared_ptr<ArrayTypeSpecifier> as_array =
+			specifier_cast<ArrayTypeSpecifier>(element_type);
 	if (as_array) {
-		for (int i = 0; i < size; i++) {
-			auto sub_array = static_pointer_cast<const Array>(
-					GetValue<Array>(i, type_table));
-			os << child_indent << "[" << i << "]: " << endl
-					<< sub_array->ToString(type_table, child_indent);
-		}
+		m_elements.ForEach(
+				[&os, &type_table, &child_indent, &i](const Value& element) {
+					auto sub_array = element.GetReference<Array>();
+					os << child_indent << "[" << i++ << "]: " << endl
+							<< sub_array->ToString(type_table, child_indent);
+				});
 	}
 
 	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+			specifier_cast<CompoundTypeSpecifier>(
 					element_type);
 	if (as_compound) {
-		for (int i = 0; i < size; i++) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					GetValue<CompoundTypeInstance>(i, type_table));
-			os << child_indent << "[" << i << "]: " << endl
-					<< instance->ToString(type_table, child_indent + 1);
-		}
+		m_elements.ForEach(
+				[&os, &type_table, &child_indent, &i](const Value& element) {
+					auto instance = element.GetReference<
+							CompoundTypeInstance>();
+					os << child_indent << "[" << i++ << "]: " << endl
+							<< instance->ToString(type_table, child_indent + 1);
+				});
 	}
 
 	return os.str();
 }
 
-const shared_ptr<const vector<shared_ptr<const void>>> Array::GetStorage(
-		const_shared_ptr<TypeSpecifier> element_specifier,
-		const int initial_size, const TypeTable& type_table) {
-	auto storage = new vector<shared_ptr<const void>>(initial_size, element_specifier->DefaultValue(
-					type_table));
-	auto result = const_shared_ptr<const vector<shared_ptr<const void>>>(storage);
-	return result;
+template<class T> void TypedArray<T>::Trace(Tracer& tracer) const {
+	//unboxed elements refer to nothing that can form a cycle
+}
+
+template<> void TypedArray<Value>::Trace(Tracer& tracer) const {
+	const_shared_ptr<TypeSpecifier> element_type = GetElementType();
+	m_elements.Trace(tracer, [&tracer, &element_type](const Value& element) {
+		tracer.Visit(element_type, element);
+	});
+}
+
+}
+
+const_shared_ptr<Array> Array::Create(
+		const_shared_ptr<TypeSpecifier> element_specifier) {
+	const_shared_ptr<ArrayTypeSpecifier> type_specifier =
+			ArrayTypeSpecifier::Get(element_specifier);
+
+	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
+			specifier_cast<PrimitiveTypeSpecifier>(
+					element_specifier);
+	if (as_primitive) {
+		switch (as_primitive->GetBasicType()) {
+		case BOOLEAN:
+			return make_shared<TypedArray<bool>>(type_specifier,
+					PersistentVector<bool>());
+		case INT:
+			return make_shared<TypedArray<int>>(type_specifier,
+					PersistentVector<int>());
+		case DOUBLE:
+			return make_shared<TypedArray<double>>(type_specifier,
+					PersistentVector<double>());
+		case STRING:
+			return make_shared<TypedArray<plain_shared_ptr<string>>>(
+					type_specifier,
+					PersistentVector<plain_shared_ptr<string>>());
+		default:
+			break;
+		}
+	}
+
+	return make_shared<TypedArray<Value>>(type_specifier,
+			PersistentVector<Value>());
 }
 
+Array::Array(const_shared_ptr<ArrayTypeSpecifier> type_specifier) :
+		m_type_specifier(type_specifier) {
+}
+
+Array::~Array() {
+}
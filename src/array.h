@@ -32,59 +32,43 @@
 #include <type_specifier.h>
 #include <symbol.h>
 
+class Tracer;
+
+/**
+ * An immutable array.
+ *
+ * Elements are stored according to the array's element type: arrays of
+ * booleans, integers, doubles and strings hold their elements unboxed in
+ * contiguous blocks (with booleans packed into bits), and all other arrays hold
+ * values.
+ */
 class Array {
 public:
-	Array(const_shared_ptr<TypeSpecifier> element_specifier,
-			const TypeTable& type_table) :
-			Array(element_specifier,
-					GetStorage(element_specifier, 0, type_table)) {
-	}
+	/**
+	 * Create an empty array with storage suited to the given element type.
+	 */
+	static const_shared_ptr<Array> Create(
+			const_shared_ptr<TypeSpecifier> element_specifier);
 
-	const string ToString(const TypeTable& type_table,
-			const Indent& indent) const;
-
-	template<class T> const std::shared_ptr<const T> GetValue(const int index,
-			const TypeTable& type_table) const {
-		if (0 <= index && index < GetSize()) {
-			const shared_ptr<const T> result = static_pointer_cast<const T>(
-					m_value->at(index));
-			return result;
-		} else {
-			return static_pointer_cast<const T>(
-					GetElementType()->DefaultValue(type_table));
-		}
-	}
+	virtual ~Array();
 
-	template<class T> const_shared_ptr<Array> WithValue(const int index,
-			shared_ptr<const T> value, const TypeTable& type_table) const {
-		auto new_vector = new vector<shared_ptr<const void>>(*m_value);
+	virtual const string ToString(const TypeTable& type_table,
+			const Indent& indent) const = 0;
 
-		if (index < GetSize()) {
-			new_vector->at(index) = value;
-		} else {
-			int old_size = new_vector->size();
-			new_vector->resize(index);
+	virtual const Value GetValue(const int index,
+			const TypeTable& type_table) const = 0;
 
-			//fill with default values
-			for (int i = old_size; i < new_vector->size(); i++) {
-				const_shared_ptr<void> default_value =
-						GetElementType()->DefaultValue(type_table);
-				new_vector->at(i) = default_value;
-			}
+	virtual const_shared_ptr<Array> WithValue(const int index,
+			const Value& value, const TypeTable& type_table) const = 0;
 
-			new_vector->insert(new_vector->end(), value);
-		}
+	virtual const int GetSize() const = 0;
 
-		const shared_ptr<const vector<shared_ptr<const void>>> wrapper = shared_ptr<const vector<shared_ptr<const void>>>(new_vector);
-		return const_shared_ptr<Array>(new Array(GetElementType(), wrapper));
-	}
+	/**
+	 * Visit the references held by the elements of the array.
+	 */
+	virtual void Trace(Tracer& tracer) const = 0;
 
-	const int GetSize() const {
-		int size = m_value->size();
-		return size;
-	}
-
-	const_shared_ptr<TypeSpecifier> GetTypeSpecifier() const {
+	const_shared_ptr<ArrayTypeSpecifier> GetTypeSpecifier() const {
 		return m_type_specifier;
 	}
 
@@ -92,21 +76,11 @@ public:
 		return m_type_specifier->GetElementTypeSpecifier();
 	}
 
+protected:
+	Array(const_shared_ptr<ArrayTypeSpecifier> type_specifier);
+
 private:
-	Array(const_shared_ptr<TypeSpecifier> element_specifier,
-			const shared_ptr<const vector<shared_ptr<const void>>> value) :
-			m_type_specifier(
-			const_shared_ptr<ArrayTypeSpecifier>(
-					new ArrayTypeSpecifier(element_specifier))), m_value(
-			value) {
-			}
-
-			static const shared_ptr<const vector<shared_ptr<const void>>> GetStorage(
-			const_shared_ptr<TypeSpecifier> element_specifier,
-			const int initial_size, const TypeTable& type_table);
-
-			const_shared_ptr<ArrayTypeSpecifier> m_type_specifier;
-			const shared_ptr<const vector<shared_ptr<const void>>> m_value;
-		};
+	const_shared_ptr<ArrayTypeSpecifier> m_type_specifier;
+};
 
 #endif /* ARRAY_H_ */
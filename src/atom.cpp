@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atom.h>
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+//names are stored in blocks that never move once allocated, so that a name can
+//be read without a lock while other threads intern new names
+const unsigned int BLOCK_BITS = 10;
+const unsigned int BLOCK_SIZE = 1 << BLOCK_BITS;
+const unsigned int MAX_BLOCKS = 1 << 16;
+
+struct AtomTable {
+	AtomTable() :
+			mutex(), ids(), size(0), blocks() {
+	}
+
+	std::mutex mutex;
+	std::unordered_map<std::string, unsigned int> ids;
+	unsigned int size;
+	plain_shared_ptr<std::string>* blocks[MAX_BLOCKS];
+};
+
+AtomTable& GetTable() {
+	static AtomTable table;
+	return table;
+}
+
+const plain_shared_ptr<std::string>& GetEntry(const unsigned int id) {
+	return GetTable().blocks[id >> BLOCK_BITS][id & (BLOCK_SIZE - 1)];
+}
+
+const unsigned int Intern(const std::string& name) {
+	//each thread remembers the names it has interned, so that scanning the
+	//same names over and over doesn't contend for the table
+	static thread_local std::unordered_map<std::string, unsigned int> cache;
+	auto cached = cache.find(name);
+	if (cached != cache.end()) {
+		return cached->second;
+	}
+
+	AtomTable& table = GetTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	auto result = table.ids.find(name);
+	if (result != table.ids.end()) {
+		cache.insert(*result);
+		return result->second;
+	}
+
+	const unsigned int id = table.size;
+	const unsigned int block = id >> BLOCK_BITS;
+	assert(block < MAX_BLOCKS);
+	if (!table.blocks[block]) {
+		table.blocks[block] = new plain_shared_ptr<std::string>[BLOCK_SIZE];
+	}
+	table.blocks[block][id & (BLOCK_SIZE - 1)] = std::make_shared<
+			const std::string>(name);
+	table.size++;
+
+	table.ids.insert(std::make_pair(name, id));
+	cache.insert(std::make_pair(name, id));
+	return id;
+}
+}
+
+Atom::Atom(const std::string& name) :
+		m_id(Intern(name)) {
+}
+
+Atom::Atom(const char* name) :
+		m_id(Intern(name)) {
+}
+
+const std::string& Atom::GetName() const {
+	return *GetEntry(m_id);
+}
+
+const plain_shared_ptr<std::string> Atom::GetNameReference() const {
+	return GetEntry(m_id);
+}
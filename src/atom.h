@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ATOM_H_
+#define ATOM_H_
+
+#include <string>
+#include <functional>
+#include <defaults.h>
+
+/**
+ * An interned name. Each distinct name is assigned a compact integer the first
+ * time it is interned, so atoms compare and hash as integers, and every
+ * occurrence of a name shares a single copy of its text.
+ *
+ * Interning costs a hash table lookup, so code that looks up the same name
+ * repeatedly should hold on to its atom rather than converting it each time.
+ *
+ * The table of names is shared by all threads. Each thread caches the names it
+ * has interned, so only the first occurrence of a name on a thread takes the
+ * table's lock; reading the text of an atom takes no lock at all.
+ */
+class Atom {
+public:
+	Atom(const std::string& name);
+	Atom(const char* name);
+
+	const unsigned int GetId() const {
+		return m_id;
+	}
+
+	const std::string& GetName() const;
+
+	/**
+	 * The shared text of the name.
+	 */
+	const plain_shared_ptr<std::string> GetNameReference() const;
+
+	const bool operator==(const Atom& other) const {
+		return m_id == other.m_id;
+	}
+
+	const bool operator!=(const Atom& other) const {
+		return m_id != other.m_id;
+	}
+
+	/**
+	 * Orders atoms by when they were first interned.
+	 */
+	const bool operator<(const Atom& other) const {
+		return m_id < other.m_id;
+	}
+
+	/**
+	 * Orders atoms by name, for output that mustn't depend on the order in
+	 * which names were first seen.
+	 */
+	static const bool NameLess(const Atom& left, const Atom& right) {
+		return left.GetName() < right.GetName();
+	}
+
+private:
+	unsigned int m_id;
+};
+
+namespace std {
+template<> struct hash<Atom> {
+	size_t operator()(const Atom& atom) const {
+		return atom.GetId();
+	}
+};
+}
+
+#endif /* ATOM_H_ */
@@ -0,0 +1,181 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <cycle_collector.h>
+#include <driver.h>
+#include <execution_context.h>
+#include <program_cache.h>
+#include <statement_block.h>
+#include <virtual_machine.h>
+
+namespace {
+//set once at startup, before any other thread is started
+Benchmark::AllocationHook allocation_hook = nullptr;
+}
+
+void Benchmark::SetAllocationHook(const AllocationHook hook) {
+	allocation_hook = hook;
+}
+
+const size_t Benchmark::GetAllocationCount() {
+	return allocation_hook ? allocation_hook() : 0;
+}
+
+Benchmark::Benchmark(const std::string& file_name, const int iterations,
+		const bool use_virtual_machine, const bool optimize,
+		const bool use_cache, const std::string& cache_directory) :
+		m_file_name(file_name), m_iterations(iterations), m_use_virtual_machine(
+				use_virtual_machine), m_optimize(optimize), m_use_cache(
+				use_cache), m_cache_directory(cache_directory) {
+}
+
+Benchmark::~Benchmark() {
+}
+
+int Benchmark::Run(std::ostream& out) {
+	for (int i = 0; i < m_iterations; i++) {
+		if (!RunIteration()) {
+			return EXIT_FAILURE;
+		}
+	}
+
+	out << "Benchmark of " << m_file_name << " (" << m_iterations
+			<< " iterations):" << std::endl;
+	out << std::left << std::setw(12) << "phase" << std::right
+			<< std::setw(12) << "min (ms)" << std::setw(14) << "median (ms)"
+			<< std::setw(12) << "p99 (ms)" << std::setw(14) << "allocations"
+			<< std::endl;
+	Report(out, "parse", m_samples[PARSE]);
+	Report(out, "preprocess", m_samples[PREPROCESS]);
+	Report(out, "execute", m_samples[EXECUTE]);
+
+	return EXIT_SUCCESS;
+}
+
+const bool Benchmark::RunIteration() {
+	typedef std::chrono::steady_clock clock;
+	auto milliseconds = [](const clock::duration& duration) {
+		return std::chrono::duration<double, std::milli>(duration).count();
+	};
+
+	auto start = clock::now();
+	size_t allocations = GetAllocationCount();
+	Driver driver;
+	//hashing the script to find its cache file is part of the cost of loading
+	unique_ptr<ProgramCache> cache(
+			m_use_cache ?
+					new ProgramCache(m_file_name, m_cache_directory) : nullptr);
+	const bool cached = cache && cache->Load(driver);
+	int parse_result = cached ? 0 : driver.parse(m_file_name, NO_TRACE);
+	auto end = clock::now();
+	m_samples[PARSE].push_back(
+			Sample { milliseconds(end - start), GetAllocationCount()
+					- allocations });
+
+	if (cache && !cached && parse_result == 0
+			&& driver.GetErrorCount() == 0) {
+		cache->Store(*driver.GetStatementBlock());
+	}
+
+	if (parse_result != 0 || driver.GetErrorCount() != 0) {
+		std::cerr << driver.GetErrorCount() << " parse error(s) found."
+				<< std::endl;
+		return false;
+	}
+
+	auto main_statement_block = driver.GetStatementBlock();
+
+	start = clock::now();
+	allocations = GetAllocationCount();
+	shared_ptr<ExecutionContext> root_context = make_shared<
+			ExecutionContext>();
+	ErrorListRef errors = main_statement_block->preprocess(root_context);
+	if (ErrorList::IsTerminator(errors) && m_optimize) {
+		main_statement_block->optimize(root_context);
+	}
+	end = clock::now();
+	m_samples[PREPROCESS].push_back(
+			Sample { milliseconds(end - start), GetAllocationCount()
+					- allocations });
+
+	if (!ErrorList::IsTerminator(errors)) {
+		for (auto error : *ErrorList::Reverse(errors)) {
+			std::cerr << *error << std::endl;
+		}
+		return false;
+	}
+
+	//discard the script's output
+	std::streambuf* output = std::cout.rdbuf(nullptr);
+
+	start = clock::now();
+	allocations = GetAllocationCount();
+	if (m_use_virtual_machine) {
+		VirtualMachine virtual_machine;
+		errors = virtual_machine.Execute(*main_statement_block, root_context);
+	} else {
+		errors = main_statement_block->execute(root_context);
+	}
+	end = clock::now();
+	m_samples[EXECUTE].push_back(
+			Sample { milliseconds(end - start), GetAllocationCount()
+					- allocations });
+
+	std::cout.rdbuf(output);
+	std::cout.clear();
+
+	//reclaim the iteration's cycles before the syntax tree they refer to is freed
+	root_context = nullptr;
+	CycleCollector::GetInstance().Collect();
+
+	if (!ErrorList::IsTerminator(errors)) {
+		for (auto error : *errors) {
+			std::cerr << error->ToString() << std::endl;
+		}
+		return false;
+	}
+
+	return true;
+}
+
+void Benchmark::Report(std::ostream& out, const std::string& name,
+		std::vector<Sample> samples) {
+	std::sort(samples.begin(), samples.end(),
+			[](const Sample& a, const Sample& b) {
+				return a.milliseconds < b.milliseconds;
+			});
+
+	const size_t count = samples.size();
+	//nearest-rank percentiles
+	const Sample& median = samples[(count - 1) / 2];
+	const Sample& p99 = samples[(count * 99 + 99) / 100 - 1];
+
+	out << std::left << std::setw(12) << name << std::right << std::fixed
+			<< std::setprecision(3) << std::setw(12)
+			<< samples[0].milliseconds << std::setw(14)
+			<< median.milliseconds << std::setw(12) << p99.milliseconds
+			<< std::setw(14) << median.allocations << std::endl;
+}
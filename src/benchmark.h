@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+/**
+ * Runs a script repeatedly, timing its parse, preprocess and execute phases
+ * separately and counting the allocations each phase makes.
+ *
+ * Each iteration parses the script afresh, so no phase benefits from state
+ * cached by a previous iteration, unless the on-disk program cache is used, in
+ * which case the parse phase measures loading the cached syntax tree. Output
+ * from the script is discarded.
+ */
+class Benchmark {
+public:
+	Benchmark(const std::string& file_name, const int iterations,
+			const bool use_virtual_machine, const bool optimize,
+			const bool use_cache, const std::string& cache_directory);
+	virtual ~Benchmark();
+
+	/**
+	 * Run the benchmark, writing the min, median and 99th percentile of each
+	 * phase to the given stream. Returns a process exit code.
+	 */
+	int Run(std::ostream& out);
+
+	/**
+	 * A function returning the number of allocations made so far by the calling
+	 * thread.
+	 */
+	typedef const size_t (*AllocationHook)();
+
+	/**
+	 * Install the function that counts allocations. The library installs none,
+	 * since it leaves operator new alone; the newt binary installs
+	 * AllocationCounter::GetCount. Must be called before any other thread is
+	 * started.
+	 */
+	static void SetAllocationHook(const AllocationHook hook);
+
+	/**
+	 * The number of allocations made so far by the calling thread, or 0 if no
+	 * allocation hook is installed.
+	 */
+	static const size_t GetAllocationCount();
+
+private:
+	enum Phase {
+		PARSE, PREPROCESS, EXECUTE, PHASE_COUNT
+	};
+
+	struct Sample {
+		double milliseconds;
+		size_t allocations;
+	};
+
+	const bool RunIteration();
+
+	static void Report(std::ostream& out, const std::string& name,
+			std::vector<Sample> samples);
+
+	const std::string m_file_name;
+	const int m_iterations;
+	const bool m_use_virtual_machine;
+	const bool m_optimize;
+	const bool m_use_cache;
+	const std::string m_cache_directory;
+	std::vector<Sample> m_samples[PHASE_COUNT];
+};
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bytecode.h>
+#include <assert.h>
+
+Program::Program() :
+		m_register_count(0), m_line(0) {
+}
+
+Program::~Program() {
+}
+
+const int Program::Emit(const OpCode opcode, const int a, const int b,
+		const int c) {
+	m_instructions.push_back(Instruction(opcode, a, b, c));
+	m_lines.push_back(m_line);
+	return m_instructions.size() - 1;
+}
+
+void Program::Patch(const int jump) {
+	assert(
+			m_instructions[jump].opcode == JUMP
+					|| m_instructions[jump].opcode == JUMP_IF_FALSE
+					|| m_instructions[jump].opcode == JUMP_IF_TRUE
+					|| m_instructions[jump].opcode == JUMP_IF_HALTED);
+	m_instructions[jump].b = m_instructions.size();
+}
+
+const int Program::AddDouble(const double value) {
+	m_doubles.push_back(value);
+	return m_doubles.size() - 1;
+}
+
+const int Program::AddReference(const_shared_ptr<void> value) {
+	m_references.push_back(value);
+	return m_references.size() - 1;
+}
+
+const int Program::AddVariable(const_shared_ptr<BasicVariable> variable) {
+	m_variables.push_back(variable);
+	return m_variables.size() - 1;
+}
+
+const int Program::AddLocation(const yy::location location) {
+	m_locations.push_back(location);
+	return m_locations.size() - 1;
+}
+
+const int Program::AddStatement(const_shared_ptr<Statement> statement) {
+	m_statements.push_back(statement);
+	return m_statements.size() - 1;
+}
+
+const int Program::AddExpression(const_shared_ptr<Expression> expression) {
+	m_expressions.push_back(expression);
+	return m_expressions.size() - 1;
+}
+
+const int Program::AddLoop(const_shared_ptr<ForStatement> loop) {
+	m_loops.push_back(loop);
+	return m_loops.size() - 1;
+}
+
+const int Program::AddCallSite(const CallSite& call_site) {
+	m_call_sites.push_back(call_site);
+	return m_call_sites.size() - 1;
+}
+
+void Program::ReserveRegister(const int index) {
+	if (index >= m_register_count) {
+		m_register_count = index + 1;
+	}
+}
@@ -0,0 +1,269 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTECODE_H_
+#define BYTECODE_H_
+
+#include <vector>
+#include <string>
+#include <defaults.h>
+#include <type.h>
+
+class Statement;
+class Expression;
+class BasicVariable;
+class ForStatement;
+
+/**
+ * The instruction set of the bytecode interpreter.
+ *
+ * Registers are untyped slots; the compiler tracks the type of each register
+ * statically and selects a typed opcode. Boolean values are held as integers
+ * (0 or 1). Strings and all non-primitive values are held as references.
+ *
+ * Unless noted otherwise, binary operations are two-address: r[a] = r[a] op r[b].
+ */
+#define OPCODES(X) \
+	X(HALT) \
+	X(MOVE)						/* r[a] = r[b] */ \
+	X(LOAD_INT)					/* r[a].int = a immediate (b) */ \
+	X(LOAD_DOUBLE)				/* r[a].double = doubles[b] */ \
+	X(LOAD_REFERENCE)			/* r[a].reference = references[b] */ \
+	X(LOAD_BOOLEAN_SYMBOL)		/* r[a] = value of variables[b] */ \
+	X(LOAD_INT_SYMBOL) \
+	X(LOAD_DOUBLE_SYMBOL) \
+	X(LOAD_REFERENCE_SYMBOL) \
+	X(STORE_BOOLEAN_SYMBOL)		/* variables[b] = r[a] */ \
+	X(STORE_INT_SYMBOL) \
+	X(STORE_DOUBLE_SYMBOL) \
+	X(STORE_STRING_SYMBOL) \
+	X(INT_TO_DOUBLE)			/* in-place conversions of r[a] */ \
+	X(BOOLEAN_TO_STRING) \
+	X(INT_TO_STRING) \
+	X(DOUBLE_TO_STRING) \
+	X(INT_TO_BOOLEAN) \
+	X(DOUBLE_TO_BOOLEAN) \
+	X(ADD_INT) \
+	X(SUBTRACT_INT) \
+	X(MULTIPLY_INT) \
+	X(DIVIDE_INT)				/* c: index of the divisor's location */ \
+	X(MODULUS_INT)				/* c: index of the divisor's location */ \
+	X(ADD_DOUBLE) \
+	X(SUBTRACT_DOUBLE) \
+	X(MULTIPLY_DOUBLE) \
+	X(DIVIDE_DOUBLE)			/* c: index of the divisor's location */ \
+	X(CONCATENATE) \
+	X(EQUAL_INT) \
+	X(NOT_EQUAL_INT) \
+	X(LESS_THAN_INT) \
+	X(LESS_THAN_EQUAL_INT) \
+	X(GREATER_THAN_INT) \
+	X(GREATER_THAN_EQUAL_INT) \
+	X(EQUAL_DOUBLE) \
+	X(NOT_EQUAL_DOUBLE) \
+	X(LESS_THAN_DOUBLE) \
+	X(LESS_THAN_EQUAL_DOUBLE) \
+	X(GREATER_THAN_DOUBLE) \
+	X(GREATER_THAN_EQUAL_DOUBLE) \
+	X(EQUAL_STRING) \
+	X(NOT_EQUAL_STRING) \
+	X(LESS_THAN_STRING) \
+	X(LESS_THAN_EQUAL_STRING) \
+	X(GREATER_THAN_STRING) \
+	X(GREATER_THAN_EQUAL_STRING) \
+	X(NEGATE_INT)				/* in-place unary operations on r[a] */ \
+	X(NEGATE_DOUBLE) \
+	X(LOGICAL_NOT) \
+	X(JUMP)						/* pc = b */ \
+	X(JUMP_IF_FALSE)			/* if !r[a].int, pc = b */ \
+	X(JUMP_IF_TRUE)				/* if r[a].int, pc = b */ \
+	X(JUMP_IF_HALTED)			/* if the context has returned or exited, pc = b */ \
+	X(ENTER_BLOCK)				/* push the block context of loops[b] */ \
+	X(LEAVE_BLOCK)				/* pop the current block context */ \
+	X(PRINT_BOOLEAN) \
+	X(PRINT_INT) \
+	X(PRINT_DOUBLE) \
+	X(PRINT_STRING) \
+	X(RETURN_BOOLEAN)			/* set the context's return value to r[a] */ \
+	X(RETURN_INT) \
+	X(RETURN_DOUBLE) \
+	X(RETURN_STRING) \
+	X(EXIT)						/* set the context's exit code to r[a] */ \
+	X(EXECUTE)					/* tree-walk statements[b] */ \
+	X(EVALUATE_BOOLEAN)			/* r[a] = tree-walk evaluation of expressions[b] */ \
+	X(EVALUATE_INT) \
+	X(EVALUATE_DOUBLE) \
+	X(EVALUATE_REFERENCE) \
+	X(INVOKE)					/* r[a] = r[a](r[a+1] ... r[a+n]), with call_sites[c] */ \
+	X(TAIL_INVOKE)				/* as INVOKE, made in place of the current frame */
+
+enum OpCode {
+#define OPCODE_ENUM(name) name,
+	OPCODES(OPCODE_ENUM)
+#undef OPCODE_ENUM
+	OPCODE_COUNT
+};
+
+struct Instruction {
+	Instruction(const OpCode opcode, const int a, const int b, const int c) :
+			opcode(opcode), a(a), b(b), c(c) {
+	}
+
+	OpCode opcode;
+	int a;
+	int b;
+	int c;
+};
+
+/**
+ * Register contents. Booleans and integers share the integer slot.
+ */
+struct Register {
+	Register() :
+			reference() {
+		double_value = 0;
+	}
+
+	union {
+		int int_value;
+		double double_value;
+	};
+	plain_shared_ptr<void> reference;
+};
+
+/**
+ * Static description of a function invocation: the basic types of the argument
+ * registers (already converted to the parameter types) and of the result.
+ * BasicType::NONE denotes a reference to a non-primitive value.
+ */
+struct CallSite {
+	CallSite(const std::vector<BasicType> argument_types,
+			const BasicType result_type, const_shared_ptr<string> name,
+			const int line) :
+			argument_types(argument_types), result_type(result_type), name(
+					name), line(line) {
+	}
+
+	const std::vector<BasicType> argument_types;
+	const BasicType result_type;
+
+	//the name of the function and the line of the call, for the profiler
+	const_shared_ptr<string> name;
+	const int line;
+};
+
+class Program {
+public:
+	Program();
+	virtual ~Program();
+
+	const int Emit(const OpCode opcode, const int a = 0, const int b = 0,
+			const int c = 0);
+
+	/**
+	 * Point the jump at the given instruction index to the next instruction to be emitted.
+	 */
+	void Patch(const int jump);
+
+	const int GetNextIndex() const {
+		return m_instructions.size();
+	}
+
+	/**
+	 * Set the source line that subsequently emitted instructions are attributed to.
+	 */
+	void SetLine(const int line) {
+		m_line = line;
+	}
+
+	const int GetLine() const {
+		return m_line;
+	}
+
+	const int GetLine(const int index) const {
+		return m_lines[index];
+	}
+
+	const int AddDouble(const double value);
+	const int AddReference(const_shared_ptr<void> value);
+	const int AddVariable(const_shared_ptr<BasicVariable> variable);
+	const int AddLocation(const yy::location location);
+	const int AddStatement(const_shared_ptr<Statement> statement);
+	const int AddExpression(const_shared_ptr<Expression> expression);
+	const int AddLoop(const_shared_ptr<ForStatement> loop);
+	const int AddCallSite(const CallSite& call_site);
+
+	void ReserveRegister(const int index);
+
+	const std::vector<Instruction>& GetInstructions() const {
+		return m_instructions;
+	}
+
+	const double GetDouble(const int index) const {
+		return m_doubles[index];
+	}
+
+	const plain_shared_ptr<void>& GetReference(const int index) const {
+		return m_references[index];
+	}
+
+	const plain_shared_ptr<BasicVariable>& GetVariable(const int index) const {
+		return m_variables[index];
+	}
+
+	const yy::location GetLocation(const int index) const {
+		return m_locations[index];
+	}
+
+	const plain_shared_ptr<Statement>& GetStatement(const int index) const {
+		return m_statements[index];
+	}
+
+	const plain_shared_ptr<Expression>& GetExpression(const int index) const {
+		return m_expressions[index];
+	}
+
+	const plain_shared_ptr<ForStatement>& GetLoop(const int index) const {
+		return m_loops[index];
+	}
+
+	const CallSite& GetCallSite(const int index) const {
+		return m_call_sites[index];
+	}
+
+	const int GetRegisterCount() const {
+		return m_register_count;
+	}
+
+private:
+	std::vector<Instruction> m_instructions;
+	std::vector<int> m_lines;
+	std::vector<double> m_doubles;
+	std::vector<plain_shared_ptr<void>> m_references;
+	std::vector<plain_shared_ptr<BasicVariable>> m_variables;
+	std::vector<yy::location> m_locations;
+	std::vector<plain_shared_ptr<Statement>> m_statements;
+	std::vector<plain_shared_ptr<Expression>> m_expressions;
+	std::vector<plain_shared_ptr<ForStatement>> m_loops;
+	std::vector<CallSite> m_call_sites;
+	int m_register_count;
+	int m_line;
+};
+
+#endif /* BYTECODE_H_ */
@@ -0,0 +1,819 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <compiler.h>
+#include <assert.h>
+#include <execution_context.h>
+#include <statement_block.h>
+#include <assignment_statement.h>
+#include <primitive_declaration_statement.h>
+#include <inferred_declaration_statement.h>
+#include <if_statement.h>
+#include <for_statement.h>
+#include <print_statement.h>
+#include <return_statement.h>
+#include <exit_statement.h>
+#include <invoke_statement.h>
+#include <expression.h>
+#include <constant_expression.h>
+#include <variable_expression.h>
+#include <binary_expression.h>
+#include <unary_expression.h>
+#include <invoke_expression.h>
+#include <basic_variable.h>
+#include <primitive_type_specifier.h>
+#include <function_type_specifier.h>
+#include <symbol.h>
+
+/**
+ * Returns true if a statement in the block (or a nested if-block) can end the
+ * execution of the block's context by returning or exiting.
+ */
+static const bool CanHalt(const StatementBlock& block) {
+	StatementListRef subject = block.GetStatementList();
+	while (!StatementList::IsTerminator(subject)) {
+		auto statement = subject->GetData();
+		if (dynamic_pointer_cast<const ReturnStatement>(statement)
+				|| dynamic_pointer_cast<const ExitStatement>(statement)) {
+			return true;
+		}
+
+		auto as_if = dynamic_pointer_cast<const IfStatement>(statement);
+		if (as_if
+				&& (CanHalt(*as_if->GetBlock())
+						|| (as_if->GetElseBlock()
+								&& CanHalt(*as_if->GetElseBlock())))) {
+			return true;
+		}
+
+		subject = subject->GetNext();
+	}
+	return false;
+}
+
+Compiler::Compiler() :
+		m_program(), m_next_register(0), m_return_type() {
+}
+
+Compiler::~Compiler() {
+}
+
+const_shared_ptr<Program> Compiler::Compile(const StatementBlock& block,
+		const shared_ptr<ExecutionContext> execution_context,
+		const_shared_ptr<TypeSpecifier> return_type) {
+	m_program = make_shared<Program>();
+	m_next_register = 0;
+	m_return_type = return_type;
+
+	std::vector<int> exits;
+	CompileBlock(block, execution_context, exits, false);
+	for (auto exit : exits) {
+		m_program->Patch(exit);
+	}
+	m_program->Emit(HALT);
+
+	const_shared_ptr<Program> result = m_program;
+	m_program = nullptr;
+	m_return_type = nullptr;
+	return result;
+}
+
+void Compiler::CompileBlock(const StatementBlock& block,
+		const shared_ptr<ExecutionContext> execution_context,
+		std::vector<int>& exits, const bool check_halt) {
+	StatementListRef subject = block.GetStatementList();
+	while (!StatementList::IsTerminator(subject)) {
+		auto statement = subject->GetData();
+		CompileStatement(statement, execution_context, exits, check_halt);
+
+		//the tree-walker checks the context after every statement; this is only
+		//observable in loop bodies, which keep executing after a return
+		if (check_halt && !dynamic_pointer_cast<const ReturnStatement>(statement)
+				&& !dynamic_pointer_cast<const ExitStatement>(statement)) {
+			exits.push_back(m_program->Emit(JUMP_IF_HALTED));
+		}
+
+		subject = subject->GetNext();
+	}
+}
+
+void Compiler::CompileStatement(const_shared_ptr<Statement> statement,
+		const shared_ptr<ExecutionContext> execution_context,
+		std::vector<int>& exits, const bool check_halt) {
+	const int first_register = m_next_register;
+	const int enclosing_line = m_program->GetLine();
+	m_program->SetLine(statement->GetPosition().begin.line);
+
+	auto as_assignment = dynamic_pointer_cast<const AssignmentStatement>(
+			statement);
+	auto as_primitive_declaration = dynamic_pointer_cast<
+			const PrimitiveDeclarationStatement>(statement);
+	auto as_inferred_declaration = dynamic_pointer_cast<
+			const InferredDeclarationStatement>(statement);
+	auto as_if = dynamic_pointer_cast<const IfStatement>(statement);
+	auto as_for = dynamic_pointer_cast<const ForStatement>(statement);
+	auto as_print = dynamic_pointer_cast<const PrintStatement>(statement);
+	auto as_return = dynamic_pointer_cast<const ReturnStatement>(statement);
+	auto as_exit = dynamic_pointer_cast<const ExitStatement>(statement);
+	auto as_invoke = dynamic_pointer_cast<const InvokeStatement>(statement);
+
+	if (as_assignment) {
+		if (!CompileAssignment(as_assignment->GetVariable(),
+				as_assignment->GetOpType(), as_assignment->GetExpression(),
+				execution_context)) {
+			m_program->Emit(EXECUTE, 0, m_program->AddStatement(statement));
+		}
+	} else if (as_primitive_declaration || as_inferred_declaration) {
+		auto declaration = static_pointer_cast<const DeclarationStatement>(
+				statement);
+		auto initializer = declaration->GetInitializerExpression();
+		if (initializer) {
+			const_shared_ptr<Variable> variable = make_shared<BasicVariable>(
+					declaration->GetName(), declaration->GetNamePosition());
+			if (!CompileAssignment(variable, ASSIGN, initializer,
+					execution_context)) {
+				m_program->Emit(EXECUTE, 0,
+						m_program->AddStatement(statement));
+			}
+		}
+	} else if (as_if) {
+		const int condition = AllocateRegister();
+		const BasicType condition_type = CompileExpression(
+				as_if->GetExpression(), execution_context, condition);
+		assert(condition_type == BOOLEAN || condition_type == INT);
+		const int skip_block = m_program->Emit(JUMP_IF_FALSE, condition);
+		m_next_register = first_register;
+
+		CompileBlock(*as_if->GetBlock(), execution_context, exits, check_halt);
+		if (as_if->GetElseBlock()) {
+			const int skip_else_block = m_program->Emit(JUMP);
+			m_program->Patch(skip_block);
+			CompileBlock(*as_if->GetElseBlock(), execution_context, exits,
+					check_halt);
+			m_program->Patch(skip_else_block);
+		} else {
+			m_program->Patch(skip_block);
+		}
+	} else if (as_for) {
+		m_program->Emit(ENTER_BLOCK, 0, m_program->AddLoop(as_for));
+		auto block_context = as_for->GetBlockContext(execution_context);
+
+		//loops have their own context, so returns within them only end the current iteration
+		std::vector<int> body_exits;
+		if (as_for->GetInitial()) {
+			CompileStatement(as_for->GetInitial(), block_context, body_exits,
+					false);
+		}
+
+		const int start = m_program->GetNextIndex();
+		const int condition = AllocateRegister();
+		const BasicType condition_type = CompileExpression(
+				as_for->GetLoopExpression(), block_context, condition);
+		assert(condition_type == BOOLEAN || condition_type == INT);
+		const int end_loop = m_program->Emit(JUMP_IF_FALSE, condition);
+		m_next_register = first_register;
+
+		auto body = as_for->GetStatementBlock();
+		if (body) {
+			CompileBlock(*body, block_context, body_exits, CanHalt(*body));
+		}
+		for (auto exit : body_exits) {
+			m_program->Patch(exit);
+		}
+
+		CompileStatement(as_for->GetLoopAssignment(), block_context, exits,
+				false);
+		m_program->Emit(JUMP, 0, start);
+		m_program->Patch(end_loop);
+		m_program->Emit(LEAVE_BLOCK);
+	} else if (as_print) {
+		auto expression = as_print->GetExpression();
+		const BasicType type = GetBasicType(
+				expression->GetType(execution_context));
+
+		//invocations have their own string representation
+		if (type == NONE || dynamic_pointer_cast<const InvokeExpression>(expression)) {
+			m_program->Emit(EXECUTE, 0, m_program->AddStatement(statement));
+		} else {
+			const int value = AllocateRegister();
+			CompileExpression(expression, execution_context, value);
+			switch (type) {
+			case BOOLEAN:
+				m_program->Emit(PRINT_BOOLEAN, value);
+				break;
+			case INT:
+				m_program->Emit(PRINT_INT, value);
+				break;
+			case DOUBLE:
+				m_program->Emit(PRINT_DOUBLE, value);
+				break;
+			default:
+				m_program->Emit(PRINT_STRING, value);
+				break;
+			}
+		}
+	} else if (as_return) {
+		auto expression = as_return->GetExpression();
+		const BasicType type = GetBasicType(
+				expression->GetType(execution_context));
+		//loops have their own context, so only calls outside of them can end the frame
+		auto tail_call = as_return->GetTailCall();
+		if (tail_call && !check_halt
+				&& CompileTailCall(*tail_call, execution_context)) {
+			//the result of the call is the result of the function
+		} else if (type == NONE) {
+			m_program->Emit(EXECUTE, 0, m_program->AddStatement(statement));
+		} else {
+			const int value = AllocateRegister();
+			CompileExpression(expression, execution_context, value);
+			switch (type) {
+			case BOOLEAN:
+				m_program->Emit(RETURN_BOOLEAN, value);
+				break;
+			case INT:
+				m_program->Emit(RETURN_INT, value);
+				break;
+			case DOUBLE:
+				m_program->Emit(RETURN_DOUBLE, value);
+				break;
+			default:
+				m_program->Emit(RETURN_STRING, value);
+				break;
+			}
+		}
+		exits.push_back(m_program->Emit(JUMP));
+	} else if (as_exit) {
+		const int value = AllocateRegister();
+		auto expression = as_exit->GetExitExpression();
+		if (expression) {
+			CompileExpression(expression, execution_context, value);
+		} else {
+			m_program->Emit(LOAD_INT, value, 0);
+		}
+		m_program->Emit(EXIT, value);
+		exits.push_back(m_program->Emit(JUMP));
+	} else if (as_invoke) {
+		auto variable = as_invoke->GetVariable();
+		const_shared_ptr<Expression> variable_expression = make_shared<
+				VariableExpression>(variable->GetLocation(), variable);
+		const_shared_ptr<Expression> invoke_expression = make_shared<
+				InvokeExpression>(variable->GetLocation(), variable_expression,
+				as_invoke->GetArgumentList(),
+				as_invoke->GetArgumentListPosition());
+		CompileInvocation(invoke_expression, variable_expression,
+				as_invoke->GetArgumentList(), execution_context,
+				AllocateRegister(), true);
+	} else {
+		m_program->Emit(EXECUTE, 0, m_program->AddStatement(statement));
+	}
+
+	m_next_register = first_register;
+	m_program->SetLine(enclosing_line);
+}
+
+const bool Compiler::CompileAssignment(const_shared_ptr<Variable> variable,
+		const AssignmentType op, const_shared_ptr<Expression> expression,
+		const shared_ptr<ExecutionContext> execution_context) {
+	auto as_basic_variable = dynamic_pointer_cast<const BasicVariable>(
+			variable);
+	if (!as_basic_variable) {
+		return false;
+	}
+
+	auto symbol = execution_context->GetSymbol(variable->GetNameAtom(), DEEP);
+	if (symbol == Symbol::GetDefaultSymbol()) {
+		return false;
+	}
+
+	const BasicType variable_type = GetBasicType(symbol->GetType());
+	const BasicType expression_type = GetBasicType(
+			expression->GetType(execution_context));
+	if (variable_type == NONE || expression_type == NONE
+			|| expression_type > variable_type) {
+		return false;
+	}
+
+	OpCode operation;
+	switch (op) {
+	case ASSIGN:
+		operation = HALT;
+		break;
+	case PLUS_ASSIGN:
+		switch (variable_type) {
+		case INT:
+			operation = ADD_INT;
+			break;
+		case DOUBLE:
+			operation = ADD_DOUBLE;
+			break;
+		case STRING:
+			operation = CONCATENATE;
+			break;
+		default:
+			return false;
+		}
+		break;
+	case MINUS_ASSIGN:
+		switch (variable_type) {
+		case INT:
+			operation = SUBTRACT_INT;
+			break;
+		case DOUBLE:
+			operation = SUBTRACT_DOUBLE;
+			break;
+		default:
+			return false;
+		}
+		break;
+	default:
+		return false;
+	}
+
+	const int index = m_program->AddVariable(as_basic_variable);
+	const int value = AllocateRegister();
+	if (op == ASSIGN) {
+		CompileExpression(expression, execution_context, value);
+		EmitConversion(value, expression_type, variable_type);
+	} else {
+		switch (variable_type) {
+		case INT:
+			m_program->Emit(LOAD_INT_SYMBOL, value, index);
+			break;
+		case DOUBLE:
+			m_program->Emit(LOAD_DOUBLE_SYMBOL, value, index);
+			break;
+		default:
+			m_program->Emit(LOAD_REFERENCE_SYMBOL, value, index);
+			break;
+		}
+
+		const int operand = AllocateRegister();
+		CompileExpression(expression, execution_context, operand);
+		EmitConversion(operand, expression_type, variable_type);
+		m_program->Emit(operation, value, operand);
+	}
+
+	switch (variable_type) {
+	case BOOLEAN:
+		m_program->Emit(STORE_BOOLEAN_SYMBOL, value, index);
+		break;
+	case INT:
+		m_program->Emit(STORE_INT_SYMBOL, value, index);
+		break;
+	case DOUBLE:
+		m_program->Emit(STORE_DOUBLE_SYMBOL, value, index);
+		break;
+	default:
+		m_program->Emit(STORE_STRING_SYMBOL, value, index);
+		break;
+	}
+
+	return true;
+}
+
+const BasicType Compiler::CompileExpression(
+		const_shared_ptr<Expression> expression,
+		const shared_ptr<ExecutionContext> execution_context,
+		const int target) {
+	m_program->ReserveRegister(target);
+
+	if (dynamic_pointer_cast<const ConstantExpression>(expression)) {
+		const BasicType type = GetBasicType(
+				expression->GetType(execution_context));
+		auto evaluation = expression->Evaluate(execution_context);
+		auto value = evaluation->GetData();
+		switch (type) {
+		case BOOLEAN:
+			m_program->Emit(LOAD_INT, target, value.GetBoolean());
+			break;
+		case INT:
+			m_program->Emit(LOAD_INT, target, value.GetInt());
+			break;
+		case DOUBLE:
+			m_program->Emit(LOAD_DOUBLE, target,
+					m_program->AddDouble(value.GetDouble()));
+			break;
+		default:
+			m_program->Emit(LOAD_REFERENCE, target,
+					m_program->AddReference(value.GetReference()));
+			break;
+		}
+		return type;
+	}
+
+	auto as_variable_expression = dynamic_pointer_cast<
+			const VariableExpression>(expression);
+	if (as_variable_expression) {
+		auto as_basic_variable = dynamic_pointer_cast<const BasicVariable>(
+				as_variable_expression->GetVariable());
+		if (as_basic_variable) {
+			const BasicType type = GetBasicType(
+					expression->GetType(execution_context));
+			const int index = m_program->AddVariable(as_basic_variable);
+			switch (type) {
+			case BOOLEAN:
+				m_program->Emit(LOAD_BOOLEAN_SYMBOL, target, index);
+				break;
+			case INT:
+				m_program->Emit(LOAD_INT_SYMBOL, target, index);
+				break;
+			case DOUBLE:
+				m_program->Emit(LOAD_DOUBLE_SYMBOL, target, index);
+				break;
+			default:
+				m_program->Emit(LOAD_REFERENCE_SYMBOL, target, index);
+				break;
+			}
+			return type;
+		}
+		return CompileFallback(expression, execution_context, target);
+	}
+
+	auto as_binary = dynamic_pointer_cast<const BinaryExpression>(expression);
+	if (as_binary) {
+		return CompileBinaryExpression(as_binary, execution_context, target);
+	}
+
+	auto as_unary = dynamic_pointer_cast<const UnaryExpression>(expression);
+	if (as_unary) {
+		return CompileUnaryExpression(as_unary, execution_context, target);
+	}
+
+	auto as_invoke = dynamic_pointer_cast<const InvokeExpression>(expression);
+	if (as_invoke) {
+		return CompileInvocation(expression, as_invoke->GetExpression(),
+				as_invoke->GetArgumentListRef(), execution_context, target,
+				false);
+	}
+
+	return CompileFallback(expression, execution_context, target);
+}
+
+const BasicType Compiler::CompileBinaryExpression(
+		const_shared_ptr<BinaryExpression> expression,
+		const shared_ptr<ExecutionContext> execution_context,
+		const int target) {
+	auto left = expression->GetLeft();
+	auto right = expression->GetRight();
+	const BasicType left_type = GetBasicType(
+			left->GetType(execution_context));
+	const BasicType right_type = GetBasicType(
+			right->GetType(execution_context));
+	if (left_type == NONE || right_type == NONE) {
+		return CompileFallback(expression, execution_context, target);
+	}
+
+	//operands are widened to the wider of the two types
+	const BasicType common_type = left_type > right_type ? left_type : right_type;
+	BasicType operand_type = common_type;
+	BasicType result_type = BOOLEAN;
+	OpCode operation;
+	int location = 0;
+
+	const OperatorType op = expression->GetOperator();
+	switch (op) {
+	case PLUS:
+	case MINUS:
+	case MULTIPLY:
+	case DIVIDE:
+	case MOD: {
+		result_type = common_type;
+		if (common_type == BOOLEAN) {
+			return CompileFallback(expression, execution_context, target);
+		}
+
+		if (op == DIVIDE || op == MOD) {
+			location = m_program->AddLocation(right->GetPosition());
+		}
+
+		if (common_type == STRING) {
+			if (op != PLUS) {
+				return CompileFallback(expression, execution_context, target);
+			}
+			operation = CONCATENATE;
+		} else if (common_type == INT) {
+			static const OpCode operations[] = { ADD_INT, SUBTRACT_INT,
+					MULTIPLY_INT, DIVIDE_INT, MODULUS_INT };
+			operation = operations[op - PLUS];
+		} else {
+			if (op == MOD) {
+				return CompileFallback(expression, execution_context, target);
+			}
+			static const OpCode operations[] = { ADD_DOUBLE, SUBTRACT_DOUBLE,
+					MULTIPLY_DOUBLE, DIVIDE_DOUBLE };
+			operation = operations[op - PLUS];
+		}
+		break;
+	}
+	case EQUAL:
+	case NOT_EQUAL:
+	case LESS_THAN:
+	case LESS_THAN_EQUAL:
+	case GREATER_THAN:
+	case GREATER_THAN_EQUAL: {
+		if (common_type == BOOLEAN) {
+			if (op != EQUAL && op != NOT_EQUAL) {
+				return CompileFallback(expression, execution_context, target);
+			}
+			//booleans are held as integers
+			operand_type = BOOLEAN;
+		}
+
+		static const OpCode int_operations[] = { EQUAL_INT, NOT_EQUAL_INT,
+				LESS_THAN_INT, LESS_THAN_EQUAL_INT, GREATER_THAN_INT,
+				GREATER_THAN_EQUAL_INT };
+		static const OpCode double_operations[] = { EQUAL_DOUBLE,
+				NOT_EQUAL_DOUBLE, LESS_THAN_DOUBLE, LESS_THAN_EQUAL_DOUBLE,
+				GREATER_THAN_DOUBLE, GREATER_THAN_EQUAL_DOUBLE };
+		static const OpCode string_operations[] = { EQUAL_STRING,
+				NOT_EQUAL_STRING, LESS_THAN_STRING, LESS_THAN_EQUAL_STRING,
+				GREATER_THAN_STRING, GREATER_THAN_EQUAL_STRING };
+		switch (common_type) {
+		case BOOLEAN:
+		case INT:
+			operation = int_operations[op - EQUAL];
+			break;
+		case DOUBLE:
+			operation = double_operations[op - EQUAL];
+			break;
+		default:
+			operation = string_operations[op - EQUAL];
+			break;
+		}
+		break;
+	}
+	case AND:
+	case OR: {
+		if (common_type == STRING) {
+			return CompileFallback(expression, execution_context, target);
+		}
+
+		//skip the right operand if the left decides the result
+		CompileExpression(left, execution_context, target);
+		EmitConversion(target, left_type, BOOLEAN);
+		const int skip_right = m_program->Emit(
+				op == AND ? JUMP_IF_FALSE : JUMP_IF_TRUE, target);
+		CompileExpression(right, execution_context, target);
+		EmitConversion(target, right_type, BOOLEAN);
+		m_program->Patch(skip_right);
+		return BOOLEAN;
+	}
+	default:
+		return CompileFallback(expression, execution_context, target);
+	}
+
+	const int first_register = m_next_register;
+	const int operand = AllocateRegister();
+	CompileExpression(left, execution_context, target);
+	EmitConversion(target, left_type, operand_type);
+	CompileExpression(right, execution_context, operand);
+	EmitConversion(operand, right_type, operand_type);
+	m_program->Emit(operation, target, operand, location);
+	m_next_register = first_register;
+
+	return result_type;
+}
+
+const BasicType Compiler::CompileUnaryExpression(
+		const_shared_ptr<UnaryExpression> expression,
+		const shared_ptr<ExecutionContext> execution_context,
+		const int target) {
+	auto operand = expression->GetExpression();
+	const BasicType operand_type = GetBasicType(
+			operand->GetType(execution_context));
+
+	switch (expression->GetOperator()) {
+	case UNARY_MINUS:
+		if (operand_type == INT) {
+			CompileExpression(operand, execution_context, target);
+			m_program->Emit(NEGATE_INT, target);
+			return INT;
+		} else if (operand_type == DOUBLE) {
+			CompileExpression(operand, execution_context, target);
+			m_program->Emit(NEGATE_DOUBLE, target);
+			return DOUBLE;
+		}
+		break;
+	case NOT:
+		if (operand_type == BOOLEAN || operand_type == INT
+				|| operand_type == DOUBLE) {
+			CompileExpression(operand, execution_context, target);
+			EmitConversion(target, operand_type, BOOLEAN);
+			m_program->Emit(LOGICAL_NOT, target);
+			return BOOLEAN;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return CompileFallback(expression, execution_context, target);
+}
+
+const BasicType Compiler::CompileInvocation(
+		const_shared_ptr<Expression> expression,
+		const_shared_ptr<Expression> function_expression,
+		ArgumentListRef argument_list,
+		const shared_ptr<ExecutionContext> execution_context, const int target,
+		const bool discard_result) {
+	auto as_function = specifier_cast<FunctionTypeSpecifier>(
+			function_expression->GetType(execution_context));
+	std::vector<BasicType> argument_types;
+	std::vector<BasicType> parameter_types;
+	if (!as_function
+			|| !GetArgumentTypes(*as_function, argument_list,
+					execution_context, argument_types, parameter_types)) {
+		return CompileFallback(expression, execution_context, target,
+				discard_result);
+	}
+
+	const BasicType result_type =
+			discard_result ? NONE : GetBasicType(as_function->GetReturnType());
+	const int base = CompileCall(INVOKE, function_expression, argument_list,
+			execution_context, argument_types, parameter_types, result_type);
+	if (base != target) {
+		m_program->Emit(MOVE, target, base);
+	}
+
+	return result_type;
+}
+
+const bool Compiler::CompileTailCall(const InvokeExpression& invocation,
+		const shared_ptr<ExecutionContext> execution_context) {
+	auto function_expression = invocation.GetExpression();
+	auto as_function = specifier_cast<FunctionTypeSpecifier>(
+			function_expression->GetType(execution_context));
+	std::vector<BasicType> argument_types;
+	std::vector<BasicType> parameter_types;
+	if (!m_return_type || !as_function
+			|| *as_function->GetReturnType() != *m_return_type
+			|| !GetArgumentTypes(*as_function,
+					invocation.GetArgumentListRef(), execution_context,
+					argument_types, parameter_types)) {
+		return false;
+	}
+
+	CompileCall(TAIL_INVOKE, function_expression,
+			invocation.GetArgumentListRef(), execution_context,
+			argument_types, parameter_types,
+			GetBasicType(as_function->GetReturnType()));
+	return true;
+}
+
+const bool Compiler::GetArgumentTypes(const FunctionTypeSpecifier& function,
+		ArgumentListRef argument_list,
+		const shared_ptr<ExecutionContext> execution_context,
+		std::vector<BasicType>& argument_types,
+		std::vector<BasicType>& parameter_types) {
+	//arguments are passed in registers only if every one of them is primitive
+	ArgumentListRef argument = argument_list;
+	TypeSpecifierListRef parameter = function.GetParameterTypeList();
+	while (!ArgumentList::IsTerminator(argument)) {
+		if (TypeSpecifierList::IsTerminator(parameter)) {
+			return false;
+		}
+
+		const BasicType argument_type = GetBasicType(
+				argument->GetData()->GetType(execution_context));
+		const BasicType parameter_type = GetBasicType(parameter->GetData());
+		if (argument_type == NONE || parameter_type == NONE
+				|| argument_type > parameter_type) {
+			return false;
+		}
+
+		argument_types.push_back(argument_type);
+		parameter_types.push_back(parameter_type);
+		argument = argument->GetNext();
+		parameter = parameter->GetNext();
+	}
+
+	return true;
+}
+
+const int Compiler::CompileCall(const OpCode opcode,
+		const_shared_ptr<Expression> function_expression,
+		ArgumentListRef argument_list,
+		const shared_ptr<ExecutionContext> execution_context,
+		const std::vector<BasicType>& argument_types,
+		const std::vector<BasicType>& parameter_types,
+		const BasicType result_type) {
+	const int first_register = m_next_register;
+	const int base = AllocateRegister();
+	CompileExpression(function_expression, execution_context, base);
+
+	ArgumentListRef argument = argument_list;
+	for (size_t i = 0; i < argument_types.size(); i++) {
+		const int argument_register = AllocateRegister();
+		CompileExpression(argument->GetData(), execution_context,
+				argument_register);
+		EmitConversion(argument_register, argument_types[i],
+				parameter_types[i]);
+		argument = argument->GetNext();
+	}
+
+	m_program->Emit(opcode, base, argument_types.size(),
+			m_program->AddCallSite(
+					CallSite(parameter_types, result_type,
+							InvokeExpression::GetFunctionName(
+									function_expression),
+							function_expression->GetPosition().begin.line)));
+
+	m_next_register = first_register;
+	return base;
+}
+
+const BasicType Compiler::CompileFallback(
+		const_shared_ptr<Expression> expression,
+		const shared_ptr<ExecutionContext> execution_context, const int target,
+		const bool discard_result) {
+	//a discarded value may be missing entirely (e.g. a function without a return statement)
+	const BasicType type =
+			discard_result ?
+					NONE : GetBasicType(expression->GetType(execution_context));
+	const int index = m_program->AddExpression(expression);
+	switch (type) {
+	case BOOLEAN:
+		m_program->Emit(EVALUATE_BOOLEAN, target, index);
+		break;
+	case INT:
+		m_program->Emit(EVALUATE_INT, target, index);
+		break;
+	case DOUBLE:
+		m_program->Emit(EVALUATE_DOUBLE, target, index);
+		break;
+	default:
+		m_program->Emit(EVALUATE_REFERENCE, target, index);
+		break;
+	}
+	return type;
+}
+
+void Compiler::EmitConversion(const int target, const BasicType from,
+		const BasicType to) {
+	if (from == to) {
+		return;
+	}
+
+	switch (to) {
+	case BOOLEAN:
+		m_program->Emit(from == INT ? INT_TO_BOOLEAN : DOUBLE_TO_BOOLEAN,
+				target);
+		break;
+	case INT:
+		//booleans are already held as integers
+		assert(from == BOOLEAN);
+		break;
+	case DOUBLE:
+		assert(from == BOOLEAN || from == INT);
+		m_program->Emit(INT_TO_DOUBLE, target);
+		break;
+	case STRING:
+		switch (from) {
+		case BOOLEAN:
+			m_program->Emit(BOOLEAN_TO_STRING, target);
+			break;
+		case INT:
+			m_program->Emit(INT_TO_STRING, target);
+			break;
+		case DOUBLE:
+			m_program->Emit(DOUBLE_TO_STRING, target);
+			break;
+		default:
+			assert(false);
+		}
+		break;
+	default:
+		assert(false);
+	}
+}
+
+const int Compiler::AllocateRegister() {
+	const int result = m_next_register++;
+	m_program->ReserveRegister(result);
+	return result;
+}
+
+const BasicType Compiler::GetBasicType(const_shared_ptr<TypeSpecifier> type) {
+	auto as_primitive = specifier_cast<PrimitiveTypeSpecifier>(
+			type);
+	if (as_primitive) {
+		return as_primitive->GetBasicType();
+	}
+	return NONE;
+}
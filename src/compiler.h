@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMPILER_H_
+#define COMPILER_H_
+
+#include <vector>
+#include <bytecode.h>
+#include <statement.h>
+#include <expression.h>
+#include <assignment_type.h>
+
+class StatementBlock;
+class BinaryExpression;
+class UnaryExpression;
+class InvokeExpression;
+class TypeSpecifier;
+class FunctionTypeSpecifier;
+class Variable;
+
+/**
+ * Lowers a preprocessed statement block to bytecode.
+ *
+ * Types are resolved against the execution context the block was preprocessed in,
+ * so each opcode can be specialized for its operand types. Constructs without a
+ * dedicated lowering are emitted as EXECUTE/EVALUATE instructions that defer to
+ * the tree-walking implementation, which guarantees identical semantics.
+ */
+class Compiler {
+public:
+	Compiler();
+	virtual ~Compiler();
+
+	/**
+	 * Compile a block. If the block is the body of a function, return_type is the
+	 * function's return type; it is null otherwise.
+	 */
+	const_shared_ptr<Program> Compile(const StatementBlock& block,
+			const shared_ptr<ExecutionContext> execution_context,
+			const_shared_ptr<TypeSpecifier> return_type = nullptr);
+
+private:
+	/**
+	 * Compile a statement block. Jumps emitted by statements that end execution of the
+	 * block's context (return, exit) are appended to the exits list for patching.
+	 * If check_halt is set, a jump to the exits is also taken after any statement that
+	 * leaves the context halted, mirroring the tree-walker's checks.
+	 */
+	void CompileBlock(const StatementBlock& block,
+			const shared_ptr<ExecutionContext> execution_context,
+			std::vector<int>& exits, const bool check_halt);
+	void CompileStatement(const_shared_ptr<Statement> statement,
+			const shared_ptr<ExecutionContext> execution_context,
+			std::vector<int>& exits, const bool check_halt);
+	const bool CompileAssignment(const_shared_ptr<Variable> variable,
+			const AssignmentType op, const_shared_ptr<Expression> expression,
+			const shared_ptr<ExecutionContext> execution_context);
+
+	/**
+	 * Compile an expression, leaving its value in the target register.
+	 * Returns the basic type of the value, or BasicType::NONE for non-primitive values.
+	 */
+	const BasicType CompileExpression(const_shared_ptr<Expression> expression,
+			const shared_ptr<ExecutionContext> execution_context,
+			const int target);
+	const BasicType CompileBinaryExpression(
+			const_shared_ptr<BinaryExpression> expression,
+			const shared_ptr<ExecutionContext> execution_context,
+			const int target);
+	const BasicType CompileUnaryExpression(
+			const_shared_ptr<UnaryExpression> expression,
+			const shared_ptr<ExecutionContext> execution_context,
+			const int target);
+	const BasicType CompileInvocation(const_shared_ptr<Expression> expression,
+			const_shared_ptr<Expression> function_expression,
+			ArgumentListRef argument_list,
+			const shared_ptr<ExecutionContext> execution_context,
+			const int target, const bool discard_result);
+
+	/**
+	 * Compile a call in return position as a TAIL_INVOKE, which leaves the call to
+	 * the invoker of the current frame. Returns false without emitting anything if
+	 * the call's result needs converting or its arguments cannot be passed in
+	 * registers.
+	 */
+	const bool CompileTailCall(const InvokeExpression& invocation,
+			const shared_ptr<ExecutionContext> execution_context);
+
+	/**
+	 * Determine the basic types of the arguments of a call and the parameters they
+	 * are passed to. Returns false unless every one of them is primitive.
+	 */
+	const bool GetArgumentTypes(const FunctionTypeSpecifier& function,
+			ArgumentListRef argument_list,
+			const shared_ptr<ExecutionContext> execution_context,
+			std::vector<BasicType>& argument_types,
+			std::vector<BasicType>& parameter_types);
+
+	/**
+	 * Emit an invocation opcode with the function and its arguments in consecutive
+	 * registers, returning the register of the function.
+	 */
+	const int CompileCall(const OpCode opcode,
+			const_shared_ptr<Expression> function_expression,
+			ArgumentListRef argument_list,
+			const shared_ptr<ExecutionContext> execution_context,
+			const std::vector<BasicType>& argument_types,
+			const std::vector<BasicType>& parameter_types,
+			const BasicType result_type);
+
+	const BasicType CompileFallback(const_shared_ptr<Expression> expression,
+			const shared_ptr<ExecutionContext> execution_context,
+			const int target, const bool discard_result = false);
+
+	void EmitConversion(const int target, const BasicType from,
+			const BasicType to);
+
+	const int AllocateRegister();
+
+	static const BasicType GetBasicType(const_shared_ptr<TypeSpecifier> type);
+
+	shared_ptr<Program> m_program;
+	int m_next_register;
+	plain_shared_ptr<TypeSpecifier> m_return_type;
+};
+
+#endif /* COMPILER_H_ */
@@ -18,18 +18,22 @@
  */
 
 #include <compound_type.h>
+#include <compound_type_instance.h>
 #include <member_definition.h>
 #include <sstream>
+#include <algorithm>
+#include <vector>
 #include <assert.h>
 #include <type_specifier.h>
 
 CompoundType::CompoundType(const_shared_ptr<definition_map> definition,
 		const Modifier::Type modifiers) :
-		m_definition(definition), m_modifiers(modifiers) {
+		m_definition(definition), m_modifiers(modifiers), m_layout(
+				GetLayout(definition)) {
 }
 
 const_shared_ptr<MemberDefinition> CompoundType::GetMember(
-		const string& name) const {
+		const Atom& name) const {
 	auto result = m_definition->find(name);
 	if (result != m_definition->end()) {
 		return result->second;
@@ -41,15 +45,34 @@ const_shared_ptr<MemberDefinition> CompoundType::GetMember(
 CompoundType::~CompoundType() {
 }
 
+const_shared_ptr<SymbolMap> CompoundType::GetLayout(
+		const_shared_ptr<definition_map> definition) {
+	auto layout = make_shared<SymbolMap>();
+	for (auto iter = definition->begin(); iter != definition->end(); ++iter) {
+		const_shared_ptr<MemberDefinition> member_definition = iter->second;
+		layout->Insert(iter->first,
+				CompoundTypeInstance::GetSymbol(member_definition->GetType(),
+						member_definition->GetDefaultValue()));
+	}
+	return layout;
+}
+
 const string CompoundType::ToString(const TypeTable& type_table,
 		const Indent& indent) const {
 	ostringstream os;
 	Indent child_indent = indent + 1;
-	definition_map::const_iterator type_iter;
-	for (type_iter = m_definition->begin(); type_iter != m_definition->end();
-			++type_iter) {
-		const string member_name = type_iter->first;
-		const_shared_ptr<MemberDefinition> member_definition = type_iter->second;
+	std::vector<Atom> member_names;
+	for (auto iter = m_definition->begin(); iter != m_definition->end();
+			++iter) {
+		member_names.push_back(iter->first);
+	}
+	std::sort(member_names.begin(), member_names.end(), Atom::NameLess);
+
+	for (auto iter = member_names.begin(); iter != member_names.end();
+			++iter) {
+		const string& member_name = iter->GetName();
+		const_shared_ptr<MemberDefinition> member_definition =
+				m_definition->at(*iter);
 		const_shared_ptr<TypeSpecifier> member_type =
 				member_definition->GetType();
 
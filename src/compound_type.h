@@ -20,7 +20,7 @@
 #ifndef COMPOUND_TYPE_H_
 #define COMPOUND_TYPE_H_
 
-#include <map>
+#include <unordered_map>
 #include <string>
 #include <linked_list.h>
 #include <symbol_context.h>
@@ -28,7 +28,7 @@
 
 class MemberDefinition;
 
-typedef map<const string, const_shared_ptr<MemberDefinition>> definition_map;
+typedef unordered_map<Atom, const_shared_ptr<MemberDefinition>> definition_map;
 
 using namespace std;
 class CompoundType {
@@ -36,7 +36,7 @@ public:
 	CompoundType(const_shared_ptr<definition_map> definition,
 			const Modifier::Type modifiers);
 	virtual ~CompoundType();
-	const_shared_ptr<MemberDefinition> GetMember(const string& name) const;
+	const_shared_ptr<MemberDefinition> GetMember(const Atom& name) const;
 
 	const string ToString(const TypeTable& type_table,
 			const Indent& indent) const;
@@ -45,6 +45,15 @@ public:
 		return m_definition;
 	}
 
+	/**
+	 * The layout of the type's instances: each member, set to its default value,
+	 * in a fixed slot. The layout is computed once, when the type is declared;
+	 * instances are copies of it, and so share its index of member names.
+	 */
+	const_shared_ptr<SymbolMap> GetLayout() const {
+		return m_layout;
+	}
+
 	static const_shared_ptr<CompoundType> GetDefaultCompoundType();
 
 	const Modifier::Type GetModifiers() const {
@@ -52,8 +61,12 @@ public:
 	}
 
 private:
+	static const_shared_ptr<SymbolMap> GetLayout(
+			const_shared_ptr<definition_map> definition);
+
 	const_shared_ptr<definition_map> m_definition;
 	const Modifier::Type m_modifiers;
+	const_shared_ptr<SymbolMap> m_layout;
 };
 
 #endif /* COMPOUND_TYPE_H_ */
@@ -21,60 +21,42 @@
 #include <member_definition.h>
 #include <function_type_specifier.h>
 #include <symbol_table.h>
+#include <cycle_collector.h>
 
 const_shared_ptr<CompoundTypeInstance> CompoundTypeInstance::GetDefaultInstance(
-		const string& type_name, const_shared_ptr<CompoundType> type) {
-	auto symbol_mapping = make_shared<symbol_map>();
+		const Atom& type_name, const_shared_ptr<CompoundType> type) {
+	//copy the type's layout, sharing its member index
+	auto symbol_table = make_shared<SymbolTable>(type->GetModifiers(),
+			make_shared<SymbolMap>(*type->GetLayout()));
 
-	plain_shared_ptr<definition_map> type_definition = type->GetDefinition();
-	definition_map::const_iterator iter;
-
-	auto symbol_table = make_shared<SymbolTable>(type->GetModifiers());
-
-	for (iter = type_definition->begin(); iter != type_definition->end();
-			++iter) {
-		const string member_name = iter->first;
-		const_shared_ptr<MemberDefinition> member_type_information =
-				iter->second;
-
-		auto symbol = GetSymbol(member_type_information->GetType(),
-				member_type_information->GetDefaultValue());
-		symbol_table->InsertSymbol(member_name, symbol);
-	}
-
-	const_shared_ptr<CompoundTypeSpecifier> type_specifier = const_shared_ptr<
-			CompoundTypeSpecifier>(new CompoundTypeSpecifier(type_name));
+	const_shared_ptr<CompoundTypeSpecifier> type_specifier =
+			CompoundTypeSpecifier::Get(type_name);
 
 	return make_shared<CompoundTypeInstance>(
 			CompoundTypeInstance(type_specifier, symbol_table));
 }
 
 const_shared_ptr<Symbol> CompoundTypeInstance::GetSymbol(
-		const_shared_ptr<TypeSpecifier> member_type,
-		const_shared_ptr<void> void_value) {
+		const_shared_ptr<TypeSpecifier> member_type, const Value& value) {
 	if (member_type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
-		return make_shared<Symbol>(static_pointer_cast<const bool>(void_value));
+		return make_shared<Symbol>(value.GetBoolean());
 	} else if (member_type->IsAssignableTo(PrimitiveTypeSpecifier::GetInt())) {
-		return make_shared<Symbol>(static_pointer_cast<const int>(void_value));
+		return make_shared<Symbol>(value.GetInt());
 	} else if (member_type->IsAssignableTo(
 			PrimitiveTypeSpecifier::GetDouble())) {
-		return make_shared<Symbol>(
-				static_pointer_cast<const double>(void_value));
+		return make_shared<Symbol>(value.GetDouble());
 	} else if (member_type->IsAssignableTo(
 			PrimitiveTypeSpecifier::GetString())) {
-		return make_shared<Symbol>(
-				static_pointer_cast<const string>(void_value));
-	} else if (std::dynamic_pointer_cast<const ArrayTypeSpecifier>(member_type)
+		return make_shared<Symbol>(value.GetReference<string>());
+	} else if (specifier_cast<ArrayTypeSpecifier>(member_type)
 			!= nullptr) {
-		return make_shared<Symbol>(static_pointer_cast<const Array>(void_value));
-	} else if (std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+		return make_shared<Symbol>(value.GetReference<Array>());
+	} else if (specifier_cast<CompoundTypeSpecifier>(
 			member_type)) {
-		return make_shared<Symbol>(
-				static_pointer_cast<const CompoundTypeInstance>(void_value));
-	} else if (std::dynamic_pointer_cast<const FunctionTypeSpecifier>(
+		return make_shared<Symbol>(value.GetReference<CompoundTypeInstance>());
+	} else if (specifier_cast<FunctionTypeSpecifier>(
 			member_type)) {
-		return make_shared<Symbol>(
-				static_pointer_cast<const Function>(void_value));
+		return make_shared<Symbol>(value.GetReference<Function>());
 	} else {
 		assert(false);
 		return nullptr;
@@ -88,3 +70,7 @@ const string CompoundTypeInstance::ToString(const TypeTable& type_table,
 	string result = buffer.str();
 	return result;
 }
+
+void CompoundTypeInstance::Trace(Tracer& tracer) const {
+	tracer.Visit(m_definition);
+}
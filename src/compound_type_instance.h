@@ -24,12 +24,15 @@
 #include <string>
 #include <linked_list.h>
 #include <type.h>
+#include <value.h>
+#include <atom.h>
 
 class CompoundType;
 class CompoundTypeSpecifier;
 class SymbolContext;
 class Symbol;
 class Indent;
+class Tracer;
 
 using namespace std;
 
@@ -49,15 +52,17 @@ public:
 	}
 
 	static const_shared_ptr<CompoundTypeInstance> GetDefaultInstance(
-			const string& type_name, const_shared_ptr<CompoundType> type);
+			const Atom& type_name, const_shared_ptr<CompoundType> type);
 
 	const static const_shared_ptr<Symbol> GetSymbol(
 			const_shared_ptr<TypeSpecifier> member_type,
-			const_shared_ptr<void> void_value);
+			const Value& value);
 
 	const string ToString(const TypeTable& type_table,
 			const Indent& indent) const;
 
+	void Trace(Tracer& tracer) const;
+
 private:
 	const_shared_ptr<CompoundTypeSpecifier> m_type;
 	volatile_shared_ptr<SymbolContext> m_definition;
@@ -0,0 +1,286 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cycle_collector.h>
+#include <array.h>
+#include <compound_type_instance.h>
+#include <execution_context.h>
+#include <frame_pool.h>
+#include <function.h>
+#include <sum.h>
+
+Tracer::Tracer(const size_t expected_node_count) :
+		m_nodes(), m_edges(), m_indices(), m_pending(), m_parents() {
+	m_nodes.reserve(expected_node_count);
+	m_edges.reserve(expected_node_count);
+	m_indices.reserve(expected_node_count);
+}
+
+void Tracer::Visit(const_shared_ptr<TypeSpecifier> type, const Value& value) {
+	if (value.GetKind() != Value::REFERENCE) {
+		return;
+	}
+
+	const plain_shared_ptr<void>& reference = value.GetReference();
+	const long use_count = reference.use_count();
+	switch (type->GetKind()) {
+	case TypeSpecifier::ARRAY:
+		Visit(static_cast<const Array*>(reference.get()), use_count);
+		break;
+	case TypeSpecifier::COMPOUND:
+		Visit(static_cast<const CompoundTypeInstance*>(reference.get()),
+				use_count);
+		break;
+	case TypeSpecifier::FUNCTION:
+		Visit(static_cast<const Function*>(reference.get()), use_count);
+		break;
+	case TypeSpecifier::SUM:
+		Visit(static_cast<const Sum*>(reference.get()), use_count);
+		break;
+	default:
+		//strings refer to nothing
+		break;
+	}
+}
+
+const bool Tracer::Enter(const void* node, const long use_count) {
+	const bool inserted = AddEdge(node, use_count, nullptr);
+	if (inserted) {
+		m_parents.push_back(m_indices[node]);
+	}
+	return inserted;
+}
+
+void Tracer::Leave() {
+	m_parents.pop_back();
+}
+
+void Tracer::AddStart(const ExecutionContext* context, const long use_count) {
+	bool inserted;
+	const size_t index = AddNode(context, use_count,
+			&TraceObject<ExecutionContext>, inserted);
+	if (inserted) {
+		m_pending.push_back(index);
+	}
+}
+
+void Tracer::Run() {
+	while (!m_pending.empty()) {
+		const size_t index = m_pending.back();
+		m_pending.pop_back();
+
+		//tracing may add nodes, so the node can't be held by reference
+		const void* object = m_nodes[index].object;
+		TraceFunction trace = m_nodes[index].trace;
+		m_parents.push_back(index);
+		trace(object, *this);
+		m_parents.pop_back();
+	}
+
+	//group the edges by the node they leave
+	std::vector<size_t> offsets(m_nodes.size() + 1, 0);
+	for (const Edge& edge : m_edges) {
+		offsets[edge.from + 1]++;
+	}
+	for (size_t i = 0; i < m_nodes.size(); i++) {
+		offsets[i + 1] += offsets[i];
+	}
+	std::vector<size_t> children(m_edges.size());
+	std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+	for (const Edge& edge : m_edges) {
+		children[next[edge.from]++] = edge.to;
+	}
+
+	//an object with more references than the trace found is referenced from
+	//outside the traced graph
+	std::vector<size_t> marking;
+	for (size_t i = 0; i < m_nodes.size(); i++) {
+		Node& node = m_nodes[i];
+		if (node.use_count > node.internal_count) {
+			node.reachable = true;
+			marking.push_back(i);
+		}
+	}
+
+	while (!marking.empty()) {
+		const size_t index = marking.back();
+		marking.pop_back();
+		for (size_t i = offsets[index]; i < offsets[index + 1]; i++) {
+			const size_t child = children[i];
+			if (!m_nodes[child].reachable) {
+				m_nodes[child].reachable = true;
+				marking.push_back(child);
+			}
+		}
+	}
+}
+
+const bool Tracer::IsReachable(const void* object) const {
+	auto result = m_indices.find(object);
+	return result == m_indices.end() || m_nodes[result->second].reachable;
+}
+
+const size_t Tracer::AddNode(const void* object, const long use_count,
+		TraceFunction trace, bool& inserted) {
+	auto result = m_indices.insert(
+			std::pair<const void*, size_t>(object, m_nodes.size()));
+	inserted = result.second;
+	if (inserted) {
+		Node node = { object, trace, use_count, 0, false };
+		m_nodes.push_back(node);
+	}
+	return result.first->second;
+}
+
+const bool Tracer::AddEdge(const void* object, const long use_count,
+		TraceFunction trace) {
+	bool inserted;
+	const size_t index = AddNode(object, use_count, trace, inserted);
+	m_nodes[index].internal_count++;
+	Edge edge = { m_parents.back(), index };
+	m_edges.push_back(edge);
+	if (inserted && trace) {
+		m_pending.push_back(index);
+	}
+	return inserted;
+}
+
+CycleCollector::CycleCollector() :
+		m_tracked(), m_threshold(MINIMUM_THRESHOLD), m_collection_count(0), m_reclaimed_count(
+				0), m_peak_tracked(0), m_traced_count(0), m_total_pause(
+				0), m_max_pause(0) {
+}
+
+CycleCollector::~CycleCollector() {
+}
+
+namespace {
+//trivially destructible, so that it stays valid while its thread exits
+thread_local CycleCollector* thread_collector = nullptr;
+thread_local CycleCollector* current_collector = nullptr;
+
+struct CollectorReleaser {
+	~CollectorReleaser() {
+		//whatever the thread captured is collected before it exits
+		thread_collector->Collect();
+		delete thread_collector;
+		thread_collector = nullptr;
+	}
+};
+}
+
+CycleCollector::Scope::Scope(CycleCollector& collector) :
+		m_previous(current_collector) {
+	current_collector = &collector;
+}
+
+CycleCollector::Scope::~Scope() {
+	current_collector = m_previous;
+}
+
+CycleCollector& CycleCollector::GetInstance() {
+	if (current_collector) {
+		return *current_collector;
+	}
+
+	if (!thread_collector) {
+		thread_collector = new CycleCollector();
+		static thread_local CollectorReleaser releaser;
+	}
+	return *thread_collector;
+}
+
+void CycleCollector::Collect() {
+	auto start = std::chrono::steady_clock::now();
+
+	m_peak_tracked = std::max(m_peak_tracked, m_tracked.size());
+
+	std::vector<std::shared_ptr<ExecutionContext>> contexts;
+	contexts.reserve(m_tracked.size());
+	for (const auto& tracked : m_tracked) {
+		auto context = tracked.lock();
+		if (context) {
+			contexts.push_back(context);
+		}
+	}
+	m_tracked.clear();
+
+	//a frame that holds several closures is tracked once for each
+	std::sort(contexts.begin(), contexts.end());
+	contexts.erase(std::unique(contexts.begin(), contexts.end()),
+			contexts.end());
+
+	//nothing is destroyed until the traced graph is no longer needed
+	std::vector<SymbolMap> released_tables;
+	std::vector<plain_shared_ptr<Symbol>> released_values;
+	{
+		//a frame typically owns its table, a node of symbols and a few values
+		Tracer tracer(contexts.size() * 8);
+		for (const auto& context : contexts) {
+			tracer.AddStart(context.get(), context.use_count() - 1);
+		}
+		tracer.Run();
+		m_traced_count += tracer.GetNodeCount();
+
+		for (const auto& context : contexts) {
+			if (tracer.IsReachable(context.get())) {
+				m_tracked.push_back(context);
+				continue;
+			}
+
+			//the table may be shared with a live block context
+			const shared_ptr<SymbolMap>& table = context->GetTable();
+			if (!tracer.IsReachable(table.get())) {
+				released_tables.push_back(*table);
+				table->Clear();
+			}
+
+			released_values.push_back(context->GetReturnValue());
+			context->SetReturnValue(Symbol::GetDefaultSymbol());
+			m_reclaimed_count++;
+		}
+	}
+
+	released_values.clear();
+	released_tables.clear();
+	contexts.clear();
+
+	m_threshold = std::max(MINIMUM_THRESHOLD, 2 * m_tracked.size());
+
+	const double pause = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count();
+	m_collection_count++;
+	m_total_pause += pause;
+	m_max_pause = std::max(m_max_pause, pause);
+}
+
+void CycleCollector::PrintStatistics(std::ostream& out) const {
+	const FramePool& pool = FramePool::GetInstance();
+	out << "Cycle collector: " << m_collection_count << " collections, "
+			<< m_reclaimed_count << " frames reclaimed, " << m_traced_count
+			<< " objects traced" << std::endl;
+	out << "  pause: " << m_total_pause << " ms total, " << m_max_pause
+			<< " ms max" << std::endl;
+	out << "  heap: " << m_tracked.size() << " captured frames ("
+			<< std::max(m_peak_tracked, m_tracked.size()) << " peak), "
+			<< pool.GetAllocatedSize() << " bytes of frames ("
+			<< pool.GetPeakAllocatedSize() << " peak)" << std::endl;
+}
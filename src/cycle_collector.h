@@ -0,0 +1,222 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CYCLE_COLLECTOR_H_
+#define CYCLE_COLLECTOR_H_
+
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include <defaults.h>
+
+class ExecutionContext;
+class TypeSpecifier;
+class Value;
+
+/**
+ * The state of a single traversal of the heap by the cycle collector. Objects that
+ * may be part of a cycle implement a Trace method that visits each reference they
+ * own; the tracer records the resulting graph.
+ *
+ * A visit must be passed the reference the object actually holds, not a copy of it,
+ * since the reference's count is what the collector reasons about.
+ */
+class Tracer {
+public:
+	template<class T> void Visit(const std::shared_ptr<T>& reference) {
+		//an immortal object has no count, and is never part of a cycle
+		if (reference && reference.use_count() > 0) {
+			Visit(reference.get(), reference.use_count());
+		}
+	}
+
+	/**
+	 * Visit an object through a reference with the given count.
+	 */
+	template<class T> void Visit(const T* object, const long use_count) {
+		AddEdge(object, use_count, &TraceObject<T>);
+	}
+
+	/**
+	 * Visit the object referred to by a value of the given type, if any.
+	 */
+	void Visit(const_shared_ptr<TypeSpecifier> type, const Value& value);
+
+	/**
+	 * Visit an interior node of a data structure, such as a node of a persistent
+	 * vector. Returns true if the node hasn't been seen before, in which case the
+	 * caller visits the node's references immediately and then calls Leave.
+	 */
+	const bool Enter(const void* node, const long use_count);
+	void Leave();
+
+private:
+	friend class CycleCollector;
+
+	typedef void (*TraceFunction)(const void* object, Tracer& tracer);
+
+	struct Node {
+		const void* object;
+		TraceFunction trace;
+		long use_count;
+		long internal_count;
+		bool reachable;
+	};
+
+	struct Edge {
+		size_t from;
+		size_t to;
+	};
+
+	template<class T> static void TraceObject(const void* object,
+			Tracer& tracer) {
+		static_cast<const T*>(object)->Trace(tracer);
+	}
+
+	Tracer(const size_t expected_node_count);
+
+	/**
+	 * Add a node to start the traversal from. Its count excludes the reference the
+	 * collector itself holds.
+	 */
+	void AddStart(const ExecutionContext* context, const long use_count);
+
+	/**
+	 * Visit the references of every node reachable from the start nodes, then mark
+	 * the nodes that are reachable from outside the traced graph.
+	 */
+	void Run();
+
+	const bool IsReachable(const void* object) const;
+
+	const size_t GetNodeCount() const {
+		return m_nodes.size();
+	}
+
+	const size_t AddNode(const void* object, const long use_count,
+			TraceFunction trace, bool& inserted);
+	const bool AddEdge(const void* object, const long use_count,
+			TraceFunction trace);
+
+	std::vector<Node> m_nodes;
+	std::vector<Edge> m_edges;
+	std::unordered_map<const void*, size_t> m_indices;
+	std::vector<size_t> m_pending;
+	std::vector<size_t> m_parents;
+};
+
+/**
+ * Reclaims the cycles of references that reference counting alone cannot, such as
+ * a frame that holds a closure over itself.
+ *
+ * Frames captured by a closure are tracked as they are captured. A collection
+ * traces everything the tracked frames own and compares each traced object's
+ * reference count with the number of references to it found by the trace. An
+ * object with references from elsewhere (a running frame, a register, the syntax
+ * tree) is live, as is everything reachable from it; the rest of the traced graph is
+ * garbage held only by its own cycles. Collection breaks the cycles by releasing
+ * the symbols of the garbage frames, whereupon reference counting frees them.
+ *
+ * References the trace doesn't know about simply count as external, so an
+ * incomplete trace can only cause garbage to survive, never a live object to be
+ * released.
+ *
+ * A collection runs once the number of tracked frames doubles since the previous
+ * collection, so its cost is amortized over the frames captured in between.
+ *
+ * Each thread has a collector of its own, which tracks the frames captured on
+ * that thread and collects them when the thread exits, if not before. A script
+ * loaded through the embedding API has a collector of its own instead, which is
+ * made current on whichever thread runs the script, so that its frames are all
+ * collected when it is destroyed, while the syntax tree they refer to still
+ * exists. Scripts share no frames, so their collectors never trace each other's
+ * objects.
+ */
+class CycleCollector {
+public:
+	/**
+	 * Makes a collector the current one of the calling thread for the lifetime
+	 * of the scope.
+	 */
+	class Scope {
+	public:
+		Scope(CycleCollector& collector);
+		virtual ~Scope();
+
+	private:
+		Scope(const Scope& other) = delete;
+		Scope& operator=(const Scope& other) = delete;
+
+		CycleCollector* const m_previous;
+	};
+
+	CycleCollector();
+	virtual ~CycleCollector();
+
+	/**
+	 * The current collector of the calling thread: the one made current by the
+	 * innermost scope, if any, or else the thread's own.
+	 */
+	static CycleCollector& GetInstance();
+
+	/**
+	 * Track a frame that has been captured by a closure, collecting if enough
+	 * frames have been tracked since the last collection.
+	 */
+	void Track(const std::shared_ptr<ExecutionContext>& context) {
+		m_tracked.push_back(context);
+		if (m_tracked.size() >= m_threshold) {
+			Collect();
+		}
+	}
+
+	void Collect();
+
+	/**
+	 * Write a summary of the collector's activity.
+	 */
+	void PrintStatistics(std::ostream& out) const;
+
+	const size_t GetCollectionCount() const {
+		return m_collection_count;
+	}
+
+	const size_t GetReclaimedCount() const {
+		return m_reclaimed_count;
+	}
+
+private:
+	CycleCollector(const CycleCollector& other) = delete;
+	CycleCollector& operator=(const CycleCollector& other) = delete;
+
+	static const size_t MINIMUM_THRESHOLD = 1024;
+
+	std::vector<std::weak_ptr<ExecutionContext>> m_tracked;
+	size_t m_threshold;
+
+	size_t m_collection_count;
+	size_t m_reclaimed_count;
+	size_t m_peak_tracked;
+	size_t m_traced_count;
+	double m_total_pause;
+	double m_max_pause;
+};
+
+#endif /* CYCLE_COLLECTOR_H_ */
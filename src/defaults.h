@@ -31,6 +31,16 @@ using plain_shared_ptr = std::shared_ptr<const T>;
 template<class T>
 using volatile_shared_ptr = std::shared_ptr<T>;
 
+/**
+ * Share an object that is never destroyed, such as a canonical instance,
+ * without counting references to it. Copying the resulting pointer touches no
+ * reference count, so threads that copy it don't contend for one.
+ */
+template<class T>
+std::shared_ptr<T> make_immortal(T* object) {
+	return std::shared_ptr<T>(std::shared_ptr<T>(), object);
+}
+
 #include <location.hh>
 const yy::location GetDefaultLocation();
 
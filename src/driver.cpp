@@ -25,7 +25,7 @@ int Driver::parse(const std::string& file_name, const TRACE trace_level) {
 	if (scan_begin_result != EXIT_SUCCESS)
 		return scan_begin_result;
 
-	yy::newt_parser parser(*this);
+	yy::newt_parser parser(*this, m_scanner);
 	parser.set_debug_level((trace_level & PARSING));
 	int res = parser.parse();
 	scan_end();
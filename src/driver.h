@@ -21,9 +21,10 @@
 #define DRIVER_H_
 
 #include "parser.tab.hh"
+#include <arena.h>
 
 #define YY_DECL \
-	yy::newt_parser::symbol_type yylex (Driver& driver)
+	yy::newt_parser::symbol_type yylex (Driver& driver, yyscan_t yyscanner)
 YY_DECL;
 
 enum TRACE {
@@ -62,10 +63,42 @@ public:
 		return m_error_count;
 	}
 
+	/**
+	 * The location of the token being scanned.
+	 */
+	yy::location& GetLocation() {
+		return m_location;
+	}
+
+	/**
+	 * Create a node of the parsed program. Nodes are allocated from an arena
+	 * owned by this driver, and so must not outlive it.
+	 */
+	template<typename T, typename ... Args> const shared_ptr<T> Create(
+			Args&&... args) {
+		return std::allocate_shared<T>(GetAllocator(),
+				std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Get an allocator for list cells of the parsed program.
+	 */
+	const ArenaAllocator<void> GetAllocator() {
+		return ArenaAllocator<void>(m_arena);
+	}
+
+	const Arena& GetArena() const {
+		return m_arena;
+	}
+
 private:
+	//declared first, so that it is destroyed after the statement block
+	Arena m_arena;
 	std::string m_file_name;
 	plain_shared_ptr<StatementBlock> m_statement_block;
 	unsigned int m_error_count = 0;
+	yyscan_t m_scanner = nullptr;
+	yy::location m_location;
 };
 
 #endif /* DRIVER_H_ */
@@ -196,3 +196,57 @@ ostream &operator<<(ostream &os, const Error &error) {
 	os << error.ToString();
 	return os;
 }
+
+const ErrorListRef ErrorList::From(const shared_ptr<const Error> error,
+		const ErrorListRef& next) {
+	shared_ptr<Buffer> buffer;
+	size_t size = 0;
+	if (!IsTerminator(next)) {
+		size = next->m_size;
+		if (next->m_buffer->size() == size) {
+			//no other list extends the next one, so its buffer can be shared
+			buffer = next->m_buffer;
+		} else {
+			buffer = make_shared<Buffer>(next->m_buffer->begin(),
+					next->m_buffer->begin() + size);
+		}
+	} else {
+		buffer = make_shared<Buffer>();
+	}
+
+	buffer->push_back(error);
+	return ErrorListRef(new ErrorList(buffer, size + 1));
+}
+
+const ErrorListRef ErrorList::Concatenate(const ErrorListRef& base,
+		const ErrorListRef& continuation) {
+	if (IsTerminator(base)) {
+		return continuation;
+	}
+	if (IsTerminator(continuation)) {
+		return base;
+	}
+
+	shared_ptr<Buffer> buffer;
+	if (base->m_buffer->size() == base->m_size
+			&& base->m_buffer != continuation->m_buffer) {
+		//no other list extends the base, so its buffer can be shared
+		buffer = base->m_buffer;
+	} else {
+		buffer = make_shared<Buffer>(base->m_buffer->begin(),
+				base->m_buffer->begin() + base->m_size);
+	}
+
+	buffer->insert(buffer->end(), continuation->m_buffer->begin(),
+			continuation->m_buffer->begin() + continuation->m_size);
+	return ErrorListRef(new ErrorList(buffer, buffer->size()));
+}
+
+const ErrorListRef ErrorList::Reverse(const ErrorListRef& subject) {
+	if (IsTerminator(subject)) {
+		return subject;
+	}
+
+	auto buffer = make_shared<Buffer>(subject->begin(), subject->end());
+	return ErrorListRef(new ErrorList(buffer, buffer->size()));
+}
@@ -34,7 +34,9 @@
 #define ERROR_H
 
 #include <string>
-#include <linked_list.h>
+#include <memory>
+#include <vector>
+#include <statistics.h>
 
 using namespace std;
 
@@ -107,7 +109,70 @@ private:
 
 std::ostream &operator<<(std::ostream &os, const Error &error);
 
-typedef const LinkedList<Error, NO_DUPLICATES> ErrorList;
-typedef shared_ptr<ErrorList> ErrorListRef;
+class ErrorList;
+typedef shared_ptr<const ErrorList> ErrorListRef;
+
+/**
+ * An immutable list of errors, stored contiguously.
+ *
+ * The empty list (the terminator) is a null reference, so success is reported
+ * without allocating, and checking for errors is a null test.
+ *
+ * Lists built by prepending to one another share their storage: errors are
+ * stored in reverse order, and prepending to the most recently extended list
+ * of a buffer appends to that buffer in place, so building a list of n errors
+ * costs amortized O(n) rather than one allocation per error.
+ */
+class ErrorList {
+public:
+	typedef std::vector<shared_ptr<const Error>> Buffer;
+	typedef Buffer::const_reverse_iterator const_iterator;
+
+	static const ErrorListRef GetTerminator() {
+		static const ErrorListRef terminator;
+		return terminator;
+	}
+
+	static const bool IsTerminator(const ErrorListRef& subject) {
+		return !subject;
+	}
+
+	/**
+	 * Prepend an error to a list.
+	 */
+	static const ErrorListRef From(const shared_ptr<const Error> error,
+			const ErrorListRef& next);
+
+	/**
+	 * Prepend the errors of continuation to base. As with From, errors are
+	 * accumulated newest first.
+	 */
+	static const ErrorListRef Concatenate(const ErrorListRef& base,
+			const ErrorListRef& continuation);
+
+	static const ErrorListRef Reverse(const ErrorListRef& subject);
+
+	const size_t GetSize() const {
+		return m_size;
+	}
+
+	const_iterator begin() const {
+		return const_iterator(m_buffer->begin() + m_size);
+	}
+
+	const_iterator end() const {
+		return const_iterator(m_buffer->begin());
+	}
+
+private:
+	ErrorList(const shared_ptr<Buffer> buffer, const size_t size) :
+			m_buffer(buffer), m_size(size) {
+		STATISTICS_INCREMENT(ERROR_LISTS);
+	}
+
+	//errors are stored last to first; only the first m_size belong to this list
+	const shared_ptr<Buffer> m_buffer;
+	const size_t m_size;
+};
 
 #endif // #ifndef ERROR_H
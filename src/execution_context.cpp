@@ -21,9 +21,12 @@
 #include <symbol_table.h>
 #include <type_table.h>
 #include <memory>
+#include <frame_pool.h>
+#include <cycle_collector.h>
+#include <statistics.h>
 
 ExecutionContext::ExecutionContext() :
-		ExecutionContext(Modifier::Type::NONE, make_shared<symbol_map>(),
+		ExecutionContext(Modifier::Type::NONE, make_shared<SymbolMap>(),
 				SymbolContextList::GetTerminator(), make_shared<TypeTable>(),
 				Symbol::GetDefaultSymbol(), plain_shared_ptr<int>(nullptr),
 				PERSISTENT) {
@@ -39,21 +42,39 @@ ExecutionContext::ExecutionContext(const shared_ptr<SymbolContext> existing,
 ExecutionContext::ExecutionContext(const Modifier::Type modifiers,
 		const SymbolContextListRef parent_context,
 		volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time) :
-		ExecutionContext(modifiers, make_shared<symbol_map>(), parent_context,
+		ExecutionContext(modifiers, make_shared<SymbolMap>(), parent_context,
 				type_table, Symbol::GetDefaultSymbol(),
 				plain_shared_ptr<int>(nullptr), life_time) {
 }
 
-const_shared_ptr<Symbol> ExecutionContext::GetSymbol(const string& identifier,
-		const SearchType search_type) const {
-	auto result = SymbolContext::GetSymbol(identifier);
+ExecutionContext::ExecutionContext(const Modifier::Type modifiers,
+		const shared_ptr<SymbolMap> values,
+		const SymbolContextListRef parent_context,
+		volatile_shared_ptr<TypeTable> type_table, const LifeTime life_time) :
+		ExecutionContext(modifiers, values, parent_context, type_table,
+				Symbol::GetDefaultSymbol(), plain_shared_ptr<int>(nullptr),
+				life_time) {
+}
 
-	if (result == Symbol::GetDefaultSymbol() && m_parent
-			&& search_type == DEEP) {
-		return m_parent->GetData()->GetSymbol(identifier, search_type);
-	} else {
-		return result;
+const_shared_ptr<Symbol> ExecutionContext::GetSymbol(const Atom& identifier,
+		const SearchType search_type) const {
+	STATISTICS_INCREMENT(SYMBOL_LOOKUPS);
+
+	//walk the parent chain iteratively rather than recursing into each parent
+	const ExecutionContext* context = this;
+	auto result = context->SymbolContext::GetSymbol(identifier);
+	while (result == Symbol::GetDefaultSymbol() && search_type == DEEP
+			&& context->m_parent) {
+		context = context->m_parent->GetRawData();
+		if (!context) {
+			break;
+		}
+
+		STATISTICS_INCREMENT(SYMBOL_LOOKUP_DEPTH);
+		result = context->SymbolContext::GetSymbol(identifier);
 	}
+
+	return result;
 }
 
 const void ExecutionContext::print(ostream& os, const TypeTable& type_table,
@@ -68,8 +89,8 @@ const void ExecutionContext::print(ostream& os, const TypeTable& type_table,
 	}
 }
 
-SetResult ExecutionContext::SetSymbol(const string& identifier,
-		const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value) {
+SetResult ExecutionContext::SetSymbol(const Atom& identifier,
+		const_shared_ptr<TypeSpecifier> type, const Value& value) {
 	auto result = SymbolContext::SetSymbol(identifier, type, value);
 
 	if (result == UNDEFINED_SYMBOL && m_parent) {
@@ -86,6 +107,66 @@ const_shared_ptr<Symbol> ExecutionContext::GetSymbol(
 	return GetSymbol(*identifier, search_type);
 }
 
+const_shared_ptr<Symbol> ExecutionContext::GetSymbol(const Atom& identifier,
+		SymbolReference& reference) const {
+	STATISTICS_INCREMENT(SYMBOL_LOOKUPS);
+
+	auto context = Resolve(identifier, reference);
+	if (context) {
+		STATISTICS_ADD(SYMBOL_LOOKUP_DEPTH, reference.depth);
+		return context->GetTable()->GetSymbol(reference.slot);
+	} else {
+		return Symbol::GetDefaultSymbol();
+	}
+}
+
+SetResult ExecutionContext::SetSymbol(const Atom& identifier,
+		SymbolReference& reference, const_shared_ptr<TypeSpecifier> type,
+		const Value& value) {
+	auto context = Resolve(identifier, reference);
+	if (context) {
+		return context->SetSlot(reference.slot, type, value);
+	} else {
+		return UNDEFINED_SYMBOL;
+	}
+}
+
+ExecutionContext* ExecutionContext::Resolve(const Atom& identifier,
+		SymbolReference& reference) const {
+	ExecutionContext* context = const_cast<ExecutionContext*>(this);
+	for (int i = 0; i < reference.depth && context; i++) {
+		context = context->m_parent ? context->m_parent->GetRawData() : nullptr;
+	}
+
+	if (context && reference.depth >= 0) {
+		auto& table = context->GetTable();
+		if (reference.IsIndex(table->GetIndex())
+				|| table->HasSlot(reference.slot, identifier)) {
+			return context;
+		}
+	}
+
+	//the reference is stale or unresolved; search the chain as a DEEP lookup would
+	context = const_cast<ExecutionContext*>(this);
+	int depth = 0;
+	while (context) {
+		auto table = context->GetTable();
+		const size_t slot = table->GetSlot(identifier);
+		if (slot != SymbolMap::NO_SLOT
+				&& table->GetSymbol(slot) != Symbol::GetDefaultSymbol()) {
+			reference.depth = depth;
+			reference.slot = slot;
+			reference.index = table->GetIndex();
+			return context;
+		}
+
+		context = context->m_parent ? context->m_parent->GetRawData() : nullptr;
+		depth++;
+	}
+
+	return nullptr;
+}
+
 ExecutionContext::ExecutionContext(const shared_ptr<SymbolContext> context,
 		const SymbolContextListRef parent_context,
 		volatile_shared_ptr<TypeTable> type_table,
@@ -93,27 +174,60 @@ ExecutionContext::ExecutionContext(const shared_ptr<SymbolContext> context,
 		const LifeTime life_time) :
 		SymbolTable(*context), m_parent(parent_context), m_type_table(
 				type_table), m_return_value(return_value), m_exit_code(
-				exit_code), m_life_time(life_time) {
+				exit_code), m_life_time(life_time), m_tail_call(nullptr) {
 }
 
 ExecutionContext::ExecutionContext(const Modifier::Type modifiers,
-		const shared_ptr<symbol_map> symbol_map,
+		const shared_ptr<SymbolMap> symbol_map,
 		const SymbolContextListRef parent_context,
 		volatile_shared_ptr<TypeTable> type_table,
 		const_shared_ptr<Symbol> return_value, const_shared_ptr<int> exit_code,
 		const LifeTime life_time) :
 		SymbolTable(modifiers, symbol_map), m_parent(parent_context), m_type_table(
 				type_table), m_return_value(return_value), m_exit_code(
-				exit_code), m_life_time(life_time) {
+				exit_code), m_life_time(life_time), m_tail_call(nullptr) {
 }
 
 ExecutionContext::~ExecutionContext() {
 }
 
+void ExecutionContext::Trace(Tracer& tracer) const {
+	SymbolContext::Trace(tracer);
+	tracer.Visit(m_parent);
+	tracer.Visit(m_return_value);
+}
+
+const shared_ptr<ExecutionContext> ExecutionContext::WithContents(
+		const shared_ptr<SymbolContext> contents) const {
+	if (m_life_time == EPHEMERAL) {
+		return allocate_shared<ExecutionContext>(
+				FrameAllocator<ExecutionContext>(), contents, m_parent,
+				m_type_table, m_return_value, m_exit_code, m_life_time);
+	} else {
+		return shared_ptr<ExecutionContext>(
+				new ExecutionContext(contents, m_parent, m_type_table,
+						m_return_value, m_exit_code, m_life_time));
+	}
+}
+
+const shared_ptr<ExecutionContext> ExecutionContext::WithParent(
+		const SymbolContextListRef parent_context) const {
+	if (m_life_time == EPHEMERAL) {
+		return allocate_shared<ExecutionContext>(
+				FrameAllocator<ExecutionContext>(), GetModifiers(),
+				GetTable(), parent_context, m_type_table, m_return_value,
+				m_exit_code, m_life_time);
+	} else {
+		return shared_ptr<ExecutionContext>(
+				new ExecutionContext(GetModifiers(), GetTable(), parent_context,
+						m_type_table, m_return_value, m_exit_code, m_life_time));
+	}
+}
+
 const shared_ptr<ExecutionContext> ExecutionContext::GetDefault() {
 	static const shared_ptr<ExecutionContext> instance = make_shared<
 			ExecutionContext>(Modifier::READONLY,
-			SymbolContextList::GetTerminator(), TypeTable::GetDefault(),
+			SymbolContextList::GetTerminator(), make_shared<TypeTable>(),
 			PERSISTENT);
 	return instance;
 }
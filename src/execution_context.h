@@ -25,6 +25,8 @@
 #include <modifier.h>
 
 class TypeTable;
+struct TailCall;
+template<typename T> class FrameAllocator;
 
 enum LifeTime {
 	PERSISTENT, EPHEMERAL
@@ -50,25 +52,22 @@ public:
 			const SymbolContextListRef parent_context,
 			volatile_shared_ptr<TypeTable> type_table,
 			const LifeTime life_time);
+	ExecutionContext(const Modifier::Type modifiers,
+			const shared_ptr<SymbolMap> values,
+			const SymbolContextListRef parent_context,
+			volatile_shared_ptr<TypeTable> type_table,
+			const LifeTime life_time);
 	virtual ~ExecutionContext();
 
 	const shared_ptr<ExecutionContext> WithContents(
-			const shared_ptr<SymbolContext> contents) const {
-		return shared_ptr<ExecutionContext>(
-				new ExecutionContext(contents, m_parent, m_type_table,
-						m_return_value, m_exit_code, m_life_time));
-	}
+			const shared_ptr<SymbolContext> contents) const;
 
 	const SymbolContextListRef GetParent() const {
 		return m_parent;
 	}
 
 	virtual const shared_ptr<ExecutionContext> WithParent(
-			const SymbolContextListRef parent_context) const {
-		return shared_ptr<ExecutionContext>(
-				new ExecutionContext(GetModifiers(), GetTable(), parent_context,
-						m_type_table, m_return_value, m_exit_code, m_life_time));
-	}
+			const SymbolContextListRef parent_context) const;
 
 	volatile_shared_ptr<TypeTable> GetTypeTable() const {
 		return m_type_table;
@@ -90,6 +89,24 @@ public:
 		m_exit_code = exit_code;
 	}
 
+	/**
+	 * The slot in which a return statement executed directly in this context may
+	 * leave a call for the caller of the frame to make, or null if the context is
+	 * not the frame of a function invocation.
+	 */
+	TailCall* GetTailCall() const {
+		return m_tail_call;
+	}
+
+	void SetTailCall(TailCall* tail_call) {
+		m_tail_call = tail_call;
+	}
+
+	/**
+	 * The closure of default function values. It is shared by every thread; it
+	 * is read-only and has no parent or types of its own, so nothing ever
+	 * modifies it.
+	 */
 	static const shared_ptr<ExecutionContext> GetDefault();
 
 	const LifeTime GetLifeTime() const {
@@ -98,19 +115,33 @@ public:
 
 	const_shared_ptr<Symbol> GetSymbol(const_shared_ptr<string> identifier,
 			const SearchType search_type) const;
-	const_shared_ptr<Symbol> GetSymbol(const string& identifier,
+	const_shared_ptr<Symbol> GetSymbol(const Atom& identifier,
 			const SearchType search_type) const;
 
+	/**
+	 * Look up a symbol through a reference resolved by a previous lookup. The reference is
+	 * used as long as its slot still holds the identifier, and is re-resolved otherwise.
+	 */
+	const_shared_ptr<Symbol> GetSymbol(const Atom& identifier,
+			SymbolReference& reference) const;
+
+	SetResult SetSymbol(const Atom& identifier, SymbolReference& reference,
+			const_shared_ptr<TypeSpecifier> type, const Value& value);
+
 	const void print(ostream &os, const TypeTable& type_table,
 			const Indent& indent, const SearchType search_type = SHALLOW) const;
 
+	virtual void Trace(Tracer& tracer) const;
+
 protected:
-	virtual SetResult SetSymbol(const string& identifier,
-			const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value);
+	virtual SetResult SetSymbol(const Atom& identifier,
+			const_shared_ptr<TypeSpecifier> type, const Value& value);
 
 private:
+	template<typename U> friend class FrameAllocator;
+
 	ExecutionContext(const Modifier::Type modifiers,
-			const shared_ptr<symbol_map>,
+			const shared_ptr<SymbolMap>,
 			const SymbolContextListRef parent_context,
 			volatile_shared_ptr<TypeTable> type_table,
 			const_shared_ptr<Symbol> return_value,
@@ -122,11 +153,15 @@ private:
 			const_shared_ptr<Symbol> return_value,
 			const_shared_ptr<int> exit_code, const LifeTime life_time);
 
+	ExecutionContext* Resolve(const Atom& identifier,
+			SymbolReference& reference) const;
+
 	const SymbolContextListRef m_parent;
 	volatile_shared_ptr<TypeTable> m_type_table;
 	plain_shared_ptr<Symbol> m_return_value;
 	plain_shared_ptr<int> m_exit_code;
 	const LifeTime m_life_time;
+	TailCall* m_tail_call;
 };
 
 #endif /* EXECUTION_CONTEXT_H_ */
@@ -43,13 +43,13 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const int& left,
 		yy::location right_position) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	int* result = new int;
+	int result = 0;
 	switch (GetOperator()) {
 	case PLUS:
-		*result = left + right;
+		result = left + right;
 		break;
 	case MULTIPLY:
-		*result = left * right;
+		result = left * right;
 		break;
 	case DIVIDE:
 		if (right == 0) {
@@ -57,13 +57,13 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const int& left,
 					make_shared<Error>(Error::SEMANTIC, Error::DIVIDE_BY_ZERO,
 							right_position.begin.line,
 							right_position.begin.column), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left / right;
+			result = left / right;
 		}
 		break;
 	case MINUS:
-		*result = left - right;
+		result = left - right;
 		break;
 	case MOD:
 		if (right == 0) {
@@ -71,16 +71,16 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const int& left,
 					make_shared<Error>(Error::SEMANTIC, Error::MOD_BY_ZERO,
 							right_position.begin.line,
 							right_position.begin.column), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left % right;
+			result = left % right;
 		}
 		break;
 	default:
 		break;
 	}
 
-	return make_shared<Result>(const_shared_ptr<const void>(result), errors);
+	return make_shared<Result>(Value(result), errors);
 }
 
 const_shared_ptr<Result> ArithmeticExpression::compute(const double& left,
@@ -88,13 +88,13 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const double& left,
 		yy::location right_position) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	double* result = new double;
+	double result = 0;
 	switch (GetOperator()) {
 	case PLUS:
-		*result = left + right;
+		result = left + right;
 		break;
 	case MULTIPLY:
-		*result = left * right;
+		result = left * right;
 		break;
 	case DIVIDE:
 		if (right == 0.0) {
@@ -102,19 +102,19 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const double& left,
 					make_shared<Error>(Error::SEMANTIC, Error::DIVIDE_BY_ZERO,
 							right_position.begin.line,
 							right_position.begin.column), errors);
-			*result = 0;
+			result = 0;
 		} else {
-			*result = left / right;
+			result = left / right;
 		}
 		break;
 	case MINUS:
-		*result = left - right;
+		result = left - right;
 		break;
 	default:
 		break;
 	}
 
-	return make_shared<Result>(const_shared_ptr<const void>(result), errors);
+	return make_shared<Result>(Value(result), errors);
 }
 
 const_shared_ptr<Result> ArithmeticExpression::compute(const string& left,
@@ -125,8 +125,7 @@ const_shared_ptr<Result> ArithmeticExpression::compute(const string& left,
 	buffer << left;
 	buffer << right;
 	const string buffer_string = buffer.str();
-	const string* result = new string(buffer_string);
-	return make_shared<Result>(const_shared_ptr<const void>(result),
+	return make_shared<Result>(make_shared<const string>(buffer_string),
 			ErrorList::GetTerminator());
 }
 
@@ -147,3 +146,27 @@ const ErrorListRef ArithmeticExpression::Validate(
 				PrimitiveTypeSpecifier::GetDouble());
 	}
 }
+
+const BinaryExpression::Kernel ArithmeticExpression::GetKernel(
+		const BasicType left, const BasicType right) const {
+	Kernel kernel = nullptr;
+	switch (GetOperator()) {
+	case PLUS:
+		kernel = GetNumericKernel<std::plus>(left, right);
+		break;
+	case MINUS:
+		kernel = GetNumericKernel<std::minus>(left, right);
+		break;
+	case MULTIPLY:
+		kernel = GetNumericKernel<std::multiplies>(left, right);
+		break;
+	default:
+		break;
+	}
+
+	if (kernel) {
+		return kernel;
+	} else {
+		return BinaryExpression::GetKernel(left, right);
+	}
+}
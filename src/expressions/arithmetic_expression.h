@@ -32,6 +32,9 @@ public:
 			const shared_ptr<ExecutionContext> execution_context) const;
 
 protected:
+	virtual const Kernel GetKernel(const BasicType left,
+			const BasicType right) const;
+
 	virtual const_shared_ptr<Result> compute(const bool& left,
 			const bool& right, yy::location left_position,
 			yy::location right_position) const;
@@ -23,7 +23,8 @@
 BinaryExpression::BinaryExpression(const yy::location position,
 		const OperatorType op, const_shared_ptr<Expression> left,
 		const_shared_ptr<Expression> right) :
-		Expression(position), m_operator(op), m_left(left), m_right(right) {
+		Expression(position), m_operator(op), m_left(left), m_right(right), m_kernel(
+				nullptr) {
 	assert(left != NULL);
 	assert(right != NULL);
 }
@@ -38,9 +39,9 @@ const_shared_ptr<TypeSpecifier> BinaryExpression::ComputeResultType(
 			execution_context);
 
 	const_shared_ptr<PrimitiveTypeSpecifier> left_as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(left_type);
+			specifier_cast<PrimitiveTypeSpecifier>(left_type);
 	const_shared_ptr<PrimitiveTypeSpecifier> right_as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(right_type);
+			specifier_cast<PrimitiveTypeSpecifier>(right_type);
 
 	if (left_as_primitive == nullptr || right_as_primitive == nullptr
 			|| left_as_primitive == PrimitiveTypeSpecifier::GetNone()
@@ -74,153 +75,59 @@ const_shared_ptr<TypeSpecifier> BinaryExpression::ComputeResultType(
 
 const_shared_ptr<Result> BinaryExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
-	ErrorListRef errors = ErrorList::GetTerminator();
-	const_shared_ptr<Expression> left = GetLeft();
-	const_shared_ptr<Expression> right = GetRight();
+	STATISTICS_COUNT(EXPRESSIONS, *this);
 
-	const_shared_ptr<Result> left_result = left->Evaluate(execution_context);
+	const_shared_ptr<Result> left_result = m_left->Evaluate(execution_context);
 	if (!ErrorList::IsTerminator(left_result->GetErrors())) {
 		return left_result;
 	}
 
-	const_shared_ptr<Result> right_result = right->Evaluate(execution_context);
+	const_shared_ptr<Result> right_result = m_right->Evaluate(
+			execution_context);
 	if (!ErrorList::IsTerminator(right_result->GetErrors())) {
 		return right_result;
 	}
 
-	const_shared_ptr<TypeSpecifier> left_type = left->GetType(
-			execution_context);
-	const_shared_ptr<TypeSpecifier> right_type = right->GetType(
-			execution_context);
+	if (!m_kernel) {
+		//not validated, so the operand types have to be looked up now
+		m_kernel = GetKernel(
+				GetOperandType(m_left->GetType(execution_context)),
+				GetOperandType(m_right->GetType(execution_context)));
+		assert(m_kernel);
+	}
 
-	yy::location left_position = left->GetPosition();
-	yy::location right_position = right->GetPosition();
-
-	if (left_type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
-		bool left_value = *(static_pointer_cast<const bool>(
-				left_result->GetData()));
-
-		if (right_type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
-			bool right_value = *(static_pointer_cast<const bool>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetInt())) {
-			int right_value = *(static_pointer_cast<const int>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetDouble())) {
-			double right_value = *(static_pointer_cast<const double>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetString())) {
-			string right_value = *(static_pointer_cast<const string>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else {
-			assert(false);
-		}
-	} else if (left_type->IsAssignableTo(PrimitiveTypeSpecifier::GetInt())) {
-		int left_value = *(static_pointer_cast<const int>(
-				left_result->GetData()));
-
-		if (right_type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
-			bool right_value = *(static_pointer_cast<const bool>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetInt())) {
-			int right_value = *(static_pointer_cast<const int>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetDouble())) {
-			double right_value = *(static_pointer_cast<const double>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetString())) {
-			string right_value = *(static_pointer_cast<const string>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else {
-			assert(false);
-		}
-	} else if (left_type->IsAssignableTo(PrimitiveTypeSpecifier::GetDouble())) {
-		double left_value = *(static_pointer_cast<const double>(
-				left_result->GetData()));
-
-		if (right_type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
-			bool right_value = *(static_pointer_cast<const bool>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetInt())) {
-			int right_value = *(static_pointer_cast<const int>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetDouble())) {
-			double right_value = *(static_pointer_cast<const double>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetString())) {
-			string right_value = *(static_pointer_cast<const string>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else {
-			assert(false);
-		}
-	} else if (left_type->IsAssignableTo(PrimitiveTypeSpecifier::GetString())) {
-		string left_value = *(static_pointer_cast<const string>(
-				left_result->GetData()));
-
-		if (right_type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
-			bool right_value = *(static_pointer_cast<const bool>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetInt())) {
-			int right_value = *(static_pointer_cast<const int>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetDouble())) {
-			double right_value = *(static_pointer_cast<const double>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else if (right_type->IsAssignableTo(
-				PrimitiveTypeSpecifier::GetString())) {
-			string right_value = *(static_pointer_cast<const string>(
-					right_result->GetData()));
-			return compute(left_value, right_value, left_position,
-					right_position);
-		} else {
-			assert(false);
-		}
-	} else {
-		assert(false);
+	return (this->*m_kernel)(left_result->GetData(), right_result->GetData());
+}
+
+const BinaryExpression::Kernel BinaryExpression::GetKernel(
+		const BasicType left, const BasicType right) const {
+	switch (left) {
+	case BOOLEAN:
+		return GetConversionKernel<bool>(right);
+	case INT:
+		return GetConversionKernel<int>(right);
+	case DOUBLE:
+		return GetConversionKernel<double>(right);
+	case STRING:
+		return GetConversionKernel<string>(right);
+	default:
+		return nullptr;
 	}
+}
 
-	return make_shared<Result>(const_shared_ptr<const void>(), errors);
+const BasicType BinaryExpression::GetOperandType(
+		const_shared_ptr<TypeSpecifier> type) {
+	if (type->IsAssignableTo(PrimitiveTypeSpecifier::GetBoolean())) {
+		return BOOLEAN;
+	} else if (type->IsAssignableTo(PrimitiveTypeSpecifier::GetInt())) {
+		return INT;
+	} else if (type->IsAssignableTo(PrimitiveTypeSpecifier::GetDouble())) {
+		return DOUBLE;
+	} else if (type->IsAssignableTo(PrimitiveTypeSpecifier::GetString())) {
+		return STRING;
+	} else {
+		return NONE;
+	}
 }
 
 const_shared_ptr<TypeSpecifier> BinaryExpression::GetType(
@@ -274,9 +181,21 @@ const ErrorListRef BinaryExpression::Validate(
 						operator_to_string(op)), result);
 	}
 
+	if (ErrorList::IsTerminator(result)) {
+		m_kernel = GetKernel(GetOperandType(left_type),
+				GetOperandType(right_type));
+	}
+
 	return result;
 }
 
+void BinaryExpression::Optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	//folding preserves the operand types, so the selected kernel remains valid
+	m_left = Expression::Fold(m_left, execution_context);
+	m_right = Expression::Fold(m_right, execution_context);
+}
+
 const_shared_ptr<Result> BinaryExpression::compute(const bool& left, const int& right,
 		yy::location left_position, yy::location right_position) const {
 	int converted_left = left;
@@ -20,6 +20,7 @@
 #ifndef BINARY_EXPRESSION_H_
 #define BINARY_EXPRESSION_H_
 
+#include <functional>
 #include "expression.h"
 
 class Error;
@@ -60,7 +61,49 @@ public:
 			const_shared_ptr<TypeSpecifier> valid_left,
 			const_shared_ptr<TypeSpecifier> valid_right) const;
 
+	virtual void Optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 protected:
+	/**
+	 * A computation specialized for the types of both operands.
+	 */
+	typedef const_shared_ptr<Result> (BinaryExpression::*Kernel)(
+			const Value& left, const Value& right) const;
+
+	/**
+	 * Select the kernel for the given operand types. The default kernels
+	 * convert the operands to a common type and dispatch to compute();
+	 * subclasses may override this to supply kernels that are specialized
+	 * for the operator as well.
+	 */
+	virtual const Kernel GetKernel(const BasicType left,
+			const BasicType right) const;
+
+	/**
+	 * Get a kernel that applies the given operation to a pair of int or double
+	 * operands in their common type, or nullptr for any other operand types.
+	 */
+	template<template<typename > class Operation> static const Kernel
+	GetNumericKernel(const BasicType left, const BasicType right) {
+		if (left == INT && right == INT) {
+			return &BinaryExpression::Apply<int, int, int, Operation<int> >;
+		} else if (left == INT && right == DOUBLE) {
+			return &BinaryExpression::Apply<double, int, double,
+					Operation<double> >;
+		} else if (left == DOUBLE && right == INT) {
+			return &BinaryExpression::Apply<double, double, int,
+					Operation<double> >;
+		} else if (left == DOUBLE && right == DOUBLE) {
+			return &BinaryExpression::Apply<double, double, double,
+					Operation<double> >;
+		} else {
+			return nullptr;
+		}
+	}
+
+	template<typename T> static const T GetOperand(const Value& value);
+
 	virtual const_shared_ptr<Result> compute(const bool& left,
 			const bool& right, yy::location left_position,
 			yy::location right_position) const = 0;
@@ -101,10 +144,66 @@ protected:
 			yy::location right_position) const = 0;
 
 private:
+	template<typename L> static const Kernel GetConversionKernel(
+			const BasicType right) {
+		switch (right) {
+		case BOOLEAN:
+			return &BinaryExpression::Compute<L, bool>;
+		case INT:
+			return &BinaryExpression::Compute<L, int>;
+		case DOUBLE:
+			return &BinaryExpression::Compute<L, double>;
+		case STRING:
+			return &BinaryExpression::Compute<L, string>;
+		default:
+			return nullptr;
+		}
+	}
+
+	template<typename L, typename R> const_shared_ptr<Result> Compute(
+			const Value& left, const Value& right) const {
+		return compute(GetOperand<L>(left), GetOperand<R>(right),
+				m_left->GetPosition(), m_right->GetPosition());
+	}
+
+	template<typename T, typename L, typename R, typename Operation>
+	const_shared_ptr<Result> Apply(const Value& left,
+			const Value& right) const {
+		const auto result = Operation()(static_cast<T>(GetOperand<L>(left)),
+				static_cast<T>(GetOperand<R>(right)));
+		return make_shared<Result>(Value(result), ErrorList::GetTerminator());
+	}
+
+	static const BasicType GetOperandType(
+			const_shared_ptr<TypeSpecifier> type);
+
 	const OperatorType m_operator;
-	const_shared_ptr<Expression> m_left;
-	const_shared_ptr<Expression> m_right;
+	//replaced by their folded forms on optimization
+	mutable plain_shared_ptr<Expression> m_left;
+	mutable plain_shared_ptr<Expression> m_right;
+	//selected once the operand types are known
+	mutable Kernel m_kernel;
 }
 ;
 
+template<> inline const bool BinaryExpression::GetOperand<bool>(
+		const Value& value) {
+	return value.GetBoolean();
+}
+
+template<> inline const int BinaryExpression::GetOperand<int>(
+		const Value& value) {
+	return value.GetInt();
+}
+
+template<> inline const double BinaryExpression::GetOperand<double>(
+		const Value& value) {
+	return value.GetDouble();
+}
+
+template<> inline const string BinaryExpression::GetOperand<string>(
+		const Value& value) {
+	return *(value.GetReference<string>());
+}
+
 #endif /* BINARY_EXPRESSION_H_ */
@@ -45,18 +45,49 @@ const ErrorListRef ComparisonExpression::Validate(
 			PrimitiveTypeSpecifier::GetString());
 }
 
+const BinaryExpression::Kernel ComparisonExpression::GetKernel(
+		const BasicType left, const BasicType right) const {
+	Kernel kernel = nullptr;
+	switch (GetOperator()) {
+	case EQUAL:
+		kernel = GetNumericKernel<std::equal_to>(left, right);
+		break;
+	case NOT_EQUAL:
+		kernel = GetNumericKernel<std::not_equal_to>(left, right);
+		break;
+	case LESS_THAN:
+		kernel = GetNumericKernel<std::less>(left, right);
+		break;
+	case LESS_THAN_EQUAL:
+		kernel = GetNumericKernel<std::less_equal>(left, right);
+		break;
+	case GREATER_THAN:
+		kernel = GetNumericKernel<std::greater>(left, right);
+		break;
+	case GREATER_THAN_EQUAL:
+		kernel = GetNumericKernel<std::greater_equal>(left, right);
+		break;
+	default:
+		break;
+	}
+
+	if (kernel) {
+		return kernel;
+	} else {
+		return BinaryExpression::GetKernel(left, right);
+	}
+}
+
 const_shared_ptr<Result> ComparisonExpression::compute(const bool& left,
 		const bool& right, yy::location left_position,
 		yy::location right_position) const {
 	switch (GetOperator()) {
 	case EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+		return make_shared<Result>(Value(left == right),
 				ErrorList::GetTerminator());
 		break;
 	case NOT_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+		return make_shared<Result>(Value(left != right),
 				ErrorList::GetTerminator());
 		break;
 	case LESS_THAN:
@@ -79,29 +110,23 @@ const_shared_ptr<Result> ComparisonExpression::compute(const int& left,
 		yy::location right_position) const {
 	switch (GetOperator()) {
 	case EQUAL: {
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+		return make_shared<Result>(Value(left == right),
 				ErrorList::GetTerminator());
 	}
 	case NOT_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+		return make_shared<Result>(Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+		return make_shared<Result>(Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+		return make_shared<Result>(Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+		return make_shared<Result>(Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+		return make_shared<Result>(Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -116,28 +141,22 @@ const_shared_ptr<Result> ComparisonExpression::compute(const double& left,
 		yy::location right_position) const {
 	switch (GetOperator()) {
 	case EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+		return make_shared<Result>(Value(left == right),
 				ErrorList::GetTerminator());
 	case NOT_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+		return make_shared<Result>(Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+		return make_shared<Result>(Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+		return make_shared<Result>(Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+		return make_shared<Result>(Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+		return make_shared<Result>(Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -152,28 +171,22 @@ const_shared_ptr<Result> ComparisonExpression::compute(const string& left,
 		yy::location right_position) const {
 	switch (GetOperator()) {
 	case EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left == right)),
+		return make_shared<Result>(Value(left == right),
 				ErrorList::GetTerminator());
 	case NOT_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left != right)),
+		return make_shared<Result>(Value(left != right),
 				ErrorList::GetTerminator());
 	case LESS_THAN:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left < right)),
+		return make_shared<Result>(Value(left < right),
 				ErrorList::GetTerminator());
 	case LESS_THAN_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left <= right)),
+		return make_shared<Result>(Value(left <= right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left > right)),
+		return make_shared<Result>(Value(left > right),
 				ErrorList::GetTerminator());
 	case GREATER_THAN_EQUAL:
-		return make_shared<Result>(
-				const_shared_ptr<const void>(new bool(left >= right)),
+		return make_shared<Result>(Value(left >= right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
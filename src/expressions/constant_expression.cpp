@@ -22,25 +22,25 @@
 ConstantExpression::ConstantExpression(const yy::location position,
 		const bool value) :
 		ConstantExpression(position, PrimitiveTypeSpecifier::GetBoolean(),
-				const_shared_ptr<void>(new bool(value))) {
+				Value(value)) {
 }
 
 ConstantExpression::ConstantExpression(const yy::location position,
 		const int value) :
 		ConstantExpression(position, PrimitiveTypeSpecifier::GetInt(),
-				const_shared_ptr<void>(new int(value))) {
+				Value(value)) {
 }
 
 ConstantExpression::ConstantExpression(const yy::location position,
 		const double value) :
 		ConstantExpression(position, PrimitiveTypeSpecifier::GetDouble(),
-				const_shared_ptr<void>(new double(value))) {
+				Value(value)) {
 }
 
 ConstantExpression::ConstantExpression(const yy::location position,
 		const_shared_ptr<string> value) :
 		ConstantExpression(position, PrimitiveTypeSpecifier::GetString(),
-				std::static_pointer_cast<const void>(value)) {
+				value) {
 }
 
 ConstantExpression::ConstantExpression(const ConstantExpression* other) :
@@ -57,6 +57,7 @@ const_shared_ptr<TypeSpecifier> ConstantExpression::GetType(
 
 const_shared_ptr<Result> ConstantExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
 	return make_shared<Result>(m_value, ErrorList::GetTerminator());
 }
 
@@ -71,11 +72,11 @@ const_shared_ptr<Result> ConstantExpression::GetConstantExpression(
 		const_shared_ptr<Expression> expression,
 		const shared_ptr<ExecutionContext> execution_context) {
 	const_shared_ptr<Result> evaluation = expression->Evaluate(execution_context);
-	plain_shared_ptr<void> result;
+	Value result;
 
 	auto errors = evaluation->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
-		result = const_shared_ptr<void>(
+		result = const_shared_ptr<ConstantExpression>(
 				new ConstantExpression(expression->GetPosition(),
 						expression->GetType(execution_context),
 						evaluation->GetData()));
@@ -85,7 +86,7 @@ const_shared_ptr<Result> ConstantExpression::GetConstantExpression(
 }
 
 ConstantExpression::ConstantExpression(const yy::location position,
-		const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value) :
+		const_shared_ptr<TypeSpecifier> type, const Value& value) :
 		Expression(position), m_type(type), m_value(value) {
 }
 
@@ -51,6 +51,14 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	const_shared_ptr<TypeSpecifier> GetTypeSpecifier() const {
+		return m_type;
+	}
+
+	const Value& GetValue() const {
+		return m_value;
+	}
+
 	static const_shared_ptr<Result> GetConstantExpression(
 			const_shared_ptr<Expression> expression,
 			const shared_ptr<ExecutionContext> execution_context);
@@ -58,9 +66,9 @@ public:
 private:
 	ConstantExpression(const yy::location position,
 			const_shared_ptr<TypeSpecifier> type,
-			const_shared_ptr<const void> value);
+			const Value& value);
 	const_shared_ptr<TypeSpecifier> m_type;
-	const_shared_ptr<void> m_value;
+	const Value m_value;
 };
 
 #endif /* EXPRESSIONS_CONSTANT_EXPRESSION_H_ */
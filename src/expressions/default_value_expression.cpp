@@ -44,11 +44,13 @@ const_shared_ptr<TypeSpecifier> DefaultValueExpression::GetType(
 
 const_shared_ptr<Result> DefaultValueExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
+
 	ErrorListRef errors = ErrorList::GetTerminator();
-	plain_shared_ptr<void> return_value;
+	Value return_value;
 
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(m_type);
+			specifier_cast<PrimitiveTypeSpecifier>(m_type);
 	if (as_primitive) {
 		if (as_primitive != PrimitiveTypeSpecifier::GetNone()) {
 			return_value = as_primitive->DefaultValue(
@@ -63,11 +65,12 @@ const_shared_ptr<Result> DefaultValueExpression::Evaluate(
 	}
 
 	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(m_type);
+			specifier_cast<CompoundTypeSpecifier>(m_type);
 	if (as_compound) {
-		const string type_name = as_compound->GetTypeName();
+		const string& type_name = as_compound->GetTypeName();
 		const_shared_ptr<CompoundType> type =
-				execution_context->GetTypeTable()->GetType(type_name);
+				execution_context->GetTypeTable()->GetType(
+						as_compound->GetTypeAtom());
 
 		if (type != CompoundType::GetDefaultCompoundType()) {
 			return_value = m_type->DefaultValue(
@@ -88,7 +91,7 @@ const ErrorListRef DefaultValueExpression::Validate(
 	ErrorListRef errors = ErrorList::GetTerminator();
 
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(m_type);
+			specifier_cast<PrimitiveTypeSpecifier>(m_type);
 	if (as_primitive) {
 		if (as_primitive == PrimitiveTypeSpecifier::GetNone()) {
 			errors = ErrorList::From(
@@ -100,11 +103,12 @@ const ErrorListRef DefaultValueExpression::Validate(
 	}
 
 	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(m_type);
+			specifier_cast<CompoundTypeSpecifier>(m_type);
 	if (as_compound) {
-		const string type_name = as_compound->GetTypeName();
+		const string& type_name = as_compound->GetTypeName();
 		const_shared_ptr<CompoundType> type =
-				execution_context->GetTypeTable()->GetType(type_name);
+				execution_context->GetTypeTable()->GetType(
+						as_compound->GetTypeAtom());
 
 		if (type == CompoundType::GetDefaultCompoundType()) {
 			errors = ErrorList::From(
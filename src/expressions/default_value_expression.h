@@ -45,6 +45,14 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	const_shared_ptr<TypeSpecifier> GetTypeSpecifier() const {
+		return m_type;
+	}
+
+	const yy::location GetTypePosition() const {
+		return m_type_position;
+	}
+
 private:
 	const_shared_ptr<TypeSpecifier> m_type;
 	const yy::location m_type_position;
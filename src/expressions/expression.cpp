@@ -23,6 +23,7 @@
 #include "variable.h"
 #include "utils.h"
 #include <execution_context.h>
+#include <constant_expression.h>
 
 Expression::Expression(const yy::location position) :
 		m_position(position) {
@@ -41,22 +42,22 @@ const_shared_ptr<Result> Expression::ToString(
 		auto value = evaluation->GetData();
 
 		const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-				std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+				specifier_cast<PrimitiveTypeSpecifier>(
 						type_specifier);
 		if (as_primitive) {
 			const BasicType basic_type = as_primitive->GetBasicType();
 			switch (basic_type) {
 			case BOOLEAN:
-				buffer << *(static_pointer_cast<const bool>(value));
+				buffer << value.GetBoolean();
 				break;
 			case INT:
-				buffer << *(static_pointer_cast<const int>(value));
+				buffer << value.GetInt();
 				break;
 			case DOUBLE:
-				buffer << *(static_pointer_cast<const double>(value));
+				buffer << value.GetDouble();
 				break;
 			case STRING:
-				buffer << *(static_pointer_cast<const string>(value));
+				buffer << *(value.GetReference<string>());
 				break;
 			default:
 				assert(false);
@@ -66,11 +67,10 @@ const_shared_ptr<Result> Expression::ToString(
 		//TODO: array printing
 
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						type_specifier);
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					value);
+			auto instance = value.GetReference<CompoundTypeInstance>();
 
 			buffer << "{" << endl;
 			buffer
@@ -87,3 +87,43 @@ const_shared_ptr<Result> Expression::ToString(
 	return make_shared<Result>(const_shared_ptr<void>(new string(buffer.str())),
 			ErrorList::GetTerminator());
 }
+
+const_shared_ptr<Expression> Expression::Fold(
+		const_shared_ptr<Expression> expression,
+		const shared_ptr<ExecutionContext> execution_context) {
+	if (!expression) {
+		return expression;
+	}
+
+	if (expression->IsConstant()
+			&& !std::dynamic_pointer_cast<const ConstantExpression>(
+					expression)
+			&& specifier_cast<PrimitiveTypeSpecifier>(
+					expression->GetType(execution_context))) {
+		auto result = ConstantExpression::GetConstantExpression(expression,
+				execution_context);
+		if (ErrorList::IsTerminator(result->GetErrors())) {
+			return result->GetData().GetReference<ConstantExpression>();
+		}
+
+		//computations that fail (e.g. division by zero) are left in place,
+		//so that their errors are raised at run time
+		return expression;
+	}
+
+	expression->Optimize(execution_context);
+	return expression;
+}
+
+ArgumentListRef Expression::Fold(ArgumentListRef argument_list,
+		const shared_ptr<ExecutionContext> execution_context) {
+	ArgumentListRef result = ArgumentList::GetTerminator();
+	auto subject = argument_list;
+	while (!ArgumentList::IsTerminator(subject)) {
+		result = ArgumentList::From(Fold(subject->GetData(), execution_context),
+				result);
+		subject = subject->GetNext();
+	}
+
+	return ArgumentList::Reverse(result);
+}
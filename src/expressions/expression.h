@@ -31,6 +31,10 @@
 #include <error.h>
 
 class ExecutionContext;
+class Expression;
+
+typedef const LinkedList<const Expression, NO_DUPLICATES> ArgumentList;
+typedef shared_ptr<ArgumentList> ArgumentListRef;
 
 class Expression {
 public:
@@ -55,11 +59,30 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const = 0;
 
+	/**
+	 * Fold the constant sub-expressions of this expression in place.
+	 * Only valid once the expression has been validated without errors.
+	 */
+	virtual void Optimize(
+			const shared_ptr<ExecutionContext> execution_context) const {
+	}
+
+	/**
+	 * Optimize an expression. Returns a constant expression to be used in its
+	 * place if it is a constant primitive computation, or else the expression.
+	 */
+	static const_shared_ptr<Expression> Fold(
+			const_shared_ptr<Expression> expression,
+			const shared_ptr<ExecutionContext> execution_context);
+
+	/**
+	 * Optimize each expression in an argument list, returning the new list.
+	 */
+	static ArgumentListRef Fold(ArgumentListRef argument_list,
+			const shared_ptr<ExecutionContext> execution_context);
+
 private:
 	const yy::location m_position;
 };
 
-typedef const LinkedList<const Expression, NO_DUPLICATES> ArgumentList;
-typedef shared_ptr<ArgumentList> ArgumentListRef;
-
 #endif /* EXPRESSION_H_ */
@@ -26,11 +26,14 @@
 #include <declaration_statement.h>
 #include <inferred_declaration_statement.h>
 #include <symbol_table.h>
+#include <frame_layout.h>
+#include <cycle_collector.h>
 
 FunctionExpression::FunctionExpression(const yy::location position,
 		const_shared_ptr<FunctionDeclaration> declaration,
 		const_shared_ptr<StatementBlock> body) :
-		Expression(position), m_declaration(declaration), m_body(body) {
+		Expression(position), m_declaration(declaration), m_body(body), m_layout(
+				nullptr) {
 }
 
 FunctionExpression::~FunctionExpression() {
@@ -43,14 +46,18 @@ const_shared_ptr<TypeSpecifier> FunctionExpression::GetType(
 
 const_shared_ptr<Result> FunctionExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
+
 	ErrorListRef errors = ErrorList::GetTerminator();
 	shared_ptr<const Function> function;
 	if (execution_context->GetLifeTime() == PERSISTENT) {
 		function = make_shared<Function>(m_declaration, m_body,
-				weak_ptr<ExecutionContext>(execution_context));
+				weak_ptr<ExecutionContext>(execution_context), m_layout);
 	} else {
 		function = make_shared<Function>(m_declaration, m_body,
-				execution_context);
+				execution_context, m_layout);
+		//the closure may in turn be held by the context it closes over
+		CycleCollector::GetInstance().Track(execution_context);
 	}
 
 	return make_shared<Result>(function, errors);
@@ -71,6 +78,7 @@ const ErrorListRef FunctionExpression::Validate(
 			Modifier::Type::NONE, new_parent, execution_context->GetTypeTable(),
 			execution_context->GetLifeTime());
 
+	bool parameters_declared = true;
 	DeclarationListRef declaration = m_declaration->GetParameterList();
 	while (!DeclarationList::IsTerminator(declaration)) {
 		auto declaration_statement = declaration->GetData();
@@ -112,6 +120,10 @@ const ErrorListRef FunctionExpression::Validate(
 			errors = ErrorList::Concatenate(errors, parameter_errors);
 		}
 
+		if (!ErrorList::IsTerminator(parameter_errors)) {
+			parameters_declared = false;
+		}
+
 		declaration = declaration->GetNext();
 	}
 
@@ -122,8 +134,18 @@ const ErrorListRef FunctionExpression::Validate(
 		errors = ErrorList::Concatenate(errors,
 				m_body->GetReturnStatementErrors(m_declaration->GetReturnType(),
 						tmp_context));
+
+		if (ErrorList::IsTerminator(errors) && parameters_declared) {
+			//the validation context now holds the declared parameters and locals,
+			//which is exactly the frame that each invocation needs
+			m_layout = make_shared<FrameLayout>(tmp_context);
+		}
 	}
 
 	return errors;
 }
 
+void FunctionExpression::Optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_body->optimize(execution_context);
+}
@@ -23,6 +23,7 @@
 #include <expression.h>
 
 class FunctionDeclaration;
+class FrameLayout;
 class StatementBlock;
 
 class FunctionExpression: public Expression {
@@ -43,9 +44,22 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual void Optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
+	const_shared_ptr<FunctionDeclaration> GetDeclaration() const {
+		return m_declaration;
+	}
+
+	const_shared_ptr<StatementBlock> GetBody() const {
+		return m_body;
+	}
+
 private:
 	const_shared_ptr<FunctionDeclaration> m_declaration;
 	const_shared_ptr<StatementBlock> m_body;
+	//captured on successful validation, and shared by the functions this expression evaluates to
+	mutable plain_shared_ptr<FrameLayout> m_layout;
 };
 
 #endif /* EXPRESSIONS_FUNCTION_EXPRESSION_H_ */
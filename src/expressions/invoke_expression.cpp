@@ -24,12 +24,16 @@
 #include <function.h>
 #include <execution_context.h>
 #include <defaults.h>
+#include <variable_expression.h>
+#include <variable.h>
+#include <profiler.h>
 
 InvokeExpression::InvokeExpression(const yy::location position,
 		const_shared_ptr<Expression> expression, ArgumentListRef argument_list,
 		const yy::location argument_list_position) :
 		Expression(position), m_expression(expression), m_argument_list(
-				argument_list), m_argument_list_position(argument_list_position) {
+				argument_list), m_argument_list_position(argument_list_position), m_function_name(
+				GetFunctionName(expression)) {
 }
 
 InvokeExpression::~InvokeExpression() {
@@ -40,7 +44,7 @@ const_shared_ptr<TypeSpecifier> InvokeExpression::GetType(
 	const_shared_ptr<TypeSpecifier> type_specifier = m_expression->GetType(
 			execution_context);
 	const_shared_ptr<FunctionTypeSpecifier> as_function =
-			std::dynamic_pointer_cast<const FunctionTypeSpecifier>(
+			specifier_cast<FunctionTypeSpecifier>(
 					type_specifier);
 
 	if (as_function) {
@@ -52,13 +56,15 @@ const_shared_ptr<TypeSpecifier> InvokeExpression::GetType(
 
 const_shared_ptr<Result> InvokeExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
+
 	ErrorListRef errors = ErrorList::GetTerminator();
-	plain_shared_ptr<void> value;
+	Value value;
 
 	const_shared_ptr<TypeSpecifier> type_specifier = m_expression->GetType(
 			execution_context);
 	const_shared_ptr<FunctionTypeSpecifier> as_function =
-			std::dynamic_pointer_cast<const FunctionTypeSpecifier>(
+			specifier_cast<FunctionTypeSpecifier>(
 					type_specifier);
 
 	if (as_function) {
@@ -67,9 +73,10 @@ const_shared_ptr<Result> InvokeExpression::Evaluate(
 
 		errors = expression_result->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto function = static_pointer_cast<const Function>(
-					expression_result->GetData());
+			auto function =
+					expression_result->GetData().GetReference<Function>();
 
+			ProfiledCall call(*m_function_name, GetPosition().begin.line);
 			const_shared_ptr<Result> eval_result = function->Evaluate(
 					m_argument_list, execution_context);
 
@@ -96,8 +103,7 @@ const_shared_ptr<Result> InvokeExpression::ToString(
 
 	if (expression_result->GetErrors()) {
 		buf
-				<< *(static_pointer_cast<const string>(
-						expression_result->GetData()));
+				<< *(expression_result->GetData().GetReference<string>());
 		buf << "(";
 		ErrorListRef errors =
 
@@ -110,8 +116,7 @@ const_shared_ptr<Result> InvokeExpression::ToString(
 					argument_result->GetErrors());
 			if (ErrorList::IsTerminator(errors)) {
 				buf
-						<< *(static_pointer_cast<const string>(
-								argument_result->GetData()));
+						<< *(argument_result->GetData().GetReference<string>());
 				if (!ArgumentList::IsTerminator(argument->GetNext())) {
 					buf << ",";
 				}
@@ -136,7 +141,7 @@ const ErrorListRef InvokeExpression::Validate(
 
 	if (ErrorList::IsTerminator(errors)) {
 		const_shared_ptr<FunctionTypeSpecifier> as_function =
-				std::dynamic_pointer_cast<const FunctionTypeSpecifier>(
+				specifier_cast<FunctionTypeSpecifier>(
 						type_specifier);
 
 		if (as_function) {
@@ -267,3 +272,23 @@ const ErrorListRef InvokeExpression::Validate(
 
 	return errors;
 }
+
+void InvokeExpression::Optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_expression = Expression::Fold(m_expression, execution_context);
+	m_argument_list = Expression::Fold(m_argument_list, execution_context);
+}
+
+const_shared_ptr<string> InvokeExpression::GetFunctionName(
+		const_shared_ptr<Expression> expression) {
+	const static const_shared_ptr<string> anonymous = make_shared<string>(
+			"<anonymous>");
+
+	auto as_variable = dynamic_pointer_cast<const VariableExpression>(
+			expression);
+	if (as_variable) {
+		return as_variable->GetVariable()->GetName();
+	} else {
+		return anonymous;
+	}
+}
@@ -46,6 +46,9 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual void Optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	const_shared_ptr<Expression> GetExpression() const {
 		return m_expression;
 	}
@@ -58,10 +61,25 @@ public:
 		return m_argument_list_position;
 	}
 
+	/**
+	 * The name of the function being invoked, as reported by the profiler.
+	 */
+	const string& GetFunctionName() const {
+		return *m_function_name;
+	}
+
+	/**
+	 * Name the function that a call of the given expression invokes: the name of
+	 * the variable that holds it, if the expression is a variable.
+	 */
+	static const_shared_ptr<string> GetFunctionName(
+			const_shared_ptr<Expression> expression);
+
 private:
-	const_shared_ptr<Expression> m_expression;
-	ArgumentListRef m_argument_list;
+	mutable plain_shared_ptr<Expression> m_expression;
+	mutable ArgumentListRef m_argument_list;
 	const yy::location m_argument_list_position;
+	const_shared_ptr<string> m_function_name;
 };
 
 #endif /* STATEMENTS_INVOKE_STATEMENT_H_ */
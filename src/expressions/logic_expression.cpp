@@ -39,17 +39,49 @@ const ErrorListRef LogicExpression::Validate(
 			PrimitiveTypeSpecifier::GetDouble());
 }
 
+const_shared_ptr<Result> LogicExpression::Evaluate(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
+
+	static const_shared_ptr<Result> true_result = make_immortal(
+			new Result(Value(true), ErrorList::GetTerminator()));
+	static const_shared_ptr<Result> false_result = make_immortal(
+			new Result(Value(false), ErrorList::GetTerminator()));
+
+	const_shared_ptr<Result> left_result = GetLeft()->Evaluate(
+			execution_context);
+	if (!ErrorList::IsTerminator(left_result->GetErrors())) {
+		return left_result;
+	}
+
+	const bool left = IsTrue(left_result->GetData());
+	if (GetOperator() == OR ? left : !left) {
+		return left ? true_result : false_result;
+	}
+
+	const_shared_ptr<Result> right_result = GetRight()->Evaluate(
+			execution_context);
+	if (!ErrorList::IsTerminator(right_result->GetErrors())) {
+		return right_result;
+	}
+
+	return IsTrue(right_result->GetData()) ? true_result : false_result;
+}
+
+const bool LogicExpression::IsTrue(const Value& value) {
+	return value.GetKind() == Value::DOUBLE ?
+			value.GetDouble() != 0 : value.GetInt() != 0;
+}
+
 const_shared_ptr<Result> LogicExpression::compute(const bool& left,
 		const bool& right, yy::location left_position,
 		yy::location right_position) const {
 	switch (GetOperator()) {
 	case OR:
-		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left || right)),
+		return make_shared<Result>(Value(left || right),
 				ErrorList::GetTerminator());
 	case AND:
-		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left && right)),
+		return make_shared<Result>(Value(left && right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
@@ -63,13 +95,11 @@ const_shared_ptr<Result> LogicExpression::compute(const int& left,
 	switch (GetOperator()) {
 	case OR: {
 		bool result = left || right;
-		return make_shared<Result>(const_shared_ptr<void>(new bool(result)),
-				ErrorList::GetTerminator());
+		return make_shared<Result>(Value(result), ErrorList::GetTerminator());
 	}
 	case AND: {
 		bool result = left && right;
-		return make_shared<Result>(const_shared_ptr<void>(new bool(result)),
-				ErrorList::GetTerminator());
+		return make_shared<Result>(Value(result), ErrorList::GetTerminator());
 	}
 	default:
 		assert(false);
@@ -82,12 +112,10 @@ const_shared_ptr<Result> LogicExpression::compute(const double& left,
 		yy::location right_position) const {
 	switch (GetOperator()) {
 	case OR:
-		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left || right)),
+		return make_shared<Result>(Value(left || right),
 				ErrorList::GetTerminator());
 	case AND:
-		return make_shared<Result>(
-				const_shared_ptr<void>(new bool(left && right)),
+		return make_shared<Result>(Value(left && right),
 				ErrorList::GetTerminator());
 	default:
 		assert(false);
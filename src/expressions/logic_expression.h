@@ -34,6 +34,12 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	/**
+	 * Evaluate the right operand only if the left doesn't decide the result.
+	 */
+	virtual const_shared_ptr<Result> Evaluate(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 protected:
 	virtual const_shared_ptr<Result> compute(const bool& left,
 			const bool& right, yy::location left_position,
@@ -46,5 +52,8 @@ protected:
 	virtual const_shared_ptr<Result> compute(const string& left,
 			const string& right, yy::location left_position,
 			yy::location right_position) const;
+
+private:
+	static const bool IsTrue(const Value& value);
 };
 #endif /* LOGIC_EXPRESSION_H_ */
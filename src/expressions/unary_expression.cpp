@@ -77,8 +77,10 @@ const ErrorListRef UnaryExpression::Validate(
 
 const_shared_ptr<Result> UnaryExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
+
 	ErrorListRef errors = ErrorList::GetTerminator();
-	void* result = nullptr;
+	Value result;
 
 	const_shared_ptr<TypeSpecifier> expression_type = m_expression->GetType(
 			execution_context);
@@ -94,14 +96,10 @@ const_shared_ptr<Result> UnaryExpression::Evaluate(
 		case UNARY_MINUS: {
 			if (expression_type->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetInt())) {
-				int* value = new int;
-				*value = -(*(static_pointer_cast<const int>(data)));
-				result = (void *) value;
+				result = Value(-data.GetInt());
 			} else if (expression_type->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetDouble())) {
-				double* value = new double;
-				*value = -(*(static_pointer_cast<const double>(data)));
-				result = (void *) value;
+				result = Value(-data.GetDouble());
 			} else {
 				assert(false);
 			}
@@ -110,20 +108,17 @@ const_shared_ptr<Result> UnaryExpression::Evaluate(
 		case NOT: {
 			if (expression_type->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetBoolean())) {
-				bool old_value = *(static_pointer_cast<const bool>(data));
-				bool* value = new bool(!old_value);
-				result = (void *) value;
+				bool old_value = data.GetBoolean();
+				result = Value(!old_value);
 			} else if (expression_type->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetInt())) {
-				int old_value = *(static_pointer_cast<const int>(data));
-				bool* value = new bool(!(old_value != 0));
-				result = (void *) value;
+				int old_value = data.GetInt();
+				result = Value(!(old_value != 0));
 				break;
 			} else if (expression_type->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetDouble())) {
-				double old_value = *(static_pointer_cast<const double>(data));
-				bool* value = new bool(!(old_value != 0));
-				result = (void *) value;
+				double old_value = data.GetDouble();
+				result = Value(!(old_value != 0));
 				break;
 			} else {
 				assert(false);
@@ -136,6 +131,10 @@ const_shared_ptr<Result> UnaryExpression::Evaluate(
 		}
 	}
 
-	return make_shared<Result>(const_shared_ptr<void>(result), errors);
+	return make_shared<Result>(result, errors);
 }
 
+void UnaryExpression::Optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_expression = Expression::Fold(m_expression, execution_context);
+}
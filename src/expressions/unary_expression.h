@@ -40,10 +40,21 @@ public:
 	virtual const ErrorListRef Validate(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
+	const OperatorType GetOperator() const {
+		return m_operator;
+	}
+
+	virtual void Optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 private:
 	static const_shared_ptr<TypeSpecifier> compute_result_type(
 			const_shared_ptr<TypeSpecifier> input_type, const OperatorType op);
-	const_shared_ptr<Expression> m_expression;
+	mutable plain_shared_ptr<Expression> m_expression;
 	const OperatorType m_operator;
 };
 
@@ -39,6 +39,7 @@ const_shared_ptr<TypeSpecifier> VariableExpression::GetType(
 
 const_shared_ptr<Result> VariableExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
 	return m_variable->Evaluate(execution_context);
 }
 
@@ -32,7 +32,16 @@ WithExpression::WithExpression(const yy::location position,
 		const yy::location member_instantiation_list_position) :
 		Expression(position), m_source_expression(source_expression), m_member_instantiation_list(
 				member_instantiation_list), m_member_instantiation_list_position(
-				member_instantiation_list_position) {
+				member_instantiation_list_position), m_member_variables() {
+	MemberInstantiationListRef subject = m_member_instantiation_list;
+	while (!MemberInstantiationList::IsTerminator(subject)) {
+		const_shared_ptr<MemberInstantiation> instantiation =
+				subject->GetData();
+		m_member_variables.push_back(
+				make_shared<BasicVariable>(instantiation->GetName(),
+						instantiation->GetNamePosition()));
+		subject = subject->GetNext();
+	}
 }
 
 WithExpression::~WithExpression() {
@@ -45,32 +54,35 @@ const_shared_ptr<TypeSpecifier> WithExpression::GetType(
 
 const_shared_ptr<Result> WithExpression::Evaluate(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	STATISTICS_COUNT(EXPRESSIONS, *this);
+
 	ErrorListRef errors(ErrorList::GetTerminator());
 	const_shared_ptr<Result> source_result = m_source_expression->Evaluate(
 			execution_context);
 
 	errors = source_result->GetErrors();
 	if (errors == ErrorList::GetTerminator()) {
-		plain_shared_ptr<void> new_value;
+		Value new_value;
 		const_shared_ptr<TypeSpecifier> type_specifier =
 				m_source_expression->GetType(execution_context);
 
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						type_specifier);
 		if (as_compound) {
-			const string type_name = as_compound->GetTypeName();
 			const_shared_ptr<CompoundType> type =
-					execution_context->GetTypeTable()->GetType(type_name);
+					execution_context->GetTypeTable()->GetType(
+							as_compound->GetTypeAtom());
 
 			if (type != CompoundType::GetDefaultCompoundType()) {
 				auto raw_result = source_result->GetData();
-				auto as_compound = static_pointer_cast<
-						const CompoundTypeInstance>(raw_result);
+				auto as_compound =
+						raw_result.GetReference<CompoundTypeInstance>();
 				const_shared_ptr<SymbolContext> definition =
 						as_compound->GetDefinition();
 
-				//create a new context that isn't read-only and has no parent
+				//create a new context that isn't read-only and has no parent.
+				//it shares its members with the source until they're set
 				volatile_shared_ptr<SymbolContext> new_symbol_context =
 						definition->Clone()->WithModifiers(
 								Modifier::Type(
@@ -81,19 +93,18 @@ const_shared_ptr<Result> WithExpression::Evaluate(
 						execution_context->WithContents(new_symbol_context);
 
 				MemberInstantiationListRef subject = m_member_instantiation_list;
+				auto variable = m_member_variables.begin();
 				while (!MemberInstantiationList::IsTerminator(subject)) {
 					const_shared_ptr<MemberInstantiation> instantiation =
 							subject->GetData();
 
-					auto variable = make_shared<BasicVariable>(
-							instantiation->GetName(),
-							instantiation->GetNamePosition());
 					errors = ErrorList::Concatenate(errors,
-							variable->AssignValue(execution_context,
+							(*variable)->AssignValue(execution_context,
 									instantiation->GetExpression(),
 									temp_execution_context, ASSIGN));
 
 					subject = subject->GetNext();
+					++variable;
 				}
 
 				new_symbol_context = new_symbol_context->WithModifiers(
@@ -108,7 +119,7 @@ const_shared_ptr<Result> WithExpression::Evaluate(
 								Error::UNDECLARED_TYPE,
 								m_source_expression->GetPosition().begin.line,
 								m_source_expression->GetPosition().begin.column,
-								type_name), errors);
+								as_compound->GetTypeName()), errors);
 			}
 		} else {
 			errors = ErrorList::From(
@@ -150,7 +161,7 @@ const ErrorListRef WithExpression::Validate(
 				m_source_expression->GetType(execution_context);
 
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						type_specifier);
 		if (as_compound) {
 			const string type_name = as_compound->GetTypeName();
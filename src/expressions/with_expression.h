@@ -20,9 +20,12 @@
 #ifndef EXPRESSIONS_WITH_EXPRESSION_H_
 #define EXPRESSIONS_WITH_EXPRESSION_H_
 
+#include <vector>
 #include <expression.h>
 #include <member_instantiation.h>
 
+class BasicVariable;
+
 class WithExpression: public Expression {
 public:
 	WithExpression(const yy::location position, const_shared_ptr<Expression> source_expression,
@@ -57,6 +60,8 @@ private:
 	const_shared_ptr<Expression> m_source_expression;
 	MemberInstantiationListRef m_member_instantiation_list;
 	const yy::location m_member_instantiation_list_position;
+	//the members being set, in instantiation order
+	std::vector<plain_shared_ptr<BasicVariable>> m_member_variables;
 };
 
 #endif /* EXPRESSIONS_WITH_EXPRESSION_H_ */
@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frame_layout.h>
+#include <compound_type_instance.h>
+#include <compound_type_specifier.h>
+#include <type_table.h>
+#include <frame_pool.h>
+
+FrameLayout::FrameLayout(const shared_ptr<ExecutionContext> context) :
+		m_symbols(context->CopyTable()), m_instance_slots() {
+	for (size_t slot = 0; slot < m_symbols->GetSize(); slot++) {
+		auto as_compound = specifier_cast<CompoundTypeSpecifier>(
+				m_symbols->GetSymbol(slot)->GetType());
+		if (as_compound) {
+			m_instance_slots.push_back(instance_slot(slot, as_compound));
+		}
+	}
+}
+
+FrameLayout::~FrameLayout() {
+}
+
+const shared_ptr<ExecutionContext> FrameLayout::CreateExecutionContext(
+		const SymbolContextListRef parent_context,
+		volatile_shared_ptr<TypeTable> type_table,
+		const LifeTime life_time) const {
+	auto symbols = allocate_shared<SymbolMap>(FrameAllocator<SymbolMap>(),
+			*m_symbols);
+	for (auto iter = m_instance_slots.begin(); iter != m_instance_slots.end();
+			++iter) {
+		auto instance = iter->second->DefaultValue(*type_table).GetReference<
+				CompoundTypeInstance>();
+		symbols->SetSymbol(iter->first, make_shared<Symbol>(instance));
+	}
+
+	return allocate_shared<ExecutionContext>(FrameAllocator<ExecutionContext>(),
+			Modifier::NONE, symbols, parent_context, type_table, life_time);
+}
@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_LAYOUT_H_
+#define FRAME_LAYOUT_H_
+
+#include <vector>
+#include <defaults.h>
+#include <execution_context.h>
+
+class CompoundTypeSpecifier;
+
+/**
+ * The layout of a function's call frame: its parameters and locals, declared and
+ * set to their default values, in the slots that the function body resolves them to.
+ *
+ * A layout is captured once, when the function expression is validated, so that an
+ * invocation only has to copy it and bind its arguments instead of re-analyzing
+ * the parameter declarations and the function body.
+ */
+class FrameLayout {
+public:
+	FrameLayout(const shared_ptr<ExecutionContext> context);
+	virtual ~FrameLayout();
+
+	/**
+	 * Create a new frame with this layout.
+	 */
+	const shared_ptr<ExecutionContext> CreateExecutionContext(
+			const SymbolContextListRef parent_context,
+			volatile_shared_ptr<TypeTable> type_table,
+			const LifeTime life_time) const;
+
+private:
+	typedef std::pair<size_t, const_shared_ptr<CompoundTypeSpecifier>>
+			instance_slot;
+
+	const_shared_ptr<SymbolMap> m_symbols;
+	//struct instances are mutable, so they cannot be shared between frames
+	std::vector<instance_slot> m_instance_slots;
+};
+
+#endif /* FRAME_LAYOUT_H_ */
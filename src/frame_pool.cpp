@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frame_pool.h>
+
+FramePool::FramePool() :
+		m_free(), m_free_count(), m_allocated_size(0), m_peak_allocated_size(
+				0) {
+}
+
+FramePool::~FramePool() {
+	for (size_t size_class = 0; size_class < SIZE_CLASSES; size_class++) {
+		Block* block = m_free[size_class];
+		while (block) {
+			Block* next = block->next;
+			::operator delete(block);
+			block = next;
+		}
+	}
+}
+
+namespace {
+//trivially destructible, so that it stays valid while its thread exits
+thread_local FramePool* thread_pool = nullptr;
+
+struct PoolReleaser {
+	~PoolReleaser() {
+		delete thread_pool;
+		thread_pool = nullptr;
+	}
+};
+}
+
+FramePool& FramePool::GetInstance() {
+	if (!thread_pool) {
+		thread_pool = new FramePool();
+
+		//frames released after the thread's pool is destroyed (for example, by
+		//the destructors of statics) get a new pool, which is never destroyed
+		static thread_local PoolReleaser releaser;
+	}
+	return *thread_pool;
+}
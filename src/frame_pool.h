@@ -0,0 +1,178 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_POOL_H_
+#define FRAME_POOL_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * A pool of the memory blocks that make up the frames of function invocations,
+ * along with the other short-lived contexts of a program.
+ *
+ * Such contexts are allocated and released at a high rate in a nearly stack-like
+ * order, and they are reference counted, so a frame that escapes (for example,
+ * into a closure) simply remains allocated until its last reference is released.
+ * Released blocks are kept on a free list for their size class and handed out
+ * again in last-in, first-out order, so a call usually reuses the memory of the
+ * frame of the previous call.
+ *
+ * Each thread has a pool of its own, so allocation takes no lock. The blocks
+ * themselves come from the global heap, so a frame may be released on a thread
+ * other than the one that allocated it; its block then joins the free list of
+ * the releasing thread.
+ */
+class FramePool {
+public:
+	FramePool();
+	virtual ~FramePool();
+
+	void* Allocate(const size_t size) {
+		m_allocated_size += size;
+		if (m_allocated_size > m_peak_allocated_size) {
+			m_peak_allocated_size = m_allocated_size;
+		}
+
+		const size_t size_class = GetSizeClass(size);
+		if (size_class < SIZE_CLASSES) {
+			Block* block = m_free[size_class];
+			if (block) {
+				m_free[size_class] = block->next;
+				m_free_count[size_class]--;
+				return block;
+			}
+
+			return ::operator new((size_class + 1) * GRANULARITY);
+		}
+
+		return ::operator new(size);
+	}
+
+	void Deallocate(void* pointer, const size_t size) {
+		//a block allocated on another thread was never counted here
+		m_allocated_size -= size < m_allocated_size ? size : m_allocated_size;
+
+		const size_t size_class = GetSizeClass(size);
+		if (size_class < SIZE_CLASSES
+				&& m_free_count[size_class] < MAX_FREE_BLOCKS) {
+			Block* block = static_cast<Block*>(pointer);
+			block->next = m_free[size_class];
+			m_free[size_class] = block;
+			m_free_count[size_class]++;
+		} else {
+			::operator delete(pointer);
+		}
+	}
+
+	/**
+	 * The number of bytes currently allocated from the pool. The figure is only
+	 * exact for frames released on the thread that allocated them: a frame
+	 * released on another thread stays counted by the pool that allocated it,
+	 * and the releasing pool's count stops at zero.
+	 */
+	const size_t GetAllocatedSize() const {
+		return m_allocated_size;
+	}
+
+	const size_t GetPeakAllocatedSize() const {
+		return m_peak_allocated_size;
+	}
+
+	static FramePool& GetInstance();
+
+private:
+	FramePool(const FramePool& other) = delete;
+	FramePool& operator=(const FramePool& other) = delete;
+
+	struct Block {
+		Block* next;
+	};
+
+	static const size_t GetSizeClass(const size_t size) {
+		return (size - 1) / GRANULARITY;
+	}
+
+	static const size_t GRANULARITY = 16;
+	static const size_t SIZE_CLASSES = 16;
+
+#ifdef __SANITIZE_ADDRESS__
+	//recycled blocks would hide uses of released frames from the sanitizer
+	static const size_t MAX_FREE_BLOCKS = 0;
+#else
+	//bounds the memory held by the pool after a burst of deep recursion
+	static const size_t MAX_FREE_BLOCKS = 4096;
+#endif
+
+	Block* m_free[SIZE_CLASSES];
+	size_t m_free_count[SIZE_CLASSES];
+	size_t m_allocated_size;
+	size_t m_peak_allocated_size;
+};
+
+/**
+ * A standard allocator backed by the frame pool.
+ */
+template<typename T> class FrameAllocator {
+public:
+	typedef T value_type;
+
+	template<typename U> struct rebind {
+		typedef FrameAllocator<U> other;
+	};
+
+	FrameAllocator() {
+	}
+
+	template<typename U> FrameAllocator(const FrameAllocator<U>& other) {
+	}
+
+	T* allocate(const size_t count) {
+		return static_cast<T*>(FramePool::GetInstance().Allocate(
+				count * sizeof(T)));
+	}
+
+	void deallocate(T* pointer, const size_t count) {
+		FramePool::GetInstance().Deallocate(pointer, count * sizeof(T));
+	}
+
+	//constructing through the allocator lets friend classes
+	//keep their constructors private
+	template<typename U, typename ... Args> void construct(U* pointer,
+			Args&&... args) {
+		::new ((void*) pointer) U(std::forward<Args>(args)...);
+	}
+
+	template<typename U> void destroy(U* pointer) {
+		pointer->~U();
+	}
+
+	template<typename U> const bool operator==(
+			const FrameAllocator<U>& other) const {
+		return true;
+	}
+
+	template<typename U> const bool operator!=(
+			const FrameAllocator<U>& other) const {
+		return false;
+	}
+};
+
+#endif /* FRAME_POOL_H_ */
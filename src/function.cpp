@@ -28,37 +28,80 @@
 #include <defaults.h>
 #include <sum_type_specifier.h>
 #include <sum.h>
+#include <frame_layout.h>
+#include <frame_pool.h>
+#include <cycle_collector.h>
+#include <profiler.h>
 
 Function::Function(const_shared_ptr<FunctionDeclaration> declaration,
 		const_shared_ptr<StatementBlock> body,
-		const shared_ptr<ExecutionContext> closure) :
+		const shared_ptr<ExecutionContext> closure,
+		const_shared_ptr<FrameLayout> layout) :
 		m_declaration(declaration), m_body(body), m_closure(closure), m_weak_closure(
-				shared_ptr<ExecutionContext>(nullptr)) {
+				shared_ptr<ExecutionContext>(nullptr)), m_layout(layout) {
 }
 
 Function::Function(const_shared_ptr<FunctionDeclaration> declaration,
 		const_shared_ptr<StatementBlock> body,
-		const weak_ptr<ExecutionContext> weak_closure) :
+		const weak_ptr<ExecutionContext> weak_closure,
+		const_shared_ptr<FrameLayout> layout) :
 		m_declaration(declaration), m_body(body), m_closure(nullptr), m_weak_closure(
-				weak_closure) {
+				weak_closure), m_layout(layout) {
 }
 
 Function::~Function() {
 }
 
+void Function::Trace(Tracer& tracer) const {
+	//a weak closure is owned elsewhere
+	tracer.Visit(m_closure);
+}
+
 const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 		const shared_ptr<ExecutionContext> invocation_context) const {
-	ErrorListRef errors = ErrorList::GetTerminator();
+	const Function* function = this;
+	plain_shared_ptr<Function> tail_function;
+	shared_ptr<ExecutionContext> caller_context = invocation_context;
 
-	auto closure_reference = GetClosureReference();
+	//each tail call replaces the frame of the function that made it
+	while (true) {
+		TailCall tail_call;
+		shared_ptr<ExecutionContext> final_execution_context;
+		auto errors = function->Execute(argument_list, caller_context,
+				tail_call, final_execution_context);
+		if (!final_execution_context) {
+			return make_shared<Result>(Value(), errors);
+		}
 
-	assert(closure_reference);
+		if (!ErrorList::IsTerminator(errors) || !tail_call.function) {
+			return make_shared<Result>(
+					function->GetReturnValue(final_execution_context), errors);
+		}
+
+		//the frame is the context in which the call's arguments are evaluated.
+		//it stays alive while the called function runs and is released when
+		//the next tail call replaces it, so at most one previous frame is kept
+		final_execution_context->SetReturnValue(nullptr);
+		tail_function = tail_call.function;
+		function = tail_function.get();
+		argument_list = tail_call.arguments;
+		caller_context = final_execution_context;
 
-	auto parent_context = SymbolContextList::From(invocation_context,
-			invocation_context->GetParent());
-	shared_ptr<ExecutionContext> function_execution_context = make_shared<
-			ExecutionContext>(Modifier::NONE, parent_context,
-			closure_reference->GetTypeTable(), EPHEMERAL);
+		Profiler* profiler = Profiler::GetActive();
+		if (profiler) {
+			profiler->Rename(*tail_call.name);
+		}
+	}
+}
+
+const ErrorListRef Function::Execute(ArgumentListRef argument_list,
+		const shared_ptr<ExecutionContext> invocation_context,
+		TailCall& tail_call,
+		shared_ptr<ExecutionContext>& final_execution_context) const {
+	ErrorListRef errors = ErrorList::GetTerminator();
+
+	shared_ptr<ExecutionContext> function_execution_context =
+			CreateExecutionContext(invocation_context);
 
 	//populate evaluation context with results of argument evaluation
 	ArgumentListRef argument = argument_list;
@@ -78,14 +121,18 @@ const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 				//it's tempting to just stuff a value into the symbol table,
 				//but this simplistic approach ignores widening conversions
 				auto evaluated_expression =
-						static_pointer_cast<const Expression>(
-								argument_evaluation->GetData());
+						argument_evaluation->GetData().GetReference<
+								Expression>();
 				const DeclarationStatement* argument_declaration =
 						declaration->WithInitializerExpression(
 								evaluated_expression);
 
-				auto preprocessing_errors = ErrorList::Concatenate(errors,
-						declaration->preprocess(function_execution_context));
+				auto preprocessing_errors = errors;
+				if (!m_layout) {
+					preprocessing_errors = ErrorList::Concatenate(errors,
+							declaration->preprocess(
+									function_execution_context));
+				}
 				if (ErrorList::IsTerminator(preprocessing_errors)) {
 					errors = ErrorList::Concatenate(errors,
 							argument_declaration->execute(
@@ -114,16 +161,93 @@ const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 		}
 	}
 
+	errors = ErrorList::Concatenate(errors,
+			BindDefaultParameters(parameter, function_execution_context,
+					invocation_context));
+
+	//TODO: determine if it is necessary to merge type tables
+
+	if (ErrorList::IsTerminator(errors)) {
+		auto context = GetFinalExecutionContext(function_execution_context);
+		errors = PreprocessBody(context);
+		if (ErrorList::IsTerminator(errors)) {
+			tail_call.return_type = m_declaration->GetReturnType();
+			context->SetTailCall(&tail_call);
+			errors = m_body->execute(context);
+			context->SetTailCall(nullptr);
+			final_execution_context = context;
+		}
+	}
+
+	return errors;
+}
+
+const shared_ptr<ExecutionContext> Function::CreateExecutionContext(
+		const shared_ptr<ExecutionContext> invocation_context) const {
+	auto closure_reference = GetClosureReference();
+
+	assert(closure_reference);
+
+	if (m_layout) {
+		//arguments are evaluated before they are bound and the parameters are
+		//already declared, so the frame can be a child of the closure at once
+		auto parent_context = SymbolContextList::From(closure_reference,
+				closure_reference->GetParent());
+		return m_layout->CreateExecutionContext(parent_context,
+				closure_reference->GetTypeTable(), EPHEMERAL);
+	} else {
+		auto parent_context = SymbolContextList::From(invocation_context,
+				invocation_context->GetParent());
+		return allocate_shared<ExecutionContext>(
+				FrameAllocator<ExecutionContext>(), Modifier::NONE,
+				parent_context, closure_reference->GetTypeTable(), EPHEMERAL);
+	}
+}
+
+const bool Function::BindArgument(const size_t index,
+		const_shared_ptr<DeclarationStatement> parameter,
+		const_shared_ptr<Symbol> value,
+		const shared_ptr<ExecutionContext> function_execution_context) const {
+	if (m_layout) {
+		//parameters are declared first, so they occupy the leading slots
+		SymbolReference reference;
+		reference.depth = 0;
+		reference.slot = index;
+		return function_execution_context->SetSymbol(parameter->GetNameAtom(),
+				reference, value->GetType(), value->GetValue()) == SET_SUCCESS;
+	} else {
+		return function_execution_context->InsertSymbol(
+				parameter->GetNameAtom(), value) == INSERT_SUCCESS;
+	}
+}
+
+const ErrorListRef Function::BindDefaultParameters(DeclarationListRef parameter,
+		const shared_ptr<ExecutionContext> function_execution_context,
+		const shared_ptr<ExecutionContext> invocation_context) const {
+	ErrorListRef errors = ErrorList::GetTerminator();
+
+	//default values are evaluated in the invoking context, as arguments are.
+	//a frame with a layout is a child of the closure, so defaults are bound
+	//through a view of its table that is a child of the invoking context
+	shared_ptr<ExecutionContext> default_context = function_execution_context;
+	if (m_layout && !DeclarationList::IsTerminator(parameter)) {
+		default_context = function_execution_context->WithParent(
+				SymbolContextList::From(invocation_context,
+						invocation_context->GetParent()));
+	}
+
 	//handle any remaining parameter declarations. if any parameter declarations don't have default values, generate an error
 	while (!DeclarationList::IsTerminator(parameter)) {
 		const_shared_ptr<DeclarationStatement> declaration =
 				parameter->GetData();
 
 		if (declaration->GetInitializerExpression()) {
+			if (!m_layout) {
+				errors = ErrorList::Concatenate(errors,
+						declaration->preprocess(default_context));
+			}
 			errors = ErrorList::Concatenate(errors,
-					declaration->preprocess(function_execution_context));
-			errors = ErrorList::Concatenate(errors,
-					declaration->execute(function_execution_context));
+					declaration->execute(default_context));
 			parameter = parameter->GetNext();
 		} else {
 			errors = ErrorList::From(
@@ -136,46 +260,50 @@ const_shared_ptr<Result> Function::Evaluate(ArgumentListRef argument_list,
 		}
 	}
 
+	return errors;
+}
+
+const shared_ptr<ExecutionContext> Function::GetFinalExecutionContext(
+		const shared_ptr<ExecutionContext> function_execution_context) const {
+	if (m_layout) {
+		return function_execution_context;
+	}
+
 	//juggle the references so the evaluation context is a child of the closure context
-	parent_context = SymbolContextList::From(closure_reference,
+	auto closure_reference = GetClosureReference();
+	auto parent_context = SymbolContextList::From(closure_reference,
 			closure_reference->GetParent());
-	auto final_execution_context = function_execution_context->WithParent(
-			parent_context);
+	return function_execution_context->WithParent(parent_context);
+}
 
-	//TODO: determine if it is necessary to merge type tables
+const ErrorListRef Function::PreprocessBody(
+		const shared_ptr<ExecutionContext> final_execution_context) const {
+	if (m_layout) {
+		return ErrorList::GetTerminator();
+	} else {
+		return m_body->preprocess(final_execution_context);
+	}
+}
 
-	if (ErrorList::IsTerminator(errors)) {
-		//performing preprocessing here duplicates work with the function express processing,
-		//but the context setup in the function preprocessing is currently discarded.
-		//TODO: consider cloning function expression preprocess context instead of discarding it
-		errors = ErrorList::Concatenate(errors,
-				m_body->preprocess(final_execution_context));
-		if (ErrorList::IsTerminator(errors)) {
-			errors = ErrorList::Concatenate(errors,
-					m_body->execute(final_execution_context));
-			plain_shared_ptr<Symbol> evaluation_result =
-					final_execution_context->GetReturnValue();
-			final_execution_context->SetReturnValue(nullptr); //clear return value to avoid reference cycles
-
-			plain_shared_ptr<void> result = evaluation_result->GetValue();
-			auto as_sum = dynamic_pointer_cast<const SumTypeSpecifier>(
-					m_declaration->GetReturnType());
-			if (as_sum) {
-				auto evaluation_result_type = evaluation_result->GetType();
-				if (as_sum != evaluation_result_type) {
-					//we're returning a narrower type than the return type; perform boxing
-					result = make_shared<Sum>(as_sum, evaluation_result_type,
-							evaluation_result->GetValue());
-				}
-			}
+const Value Function::GetReturnValue(
+		const shared_ptr<ExecutionContext> final_execution_context) const {
+	plain_shared_ptr<Symbol> evaluation_result =
+			final_execution_context->GetReturnValue();
+	final_execution_context->SetReturnValue(nullptr); //clear return value to avoid reference cycles
 
-			return make_shared<Result>(result, errors);
-		} else {
-			return make_shared<Result>(nullptr, errors);
+	Value result = evaluation_result->GetValue();
+	auto as_sum = specifier_cast<SumTypeSpecifier>(
+			m_declaration->GetReturnType());
+	if (as_sum) {
+		auto evaluation_result_type = evaluation_result->GetType();
+		if (as_sum != evaluation_result_type) {
+			//we're returning a narrower type than the return type; perform boxing
+			result = make_shared<Sum>(as_sum, evaluation_result_type,
+					evaluation_result->GetValue());
 		}
-	} else {
-		return make_shared<Result>(nullptr, errors);
 	}
+
+	return result;
 }
 
 const string Function::ToString(const TypeTable& type_table,
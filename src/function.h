@@ -21,21 +21,44 @@
 #define FUNCTION_H_
 
 #include <expression.h>
+#include <declaration_statement.h>
 
 class FunctionDeclaration;
+class FrameLayout;
 class StatementBlock;
 class Result;
 class ExecutionContext;
+class Tracer;
+
+/**
+ * A call in return position. Rather than being made by the return statement, it is
+ * left for the invoker of the enclosing function to make once the frame of that
+ * function has been discarded, so that a chain of such calls runs in constant space.
+ */
+struct TailCall {
+	//the return type of the function whose frame the call would replace
+	plain_shared_ptr<TypeSpecifier> return_type;
+
+	plain_shared_ptr<Function> function;
+
+	//evaluated in the frame that made the call
+	ArgumentListRef arguments;
+
+	//the name of the function for the profiler, owned by the call's expression
+	const string* name;
+};
 
 class Function {
 public:
 	Function(const_shared_ptr<FunctionDeclaration> declaration,
 			const_shared_ptr<StatementBlock> body,
-			const shared_ptr<ExecutionContext> closure);
+			const shared_ptr<ExecutionContext> closure,
+			const_shared_ptr<FrameLayout> layout = nullptr);
 
 	Function(const_shared_ptr<FunctionDeclaration> declaration,
 			const_shared_ptr<StatementBlock> body,
-			const weak_ptr<ExecutionContext> weak_closure);
+			const weak_ptr<ExecutionContext> weak_closure,
+			const_shared_ptr<FrameLayout> layout = nullptr);
 
 	virtual ~Function();
 
@@ -49,17 +72,76 @@ public:
 	const string ToString(const TypeTable& type_table,
 			const Indent indent) const;
 
+	void Trace(Tracer& tracer) const;
+
 	const_shared_ptr<StatementBlock> GetBody() const {
 		return m_body;
 	}
 
+	/**
+	 * Create the context into which the arguments of an invocation are bound.
+	 * If the function has a frame layout, the context already holds its parameters.
+	 * Frames are drawn from the frame pool.
+	 */
+	const shared_ptr<ExecutionContext> CreateExecutionContext(
+			const shared_ptr<ExecutionContext> invocation_context) const;
+
+	/**
+	 * Bind the value of the parameter at the given index in a context created by
+	 * CreateExecutionContext. Returns false if the parameter was already bound.
+	 */
+	const bool BindArgument(const size_t index,
+			const_shared_ptr<DeclarationStatement> parameter,
+			const_shared_ptr<Symbol> value,
+			const shared_ptr<ExecutionContext> function_execution_context) const;
+
+	/**
+	 * Bind the default values of the given parameter and all parameters that follow it.
+	 * The default values are evaluated in the invoking context.
+	 */
+	const ErrorListRef BindDefaultParameters(DeclarationListRef parameter,
+			const shared_ptr<ExecutionContext> function_execution_context,
+			const shared_ptr<ExecutionContext> invocation_context) const;
+
+	/**
+	 * Re-parent a context of bound arguments to the function's closure, yielding the context
+	 * in which the body is executed. A frame with a layout is already a child of the
+	 * closure, so it is returned as is.
+	 */
+	const shared_ptr<ExecutionContext> GetFinalExecutionContext(
+			const shared_ptr<ExecutionContext> function_execution_context) const;
+
+	/**
+	 * Analyze the body in the context in which it is to be executed. This is only
+	 * necessary for functions without a frame layout.
+	 */
+	const ErrorListRef PreprocessBody(
+			const shared_ptr<ExecutionContext> final_execution_context) const;
+
+	/**
+	 * Collect the return value of an executed body, boxing it if the return type is a sum.
+	 */
+	const Value GetReturnValue(
+			const shared_ptr<ExecutionContext> final_execution_context) const;
+
 private:
+	/**
+	 * Bind the arguments of an invocation and execute the body. If the body was
+	 * executed, the context it was executed in is stored in final_execution_context;
+	 * a call that it made in return position is stored in tail_call.
+	 */
+	const ErrorListRef Execute(ArgumentListRef argument_list,
+			const shared_ptr<ExecutionContext> invocation_context,
+			TailCall& tail_call,
+			shared_ptr<ExecutionContext>& final_execution_context) const;
+
 	const shared_ptr<ExecutionContext> GetClosureReference() const;
 
 	const_shared_ptr<FunctionDeclaration> m_declaration;
 	const_shared_ptr<StatementBlock> m_body;
 	const shared_ptr<ExecutionContext> m_closure;
 	const weak_ptr<ExecutionContext> m_weak_closure;
+	const_shared_ptr<FrameLayout> m_layout;
 };
 
 #endif /* FUNCTION_H_ */
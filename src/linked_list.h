@@ -30,9 +30,19 @@ enum ListDuplicatePolicy {
 	NO_DUPLICATES = 0, ALLOW_DUPLICATES = 1
 };
 
+template<typename T> class ArenaAllocator;
+
 template<class T, ListDuplicatePolicy duplicate_policy> class LinkedList {
 public:
 	virtual ~LinkedList() {
+		//release the cells that only this list refers to iteratively, so
+		//that destroying a long list (such as the statements of a large
+		//script) does not recurse once per cell
+		shared_ptr<const LinkedList<T, duplicate_policy>> next = std::move(
+				m_next);
+		while (next && next.use_count() == 1) {
+			next = std::move(next->m_next);
+		}
 	}
 
 	const shared_ptr<T> GetData() const {
@@ -56,6 +66,18 @@ public:
 				new const LinkedList<T, duplicate_policy>(data, next));
 	}
 
+	/**
+	 * Prepend to a list, allocating the new cell with the given allocator.
+	 */
+	template<typename Allocator> static const shared_ptr<
+			const LinkedList<T, duplicate_policy>> From(
+			const shared_ptr<T> data,
+			const shared_ptr<const LinkedList<T, duplicate_policy>> next,
+			const Allocator& allocator) {
+		return std::allocate_shared<const LinkedList<T, duplicate_policy>>(
+				allocator, data, next);
+	}
+
 	static const shared_ptr<const LinkedList<T, duplicate_policy>> Concatenate(
 			const shared_ptr<const LinkedList<T, duplicate_policy>> base,
 			const shared_ptr<const LinkedList<T, duplicate_policy>> continuation) {
@@ -105,6 +127,21 @@ public:
 		return new_next;
 	}
 
+	template<typename Allocator> static const shared_ptr<
+			const LinkedList<T, duplicate_policy>> Reverse(
+			const shared_ptr<const LinkedList<T, duplicate_policy>> subject,
+			const Allocator& allocator) {
+		shared_ptr<const LinkedList<T, duplicate_policy>> iter = subject;
+		shared_ptr<const LinkedList<T, duplicate_policy>> new_next =
+				GetTerminator();
+		while (!IsTerminator(iter)) {
+			new_next = From(iter->GetData(), new_next, allocator);
+			iter = iter->GetNext();
+		}
+
+		return new_next;
+	}
+
 	static const bool IsTerminator(
 			const shared_ptr<const LinkedList<T, duplicate_policy>> subject) {
 		return subject == GetTerminator();
@@ -116,6 +153,8 @@ public:
 	}
 
 private:
+	template<typename U> friend class ArenaAllocator;
+
 	LinkedList(const shared_ptr<T> data) :
 			LinkedList(data, GetTerminator()) {
 	}
@@ -137,7 +176,8 @@ private:
 	}
 
 	const shared_ptr<T> m_data;
-	const shared_ptr<const LinkedList<T, duplicate_policy>> m_next;
+	//mutable only so that the destructor can unlink it
+	mutable shared_ptr<const LinkedList<T, duplicate_policy>> m_next;
 };
 
 #endif /* LINKED_LIST_H_ */
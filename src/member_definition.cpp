@@ -23,6 +23,6 @@
 const_shared_ptr<MemberDefinition> MemberDefinition::GetDefaultMemberDefinition() {
 	const static std::shared_ptr<MemberDefinition> instance = std::make_shared
 			< MemberDefinition
-			> (MemberDefinition(PrimitiveTypeSpecifier::GetNone(), nullptr));
+			> (MemberDefinition(PrimitiveTypeSpecifier::GetNone(), Value()));
 	return instance;
 }
@@ -25,11 +25,12 @@
 #include <compound_type_specifier.h>
 #include <primitive_type_specifier.h>
 #include <type_specifier.h>
+#include <value.h>
 
 class MemberDefinition {
 public:
 	MemberDefinition(const_shared_ptr<TypeSpecifier> type,
-			const_shared_ptr<void> value) :
+			const Value& value) :
 			m_type(type), m_value(value) {
 	}
 	virtual ~MemberDefinition() {
@@ -39,7 +40,7 @@ public:
 		return m_type;
 	}
 
-	const_shared_ptr<void> GetDefaultValue() const {
+	const Value& GetDefaultValue() const {
 		return m_value;
 	}
 
@@ -47,15 +48,15 @@ public:
 			const Indent& indent) const {
 		ostringstream buffer;
 		const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-				std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(m_type);
+				specifier_cast<PrimitiveTypeSpecifier>(m_type);
 		if (as_primitive) {
 			buffer << as_primitive->ToString(m_value);
 		}
 
 		const_shared_ptr<ArrayTypeSpecifier> as_array =
-				std::dynamic_pointer_cast<const ArrayTypeSpecifier>(m_type);
+				specifier_cast<ArrayTypeSpecifier>(m_type);
 		if (as_array) {
-			auto array = static_pointer_cast<const Array>(m_value);
+			auto array = m_value.GetReference<Array>();
 			if (array->GetSize() > 0) {
 				buffer << endl;
 				buffer << array->ToString(type_table, indent);
@@ -65,11 +66,11 @@ public:
 		}
 
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(m_type);
+				specifier_cast<CompoundTypeSpecifier>(m_type);
 		if (as_compound) {
 			buffer << endl;
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					m_value);
+			auto instance = m_value.GetReference<
+					CompoundTypeInstance>();
 			buffer << instance->ToString(type_table, indent + 1);
 			buffer << indent;
 		}
@@ -82,7 +83,7 @@ public:
 
 private:
 	const_shared_ptr<TypeSpecifier> m_type;
-	const_shared_ptr<void> m_value;
+	const Value m_value;
 };
 
 #endif /* MEMBER_DEFINITION_H_ */
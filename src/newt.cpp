@@ -17,6 +17,7 @@
  along with newt.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fstream>
 #include <iostream>
 #include <string.h>
 #include <memory>
@@ -25,7 +26,15 @@
 #include "symbol_table.h"
 #include "type_table.h"
 
+#include "allocation_counter.h"
+#include "benchmark.h"
+#include "cycle_collector.h"
 #include "driver.h"
+#include "performance_counters.h"
+#include "profiler.h"
+#include "program_cache.h"
+#include "statistics.h"
+#include "virtual_machine.h"
 
 using namespace std;
 
@@ -39,6 +48,8 @@ int get_exit_code(bool debug, int exit_code) {
 }
 
 int main(int argc, char *argv[]) {
+	Benchmark::SetAllocationHook(AllocationCounter::GetCount);
+
 	if (argc < 2) {
 		cerr << "Input script must be specified." << endl;
 		return 1;
@@ -46,6 +57,17 @@ int main(int argc, char *argv[]) {
 
 	bool debug = false;
 	TRACE trace = NO_TRACE;
+	bool use_virtual_machine = false;
+	bool optimize = true;
+	bool parse_only = false;
+	int bench_iterations = 0;
+	bool gc_stats = false;
+	bool stats = false;
+	bool perf_counters = false;
+	const char* perf_counters_file_name = nullptr;
+	const char* profile_file_name = nullptr;
+	bool use_cache = false;
+	string cache_directory;
 	for (int i = 1; i < argc - 1; i++) {
 		if (strcmp(argv[i], "--debug") == 0) {
 			debug = true;
@@ -58,16 +80,113 @@ int main(int argc, char *argv[]) {
 		if (strcmp(argv[i], "--trace-parsing") == 0) {
 			trace = TRACE(trace | PARSING);
 		}
+
+		if (strcmp(argv[i], "--no-opt") == 0) {
+			optimize = false;
+		}
+
+		if (strcmp(argv[i], "--parse-only") == 0) {
+			parse_only = true;
+		}
+
+		if (strcmp(argv[i], "--gc-stats") == 0) {
+			gc_stats = true;
+		}
+
+		if (strcmp(argv[i], "--stats") == 0) {
+			if (!Statistics::IsEnabled()) {
+				cerr << "Statistics are not available; rebuild with "
+						<< "-DNEWT_STATS to enable them." << endl;
+				return EXIT_FAILURE;
+			}
+			stats = true;
+		}
+
+		if (strcmp(argv[i], "--perf-counters") == 0) {
+			perf_counters = true;
+		}
+
+		if (strncmp(argv[i], "--perf-counters=", 16) == 0) {
+			perf_counters = true;
+			perf_counters_file_name = argv[i] + 16;
+		}
+
+		if (strncmp(argv[i], "--profile=", 10) == 0) {
+			profile_file_name = argv[i] + 10;
+			if (*profile_file_name == '\0') {
+				cerr << "A profile output file must be specified." << endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (strcmp(argv[i], "--cache") == 0) {
+			use_cache = true;
+		}
+
+		if (strncmp(argv[i], "--cache-dir=", 12) == 0) {
+			use_cache = true;
+			cache_directory = argv[i] + 12;
+			if (cache_directory.empty()) {
+				cerr << "A cache directory must be specified." << endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (strncmp(argv[i], "--bench=", 8) == 0) {
+			bench_iterations = atoi(argv[i] + 8);
+			if (bench_iterations <= 0) {
+				cerr << "Invalid benchmark iteration count '" << argv[i] + 8
+						<< "'." << endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		if (strncmp(argv[i], "--engine=", 9) == 0) {
+			const char* engine = argv[i] + 9;
+			if (strcmp(engine, "vm") == 0) {
+				use_virtual_machine = true;
+			} else if (strcmp(engine, "ast") == 0) {
+				use_virtual_machine = false;
+			} else {
+				cerr << "Unknown engine '" << engine
+						<< "'; expected 'ast' or 'vm'." << endl;
+				return 1;
+			}
+		}
 	}
 
 	char* filename = argv[argc - 1];
 
+	if (bench_iterations > 0) {
+		return Benchmark(filename, bench_iterations, use_virtual_machine,
+				optimize, use_cache, cache_directory).Run(cout);
+	}
+
 	if (debug) {
 		cout << "Parsing file " << filename << "..." << endl;
 	}
 
+	unique_ptr<PerformanceCounters> counters(
+			perf_counters ? new PerformanceCounters() : nullptr);
+
+	unique_ptr<ProgramCache> cache(
+			use_cache ? new ProgramCache(filename, cache_directory) : nullptr);
+
 	Driver driver;
-	int parse_result = driver.parse(filename, trace);
+	if (counters) {
+		counters->Begin("parse");
+	}
+	const bool cached = cache && cache->Load(driver);
+	int parse_result = cached ? 0 : driver.parse(filename, trace);
+	if (counters) {
+		counters->End();
+	}
+
+	if (cache && !cached && parse_result == 0
+			&& driver.GetErrorCount() == 0) {
+		//failing to store the tree only costs the next run a parse
+		cache->Store(*driver.GetStatementBlock());
+	}
 
 	if (parse_result != 0 || driver.GetErrorCount() != 0) {
 		if (debug) {
@@ -82,28 +201,80 @@ int main(int argc, char *argv[]) {
 		return get_exit_code(debug, EXIT_FAILURE);
 	}
 
+	if (parse_only) {
+		if (debug) {
+			cout << "Parsed file " << filename << " ("
+					<< driver.GetArena().GetAllocatedSize()
+					<< " bytes of syntax tree)." << endl;
+		}
+		return EXIT_SUCCESS;
+	}
+
 	int exit_code = EXIT_SUCCESS;
 
 	if (parse_result == 0) {
 		auto main_statement_block = driver.GetStatementBlock();
 		shared_ptr<ExecutionContext> root_context =
 				make_shared<ExecutionContext>();
+		if (counters) {
+			counters->Begin("preprocess");
+		}
 		ErrorListRef semantic_errors = main_statement_block->preprocess(
 				root_context);
+		if (counters) {
+			counters->End();
+		}
 
 		if (ErrorList::IsTerminator(semantic_errors)) {
 			if (debug) {
 				cout << "Parsed file " << filename << "." << endl;
 			}
 
-			ErrorListRef execution_errors = main_statement_block->execute(
-					root_context);
+			if (optimize) {
+				if (counters) {
+					counters->Begin("optimize");
+				}
+				main_statement_block->optimize(root_context);
+				if (counters) {
+					counters->End();
+				}
+			}
+
+			Profiler profiler(filename);
+			if (profile_file_name && !profiler.Start()) {
+				cerr << "Unable to start the profiler." << endl;
+				return EXIT_FAILURE;
+			}
+
+			if (counters) {
+				counters->Begin("execute");
+			}
+			ErrorListRef execution_errors;
+			if (use_virtual_machine) {
+				VirtualMachine virtual_machine;
+				execution_errors = virtual_machine.Execute(
+						*main_statement_block, root_context);
+			} else {
+				execution_errors = main_statement_block->execute(root_context);
+			}
+			if (counters) {
+				counters->End();
+			}
 
-			bool has_execution_errors = false;
-			while (!ErrorList::IsTerminator(execution_errors)) {
-				has_execution_errors = true;
-				cerr << execution_errors->GetData()->ToString() << endl;
-				execution_errors = execution_errors->GetNext();
+			if (profile_file_name) {
+				profiler.Stop();
+				if (!profiler.Write(profile_file_name)) {
+					cerr << "Unable to write profile to '" << profile_file_name
+							<< "'." << endl;
+				}
+			}
+
+			bool has_execution_errors = !ErrorList::IsTerminator(
+					execution_errors);
+			if (has_execution_errors) {
+				for (auto error : *execution_errors) {
+					cerr << error->ToString() << endl;
+				}
 			}
 
 			if (debug) {
@@ -121,18 +292,39 @@ int main(int argc, char *argv[]) {
 				exit_code = *root_context->GetExitCode();
 			}
 
+			//reclaim the cycles left over once the program's state is released,
+			//while the syntax tree they refer to still exists
+			root_context = nullptr;
+			CycleCollector::GetInstance().Collect();
+			if (gc_stats) {
+				CycleCollector::GetInstance().PrintStatistics(cerr);
+			}
+
+			if (stats) {
+				Statistics::Print(cerr);
+			}
+
+			if (counters) {
+				counters->Print(cerr);
+				if (perf_counters_file_name) {
+					ofstream json(perf_counters_file_name);
+					counters->WriteJson(json, filename);
+					if (!json) {
+						cerr << "Unable to write performance counters to '"
+								<< perf_counters_file_name << "'." << endl;
+					}
+				}
+			}
+
 			return get_exit_code(debug,
 					has_execution_errors ? EXIT_FAILURE : exit_code);
 		} else {
 			//reverse linked list of errors, which comes to us in reverse order
 			semantic_errors = ErrorList::Reverse(semantic_errors);
 
-			int semantic_error_count = 0;
-			ErrorListRef error = semantic_errors;
-			while (!ErrorList::IsTerminator(error)) {
-				semantic_error_count++;
-				cerr << *(error->GetData()) << endl;
-				error = error->GetNext();
+			int semantic_error_count = semantic_errors->GetSize();
+			for (auto error : *semantic_errors) {
+				cerr << *error << endl;
 			}
 
 			if (debug) {
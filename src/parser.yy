@@ -55,10 +55,11 @@
 #include <sum_type_specifier.h>
 
 class Driver;
+typedef void* yyscan_t;
 
 }
 
-%param { Driver& driver }
+%param { Driver& driver } { yyscan_t scanner }
 
 %code {
 #include <iostream>
@@ -263,7 +264,7 @@ program:
 	{
 		//statement list comes in reverse order
 		//wrap in StatementListRef because Reverse is a LinkedList<T> function
-		plain_shared_ptr<StatementBlock> main_statement_block = make_shared<const StatementBlock>(StatementList::Reverse($1), @1);
+		plain_shared_ptr<StatementBlock> main_statement_block = driver.Create<const StatementBlock>(StatementList::Reverse($1, driver.GetAllocator()), @1);
 		driver.SetStatementBlock(main_statement_block);
 	}
 	;
@@ -272,7 +273,7 @@ program:
 variable_declaration:
 	IDENTIFIER COLON primitive_type_specifier optional_initializer
 	{
-		$$ = make_shared<PrimitiveDeclarationStatement>(@$, $3, @3, $1, @1, $4);
+		$$ = driver.Create<PrimitiveDeclarationStatement>(@$, $3, @3, $1, @1, $4);
 	}
 	| IDENTIFIER COLON primitive_type_specifier dimensions optional_initializer
 	{
@@ -280,42 +281,42 @@ variable_declaration:
 		//add dimensions to type specifier
 		DimensionListRef dimension = $4;
 		while (!DimensionList::IsTerminator(dimension)) {
-			type_specifier = make_shared<ArrayTypeSpecifier>(type_specifier);
+			type_specifier = ArrayTypeSpecifier::Get(type_specifier);
 			dimension = dimension->GetNext();
 		}
 
-		const_shared_ptr<ArrayTypeSpecifier> array_type_specifier = std::dynamic_pointer_cast<const ArrayTypeSpecifier>(type_specifier);
-		$$ = make_shared<ArrayDeclarationStatement>(@$, array_type_specifier, @3, $1, @1, $5);
+		const_shared_ptr<ArrayTypeSpecifier> array_type_specifier = specifier_cast<ArrayTypeSpecifier>(type_specifier);
+		$$ = driver.Create<ArrayDeclarationStatement>(@$, array_type_specifier, @3, $1, @1, $5);
 	}
 	| IDENTIFIER COLON IDENTIFIER dimensions optional_initializer
 	{
-		plain_shared_ptr<TypeSpecifier> type_specifier = make_shared<CompoundTypeSpecifier>(*$3);
+		plain_shared_ptr<TypeSpecifier> type_specifier = CompoundTypeSpecifier::Get(*$3);
 		//add dimensions to type specifier
 		DimensionListRef dimension = $4;
 		while (!DimensionList::IsTerminator(dimension)) {
-			type_specifier = make_shared<ArrayTypeSpecifier>(type_specifier);
+			type_specifier = ArrayTypeSpecifier::Get(type_specifier);
 			dimension = dimension->GetNext();
 		}
 
-		const_shared_ptr<ArrayTypeSpecifier> array_type_specifier = std::dynamic_pointer_cast<const ArrayTypeSpecifier>(type_specifier);
-		$$ = make_shared<ArrayDeclarationStatement>(@$, array_type_specifier, @3, $1, @1, $5);
+		const_shared_ptr<ArrayTypeSpecifier> array_type_specifier = specifier_cast<ArrayTypeSpecifier>(type_specifier);
+		$$ = driver.Create<ArrayDeclarationStatement>(@$, array_type_specifier, @3, $1, @1, $5);
 	}
 	| IDENTIFIER COLON IDENTIFIER optional_initializer
 	{
-		auto type_specifier = make_shared<CompoundTypeSpecifier>(*$3);
-		$$ = make_shared<StructInstantiationStatement>(@$, type_specifier, @3, $1, @1, $4);
+		auto type_specifier = CompoundTypeSpecifier::Get(*$3);
+		$$ = driver.Create<StructInstantiationStatement>(@$, type_specifier, @3, $1, @1, $4);
 	}
 	| IDENTIFIER COLON function_type_specifier optional_initializer
 	{
-		$$ = make_shared<FunctionDeclarationStatement>(@$, $3, @3, $1, @1, $4);
+		$$ = driver.Create<FunctionDeclarationStatement>(@$, $3, @3, $1, @1, $4);
 	}
 	| IDENTIFIER COLON sum_type_specifier optional_initializer
 	{
-		$$ = make_shared<SumDeclarationStatement>(@$, $3, @3, $1, @1, $4);
+		$$ = driver.Create<SumDeclarationStatement>(@$, $3, @3, $1, @1, $4);
 	}
 	| IDENTIFIER COLON EQUALS expression
 	{
-		$$ = make_shared<InferredDeclarationStatement>(@$, $1, @1, $4);
+		$$ = driver.Create<InferredDeclarationStatement>(@$, $1, @1, $4);
 	}
 	;
 
@@ -353,28 +354,28 @@ primitive_type_specifier:
 function_type_specifier:
 	LPAREN optional_anonymous_parameter_list RPAREN ARROW_RIGHT type_specifier
 	{
-		const TypeSpecifierListRef type_list = TypeSpecifierList::Reverse($2);
-		$$ = make_shared<FunctionTypeSpecifier>(type_list, $5);
+		const TypeSpecifierListRef type_list = TypeSpecifierList::Reverse($2, driver.GetAllocator());
+		$$ = FunctionTypeSpecifier::Get(type_list, $5);
 	}
 
 //---------------------------------------------------------------------
 sum_type_specifier:
 	LPAREN sum_type_specifier_list RPAREN
 	{
-		$$ = make_shared<SumTypeSpecifier>(TypeSpecifierList::Reverse($2));
+		$$ = SumTypeSpecifier::Get(TypeSpecifierList::Reverse($2, driver.GetAllocator()));
 	}
 
 //---------------------------------------------------------------------
 sum_type_specifier_list:
 	sum_type_specifier_list PIPE type_specifier
 	{
-		$$ = TypeSpecifierList::From($3, $1);
+		$$ = TypeSpecifierList::From($3, $1, driver.GetAllocator());
 	}
 	|
 	type_specifier PIPE type_specifier
 	{
 		$$ = TypeSpecifierList::From($3, 
-			TypeSpecifierList::From($1, TypeSpecifierList::GetTerminator()));
+			TypeSpecifierList::From($1, TypeSpecifierList::GetTerminator(), driver.GetAllocator()), driver.GetAllocator());
 	}
 
 //---------------------------------------------------------------------
@@ -385,7 +386,7 @@ type_specifier:
 	}
 	| IDENTIFIER
 	{
-		$$ = make_shared<CompoundTypeSpecifier>(*$1);
+		$$ = CompoundTypeSpecifier::Get(*$1);
 	}
 	| function_type_specifier
 	{
@@ -400,7 +401,7 @@ type_specifier:
 statement_block:
 	LBRACE statement_list RBRACE
 	{
-		$$ = make_shared<StatementBlock>(StatementList::Reverse($2), @2); //statement list comes in reverse order
+		$$ = driver.Create<StatementBlock>(StatementList::Reverse($2, driver.GetAllocator()), @2); //statement list comes in reverse order
 	}
 	;
 
@@ -408,7 +409,7 @@ statement_block:
 statement_list:
 	statement_list statement
 	{
-		$$ = StatementList::From($2, $1);
+		$$ = StatementList::From($2, $1, driver.GetAllocator());
 	}
 	| empty
 	{
@@ -452,8 +453,8 @@ statement:
 	}
 	| variable_reference LPAREN optional_argument_list RPAREN
 	{
-		const ArgumentListRef argument_list = ArgumentList::Reverse($3);
-		$$ = make_shared<InvokeStatement>($1, argument_list, @3);
+		const ArgumentListRef argument_list = ArgumentList::Reverse($3, driver.GetAllocator());
+		$$ = driver.Create<InvokeStatement>($1, argument_list, @3);
 	}
 	;
 
@@ -461,7 +462,7 @@ statement:
 if_block:
 	statement
 	{
-		$$ = make_shared<StatementBlock>(StatementList::From($1, StatementList::GetTerminator()), @1);
+		$$ = driver.Create<StatementBlock>(StatementList::From($1, StatementList::GetTerminator(), driver.GetAllocator()), @1);
 	}
 	| statement_block
 	{
@@ -473,11 +474,11 @@ if_block:
 if_statement:
 	IF LPAREN expression RPAREN if_block %prec IF_NO_ELSE
 	{
-		$$ = make_shared<IfStatement>($3, $5);
+		$$ = driver.Create<IfStatement>($3, $5);
 	}
 	| IF LPAREN expression RPAREN if_block ELSE if_block
 	{
-		$$ = make_shared<IfStatement>($3, $5, $7);
+		$$ = driver.Create<IfStatement>($3, $5, $7);
 	}
 	;
 
@@ -485,12 +486,12 @@ if_statement:
 for_statement:
 	FOR LPAREN assign_statement SEMICOLON expression SEMICOLON assign_statement RPAREN statement_block
 	{
-		$$ = make_shared<ForStatement>($3, $5, $7, $9);
+		$$ = driver.Create<ForStatement>($3, $5, $7, $9);
 	}
 	|
 	FOR LPAREN variable_declaration SEMICOLON expression SEMICOLON assign_statement RPAREN statement_block
 	{
-		$$ = make_shared<ForStatement>($3, $5, $7, $9);
+		$$ = driver.Create<ForStatement>($3, $5, $7, $9);
 	}
 	;
 
@@ -498,7 +499,7 @@ for_statement:
 print_statement:
 	PRINT LPAREN expression RPAREN
 	{
-		$$ = make_shared<PrintStatement>(@1.begin.line, $3);
+		$$ = driver.Create<PrintStatement>(@1.begin.line, $3);
 	}
 	;
 
@@ -506,11 +507,11 @@ print_statement:
 exit_statement:
 	EXIT LPAREN expression RPAREN
 	{
-		$$ = make_shared<ExitStatement>($3);
+		$$ = driver.Create<ExitStatement>($3);
 	}
 	| PRINT LPAREN RPAREN
 	{
-		$$ = make_shared<ExitStatement>();
+		$$ = driver.Create<ExitStatement>();
 	}
 	;
 
@@ -518,15 +519,15 @@ exit_statement:
 assign_statement:
 	variable_reference EQUALS expression
 	{
-		$$ = make_shared<const AssignmentStatement>($1, AssignmentType::ASSIGN, $3);
+		$$ = driver.Create<const AssignmentStatement>($1, AssignmentType::ASSIGN, $3);
 	}
 	| variable_reference PLUS_ASSIGN expression
 	{
-		$$ = make_shared<const AssignmentStatement>($1, AssignmentType::PLUS_ASSIGN, $3);
+		$$ = driver.Create<const AssignmentStatement>($1, AssignmentType::PLUS_ASSIGN, $3);
 	}
 	| variable_reference MINUS_ASSIGN expression
 	{
-		$$ = make_shared<const AssignmentStatement>($1, AssignmentType::MINUS_ASSIGN, $3);
+		$$ = driver.Create<const AssignmentStatement>($1, AssignmentType::MINUS_ASSIGN, $3);
 	}
 	;
 
@@ -534,7 +535,7 @@ assign_statement:
 return_statement:
 	RETURN expression
 	{
-		$$ = make_shared<ReturnStatement>($2);
+		$$ = driver.Create<ReturnStatement>($2);
 	}
 	;
 
@@ -542,15 +543,15 @@ return_statement:
 variable_reference:
 	IDENTIFIER
 	{
-		$$ = make_shared<BasicVariable>($1, @1);
+		$$ = driver.Create<BasicVariable>($1, @1);
 	}
 	| variable_reference LBRACKET expression RBRACKET
 	{
-		$$ = make_shared<ArrayVariable>($1, $3);
+		$$ = driver.Create<ArrayVariable>($1, $3);
 	}
 	| variable_reference PERIOD variable_reference
 	{
-		$$ = make_shared<MemberVariable>($1, $3);
+		$$ = driver.Create<MemberVariable>($1, $3);
 	}
 	;
 
@@ -566,96 +567,96 @@ expression:
 	}
 	| INT_CONSTANT
 	{
-		$$ = make_shared<const ConstantExpression>(@1, $1);
+		$$ = driver.Create<const ConstantExpression>(@1, $1);
 	}
 	| TRUE
 	{
-		$$ = make_shared<const ConstantExpression>(@1, true);
+		$$ = driver.Create<const ConstantExpression>(@1, true);
 	}
 	| FALSE
 	{
-		$$ = make_shared<const ConstantExpression>(@1, false);
+		$$ = driver.Create<const ConstantExpression>(@1, false);
 	}
 	| DOUBLE_CONSTANT
 	{
-		$$ = make_shared<const ConstantExpression>(@1, $1);
+		$$ = driver.Create<const ConstantExpression>(@1, $1);
 	}
 	| STRING_CONSTANT
 	{
-		$$ = make_shared<const ConstantExpression>(@1, $1);
+		$$ = driver.Create<const ConstantExpression>(@1, $1);
 	}
 	| expression OR expression
 	{
-		$$ = make_shared<const LogicExpression>(@$, OR, $1, $3);
+		$$ = driver.Create<const LogicExpression>(@$, OR, $1, $3);
 	}
 	| expression AND expression
 	{
-		$$ = make_shared<const LogicExpression>(@$, AND, $1, $3);
+		$$ = driver.Create<const LogicExpression>(@$, AND, $1, $3);
 	}
 	| expression LESS_EQUAL expression
 	{
-		$$ = make_shared<const ComparisonExpression>(@$, LESS_THAN_EQUAL, $1, $3);
+		$$ = driver.Create<const ComparisonExpression>(@$, LESS_THAN_EQUAL, $1, $3);
 	}
 	| expression GREATER_EQUAL  expression
 	{
-		$$ = make_shared<const ComparisonExpression>(@$, GREATER_THAN_EQUAL, $1, $3);
+		$$ = driver.Create<const ComparisonExpression>(@$, GREATER_THAN_EQUAL, $1, $3);
 	}
 	| expression LESS expression 
 	{
-		$$ = make_shared<const ComparisonExpression>(@$, LESS_THAN, $1, $3);
+		$$ = driver.Create<const ComparisonExpression>(@$, LESS_THAN, $1, $3);
 	}
 	| expression GREATER  expression
 	{
-		$$ = make_shared<const ComparisonExpression>(@$, GREATER_THAN, $1, $3);
+		$$ = driver.Create<const ComparisonExpression>(@$, GREATER_THAN, $1, $3);
 	}
 	| expression EQUAL expression
 	{
-		$$ = make_shared<const ComparisonExpression>(@$, EQUAL, $1, $3);
+		$$ = driver.Create<const ComparisonExpression>(@$, EQUAL, $1, $3);
 	}
 	| expression NOT_EQUAL expression
 	{
-		$$ = make_shared<const ComparisonExpression>(@$, NOT_EQUAL, $1, $3);
+		$$ = driver.Create<const ComparisonExpression>(@$, NOT_EQUAL, $1, $3);
 	}
 	| expression PLUS expression 
 	{
 		//string concatenation isn't strictly an arithmetic operation, so this is something of a hack
-		$$ = make_shared<const ArithmeticExpression>(@$, PLUS, $1, $3);
+		$$ = driver.Create<const ArithmeticExpression>(@$, PLUS, $1, $3);
 	}
 	| expression MINUS expression
 	{
-		$$ = make_shared<const ArithmeticExpression>(@$, MINUS, $1, $3);
+		$$ = driver.Create<const ArithmeticExpression>(@$, MINUS, $1, $3);
 	}
 	| expression ASTERISK expression
 	{
-		$$ = make_shared<const ArithmeticExpression>(@$, MULTIPLY, $1, $3);
+		$$ = driver.Create<const ArithmeticExpression>(@$, MULTIPLY, $1, $3);
 	}
 	| expression DIVIDE expression
 	{
-		$$ = make_shared<const ArithmeticExpression>(@$, DIVIDE, $1, $3);
+		$$ = driver.Create<const ArithmeticExpression>(@$, DIVIDE, $1, $3);
 	}
 	| expression PERCENT expression
 	{
-		$$ = make_shared<const ArithmeticExpression>(@$, MOD, $1, $3);
+		$$ = driver.Create<const ArithmeticExpression>(@$, MOD, $1, $3);
 	}
 	| MINUS expression %prec UNARY_OPS
 	{
-		$$ = make_shared<const UnaryExpression>(@$, UNARY_MINUS, $2);
+		$$ = driver.Create<const UnaryExpression>(@$, UNARY_MINUS, $2);
 	}
 	| NOT expression %prec UNARY_OPS
 	{
-		$$ = make_shared<const UnaryExpression>(@$, NOT, $2);
+		$$ = driver.Create<const UnaryExpression>(@$, NOT, $2);
 	}
 	| AT primitive_type_specifier
 	{
-		$$ = make_shared<const DefaultValueExpression>(@$, const_shared_ptr<TypeSpecifier>($2), @2);
+		$$ = driver.Create<const DefaultValueExpression>(@$, const_shared_ptr<TypeSpecifier>($2), @2);
 	}
 	| AT IDENTIFIER
 	{
-		$$ = make_shared<const DefaultValueExpression>(@$, make_shared<CompoundTypeSpecifier>(*$2), @2);
+		$$ = driver.Create<const DefaultValueExpression>(@$, CompoundTypeSpecifier::Get(*$2), @2);
 	}
 	| expression WITH member_instantiation_block
 	{
-		$$ = make_shared<const WithExpression>(@$, $1, $3, @3);
+		$$ = driver.Create<const WithExpression>(@$, $1, $3, @3);
 	}
 	| function_expression
 	{
@@ -670,25 +671,25 @@ expression:
 variable_expression:
 	variable_reference
 	{
-		$$ = make_shared<VariableExpression>(@1, $1);
+		$$ = driver.Create<VariableExpression>(@1, $1);
 	}
 	;
 
 invoke_expression:
 	variable_expression LPAREN optional_argument_list RPAREN
 	{
-		const ArgumentListRef argument_list = ArgumentList::Reverse($3);
-		$$ = make_shared<InvokeExpression>(@$, $1, argument_list, @3);
+		const ArgumentListRef argument_list = ArgumentList::Reverse($3, driver.GetAllocator());
+		$$ = driver.Create<InvokeExpression>(@$, $1, argument_list, @3);
 	}
 	| invoke_expression LPAREN optional_argument_list RPAREN
 	{
-		const ArgumentListRef argument_list = ArgumentList::Reverse($3);
-		$$ = make_shared<InvokeExpression>(@$, $1, argument_list, @3);
+		const ArgumentListRef argument_list = ArgumentList::Reverse($3, driver.GetAllocator());
+		$$ = driver.Create<InvokeExpression>(@$, $1, argument_list, @3);
 	}
 	| function_expression LPAREN optional_argument_list RPAREN
 	{
-		const ArgumentListRef argument_list = ArgumentList::Reverse($3);
-		$$ = make_shared<InvokeExpression>(@$, $1, argument_list, @3);
+		const ArgumentListRef argument_list = ArgumentList::Reverse($3, driver.GetAllocator());
+		$$ = driver.Create<InvokeExpression>(@$, $1, argument_list, @3);
 	}
 	;
 
@@ -696,8 +697,8 @@ invoke_expression:
 function_declaration:
 	LPAREN optional_parameter_list RPAREN ARROW_RIGHT type_specifier
 	{
-		const DeclarationListRef parameter_list = DeclarationList::Reverse($2);
-		$$ = make_shared<FunctionDeclaration>(parameter_list, $5);
+		const DeclarationListRef parameter_list = DeclarationList::Reverse($2, driver.GetAllocator());
+		$$ = driver.Create<FunctionDeclaration>(parameter_list, $5);
 	}
 	;
 
@@ -705,7 +706,7 @@ function_declaration:
 function_expression:
 	function_declaration statement_block
 	{
-		$$ = make_shared<FunctionExpression>(@1, $1, $2);
+		$$ = driver.Create<FunctionExpression>(@1, $1, $2);
 	}
 	;
 
@@ -725,11 +726,11 @@ optional_parameter_list:
 parameter_list:
 	parameter_list COMMA variable_declaration
 	{
-		$$ = DeclarationList::From($3, $1);
+		$$ = DeclarationList::From($3, $1, driver.GetAllocator());
 	}
 	| variable_declaration
 	{
-		$$ = DeclarationList::From($1, DeclarationList::GetTerminator());
+		$$ = DeclarationList::From($1, DeclarationList::GetTerminator(), driver.GetAllocator());
 	}
 	;
 
@@ -749,11 +750,11 @@ optional_anonymous_parameter_list:
 anonymous_parameter_list:
 	anonymous_parameter_list COMMA type_specifier
 	{
-		$$ = TypeSpecifierList::From($3, $1);
+		$$ = TypeSpecifierList::From($3, $1, driver.GetAllocator());
 	}
 	| type_specifier
 	{
-		$$ = TypeSpecifierList::From($1, TypeSpecifierList::GetTerminator());
+		$$ = TypeSpecifierList::From($1, TypeSpecifierList::GetTerminator(), driver.GetAllocator());
 	}
 	;
 
@@ -773,11 +774,11 @@ optional_argument_list:
 argument_list:
 	argument_list COMMA expression
 	{
-		$$ = ArgumentList::From($3, $1);
+		$$ = ArgumentList::From($3, $1, driver.GetAllocator());
 	}
 	| expression
 	{
-		$$ = ArgumentList::From($1, ArgumentList::GetTerminator());
+		$$ = ArgumentList::From($1, ArgumentList::GetTerminator(), driver.GetAllocator());
 	}
 	;
 
@@ -785,33 +786,33 @@ argument_list:
 modifier_list:
 	modifier_list modifier
 	{
-		$$ = ModifierList::From($2, $1);
+		$$ = ModifierList::From($2, $1, driver.GetAllocator());
 	}
 	| modifier
 	{
-		$$ = ModifierList::From($1, ModifierList::GetTerminator());
+		$$ = ModifierList::From($1, ModifierList::GetTerminator(), driver.GetAllocator());
 	}
 
 modifier:
 	READONLY
 	{
-		$$ = make_shared<Modifier>(Modifier(Modifier::READONLY, @1));
+		$$ = driver.Create<Modifier>(Modifier(Modifier::READONLY, @1));
 	}
 
 //---------------------------------------------------------------------
 struct_declaration_statement:
 	modifier_list STRUCT IDENTIFIER LBRACE declaration_list RBRACE
 	{
-		const DeclarationListRef member_declaration_list = DeclarationList::Reverse($5);
-		ModifierListRef modifier_list = ModifierList::From(ModifierList::Reverse($1));
-		const_shared_ptr<CompoundTypeSpecifier> type = make_shared<CompoundTypeSpecifier>(*$3);
-		$$ = make_shared<StructDeclarationStatement>(@$, type, $3, @3, member_declaration_list, @5, modifier_list, @1);
+		const DeclarationListRef member_declaration_list = DeclarationList::Reverse($5, driver.GetAllocator());
+		ModifierListRef modifier_list = ModifierList::From(ModifierList::Reverse($1, driver.GetAllocator()));
+		const_shared_ptr<CompoundTypeSpecifier> type = CompoundTypeSpecifier::Get(*$3);
+		$$ = driver.Create<StructDeclarationStatement>(@$, type, $3, @3, member_declaration_list, @5, modifier_list, @1);
 	}
 	| STRUCT IDENTIFIER LBRACE declaration_list RBRACE
 	{
-		const DeclarationListRef member_declaration_list = DeclarationList::Reverse($4);
-		const_shared_ptr<CompoundTypeSpecifier> type = make_shared<CompoundTypeSpecifier>(*$2);
-		$$ = make_shared<StructDeclarationStatement>(@$, type, $2, @2, member_declaration_list, @4, ModifierList::GetTerminator(), GetDefaultLocation());
+		const DeclarationListRef member_declaration_list = DeclarationList::Reverse($4, driver.GetAllocator());
+		const_shared_ptr<CompoundTypeSpecifier> type = CompoundTypeSpecifier::Get(*$2);
+		$$ = driver.Create<StructDeclarationStatement>(@$, type, $2, @2, member_declaration_list, @4, ModifierList::GetTerminator(), GetDefaultLocation());
 	}
 	;
 
@@ -819,7 +820,7 @@ struct_declaration_statement:
 declaration_list:
 	declaration_list variable_declaration
 	{
-		$$ = DeclarationList::From($2, $1);
+		$$ = DeclarationList::From($2, $1, driver.GetAllocator());
 	}
 	| empty
 	{
@@ -851,18 +852,18 @@ optional_member_instantiation_list:
 member_instantiation_list:
 	member_instantiation_list COMMA member_instantiation
 	{
-		$$ = MemberInstantiationList::From($3, $1);
+		$$ = MemberInstantiationList::From($3, $1, driver.GetAllocator());
 	}
 	| member_instantiation
 	{
-		$$ = MemberInstantiationList::From($1, MemberInstantiationList::GetTerminator());
+		$$ = MemberInstantiationList::From($1, MemberInstantiationList::GetTerminator(), driver.GetAllocator());
 	}
 
 //---------------------------------------------------------------------
 member_instantiation:
 	IDENTIFIER EQUALS expression
 	{
-		$$ = make_shared<MemberInstantiation>(MemberInstantiation($1, @1, $3));
+		$$ = driver.Create<MemberInstantiation>(MemberInstantiation($1, @1, $3));
 	}
 	;
 
@@ -870,11 +871,11 @@ member_instantiation:
 dimensions:
 	dimensions dimension
 	{
-		$$ = DimensionList::From($2, $1);
+		$$ = DimensionList::From($2, $1, driver.GetAllocator());
 	}
 	| dimension
 	{
-		$$ = DimensionList::From($1, DimensionList::GetTerminator());
+		$$ = DimensionList::From($1, DimensionList::GetTerminator(), driver.GetAllocator());
 	}
 	;
 
@@ -882,7 +883,7 @@ dimensions:
 dimension:
 	LBRACKET RBRACKET
 	{
-		$$ = make_shared<Dimension>(Dimension(@$));
+		$$ = driver.Create<Dimension>(Dimension(@$));
 	}
 	;
 
@@ -0,0 +1,214 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <performance_counters.h>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+const char* const PerformanceCounters::EVENT_NAMES[EVENT_COUNT] = { "cycles",
+		"instructions", "cache_misses", "branch_misses" };
+
+#ifdef __linux__
+namespace {
+const unsigned long long EVENT_CONFIGS[PerformanceCounters::EVENT_COUNT] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+int OpenEvent(const unsigned long long config) {
+	struct perf_event_attr attributes;
+	memset(&attributes, 0, sizeof(attributes));
+	attributes.size = sizeof(attributes);
+	attributes.type = PERF_TYPE_HARDWARE;
+	attributes.config = config;
+	attributes.disabled = 1;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv = 1;
+	//the counter may be multiplexed with others, in which case its count is scaled
+	attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED
+			| PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+long long ReadEvent(const int descriptor) {
+	unsigned long long values[3];
+	if (read(descriptor, values, sizeof(values)) != sizeof(values)) {
+		return -1;
+	}
+
+	const unsigned long long count = values[0];
+	const unsigned long long enabled = values[1];
+	const unsigned long long running = values[2];
+	if (running == 0) {
+		return enabled == 0 ? 0 : -1;
+	} else if (running < enabled) {
+		return static_cast<long long>(static_cast<double>(count) * enabled
+				/ running);
+	} else {
+		return count;
+	}
+}
+}
+#endif
+
+PerformanceCounters::PerformanceCounters() :
+		m_error(), m_phases(), m_start() {
+	for (int i = 0; i < EVENT_COUNT; i++) {
+#ifdef __linux__
+		m_descriptors[i] = OpenEvent(EVENT_CONFIGS[i]);
+		if (m_descriptors[i] < 0 && m_error.empty()) {
+			m_error = strerror(errno);
+		}
+#else
+		m_descriptors[i] = -1;
+		m_error = "not supported on this platform";
+#endif
+	}
+}
+
+PerformanceCounters::~PerformanceCounters() {
+#ifdef __linux__
+	for (int i = 0; i < EVENT_COUNT; i++) {
+		if (m_descriptors[i] >= 0) {
+			close(m_descriptors[i]);
+		}
+	}
+#endif
+}
+
+void PerformanceCounters::Begin(const std::string& phase) {
+	Phase entry;
+	entry.name = phase;
+	entry.milliseconds = 0;
+	m_phases.push_back(entry);
+
+#ifdef __linux__
+	for (int i = 0; i < EVENT_COUNT; i++) {
+		if (m_descriptors[i] >= 0) {
+			ioctl(m_descriptors[i], PERF_EVENT_IOC_RESET, 0);
+			ioctl(m_descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+		}
+	}
+#endif
+	m_start = std::chrono::steady_clock::now();
+}
+
+void PerformanceCounters::End() {
+	const auto end = std::chrono::steady_clock::now();
+	Phase& phase = m_phases.back();
+	phase.milliseconds = std::chrono::duration<double, std::milli>(
+			end - m_start).count();
+
+	for (int i = 0; i < EVENT_COUNT; i++) {
+		phase.counts[i] = -1;
+#ifdef __linux__
+		if (m_descriptors[i] >= 0) {
+			ioctl(m_descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+			phase.counts[i] = ReadEvent(m_descriptors[i]);
+			if (phase.counts[i] < 0 && m_error.empty()) {
+				m_error = "a counter could not be read";
+			}
+		}
+#endif
+	}
+}
+
+void PerformanceCounters::Print(std::ostream& out) const {
+	out << std::left << std::setw(12) << "phase" << std::right
+			<< std::setw(12) << "time (ms)";
+	for (int i = 0; i < EVENT_COUNT; i++) {
+		out << std::setw(16) << EVENT_NAMES[i];
+	}
+	out << std::endl;
+
+	for (const Phase& phase : m_phases) {
+		out << std::left << std::setw(12) << phase.name << std::right
+				<< std::setw(12) << std::fixed << std::setprecision(3)
+				<< phase.milliseconds;
+		for (int i = 0; i < EVENT_COUNT; i++) {
+			out << std::setw(16);
+			if (phase.counts[i] >= 0) {
+				out << phase.counts[i];
+			} else {
+				out << "n/a";
+			}
+		}
+		out << std::endl;
+	}
+
+	if (!m_error.empty()) {
+		out << "Some hardware counters are unavailable (" << m_error << ")."
+				<< std::endl;
+	}
+}
+
+void PerformanceCounters::WriteJson(std::ostream& out,
+		const std::string& file_name) const {
+	out << "{\"file\": ";
+	WriteJsonString(out, file_name);
+	out << ", \"phases\": [";
+
+	for (size_t p = 0; p < m_phases.size(); p++) {
+		const Phase& phase = m_phases[p];
+		out << (p > 0 ? ", " : "") << "{\"name\": \"" << phase.name
+				<< "\", \"milliseconds\": " << std::fixed
+				<< std::setprecision(3) << phase.milliseconds;
+		for (int i = 0; i < EVENT_COUNT; i++) {
+			out << ", \"" << EVENT_NAMES[i] << "\": ";
+			if (phase.counts[i] >= 0) {
+				out << phase.counts[i];
+			} else {
+				out << "null";
+			}
+		}
+		out << "}";
+	}
+	out << "]";
+
+	if (!m_error.empty()) {
+		out << ", \"error\": ";
+		WriteJsonString(out, m_error);
+	}
+
+	out << "}" << std::endl;
+}
+
+void PerformanceCounters::WriteJsonString(std::ostream& out,
+		const std::string& value) {
+	out << '"';
+	for (const char c : value) {
+		if (c == '"' || c == '\\') {
+			out << '\\' << c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+					<< static_cast<int>(c) << std::dec << std::setfill(' ');
+		} else {
+			out << c;
+		}
+	}
+	out << '"';
+}
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERFORMANCE_COUNTERS_H_
+#define PERFORMANCE_COUNTERS_H_
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Hardware performance counters, read around each phase of a run (parsing,
+ * preprocessing, execution and so on) with Linux's perf_event_open.
+ *
+ * Each event is opened separately, counting user-space work of this process
+ * only. An event that cannot be opened (for example, in a container without
+ * access to the PMU, or when perf_event_paranoid forbids it) is reported as
+ * unavailable rather than failing the run; wall-clock time is always measured.
+ */
+class PerformanceCounters {
+public:
+	enum Event {
+		CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, EVENT_COUNT
+	};
+
+	PerformanceCounters();
+	virtual ~PerformanceCounters();
+
+	/**
+	 * Start counting a phase with the given name. Phases must not overlap.
+	 */
+	void Begin(const std::string& phase);
+	void End();
+
+	const bool IsAvailable(const Event event) const {
+		return m_descriptors[event] >= 0;
+	}
+
+	/**
+	 * Write a table of the counts of each phase.
+	 */
+	void Print(std::ostream& out) const;
+
+	/**
+	 * Write the counts of each phase as a JSON object. Unavailable counts are
+	 * null, and the reason the first of them is unavailable is given as
+	 * "error".
+	 */
+	void WriteJson(std::ostream& out, const std::string& file_name) const;
+
+private:
+	PerformanceCounters(const PerformanceCounters& other) = delete;
+	PerformanceCounters& operator=(const PerformanceCounters& other) = delete;
+
+	struct Phase {
+		std::string name;
+		double milliseconds;
+		//negative if the event is unavailable
+		long long counts[EVENT_COUNT];
+	};
+
+	/**
+	 * Write a quoted JSON string, escaping quotes, backslashes and control
+	 * characters.
+	 */
+	static void WriteJsonString(std::ostream& out, const std::string& value);
+
+	static const char* const EVENT_NAMES[EVENT_COUNT];
+
+	int m_descriptors[EVENT_COUNT];
+	std::string m_error;
+	std::vector<Phase> m_phases;
+	std::chrono::steady_clock::time_point m_start;
+};
+
+#endif /* PERFORMANCE_COUNTERS_H_ */
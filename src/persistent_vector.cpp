@@ -0,0 +1,189 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <persistent_vector.h>
+
+template<class T, int Bits>
+PersistentVector<T, Bits>::PersistentVector() :
+		m_size(0), m_shift(BITS), m_root(), m_tail() {
+}
+
+template<class T, int Bits>
+const typename PersistentVector<T, Bits>::Leaf* PersistentVector<T,
+		Bits>::GetLeaf(const size_t index) const {
+	if (index >= GetTailOffset()) {
+		return m_tail.get();
+	}
+
+	const void* node = m_root.get();
+	for (int level = m_shift; level > 0; level -= BITS) {
+		node = static_cast<const Branch*>(node)->children[(index >> level)
+				& MASK].get();
+	}
+	return static_cast<const Leaf*>(node);
+}
+
+template<class T, int Bits>
+const PersistentVector<T, Bits> PersistentVector<T, Bits>::WithValue(
+		const size_t index, const T& value) const {
+	PersistentVector result(*this);
+	if (index >= GetTailOffset()) {
+		auto tail = std::make_shared<Leaf>(*m_tail);
+		tail->Set(index & MASK, value);
+		result.m_tail = tail;
+	} else {
+		result.m_root = std::static_pointer_cast<const Branch>(
+				Assign(m_shift, m_root, index, value));
+	}
+	return result;
+}
+
+template<class T, int Bits>
+typename PersistentVector<T, Bits>::Leaf* PersistentVector<T,
+		Bits>::GetMutableLeaf(const size_t index) {
+	if (index >= GetTailOffset()) {
+		if (!m_tail.unique()) {
+			m_tail = std::make_shared<Leaf>(*m_tail);
+		}
+		return const_cast<Leaf*>(m_tail.get());
+	}
+
+	//nodes are only ever modified while this vector is their sole owner
+	if (!m_root.unique()) {
+		m_root = std::make_shared<Branch>(*m_root);
+	}
+	Branch* branch = const_cast<Branch*>(m_root.get());
+	for (int level = m_shift; level > BITS; level -= BITS) {
+		plain_shared_ptr<void>& child = branch->children[(index >> level)
+				& MASK];
+		if (!child.unique()) {
+			child = std::make_shared<Branch>(
+					*std::static_pointer_cast<const Branch>(child));
+		}
+		branch = const_cast<Branch*>(static_cast<const Branch*>(child.get()));
+	}
+
+	plain_shared_ptr<void>& leaf = branch->children[(index >> BITS) & MASK];
+	if (!leaf.unique()) {
+		leaf = std::make_shared<Leaf>(
+				*std::static_pointer_cast<const Leaf>(leaf));
+	}
+	return const_cast<Leaf*>(static_cast<const Leaf*>(leaf.get()));
+}
+
+template<class T, int Bits>
+void PersistentVector<T, Bits>::Set(const size_t index, const T& value) {
+	GetMutableLeaf(index)->Set(index & MASK, value);
+}
+
+template<class T, int Bits>
+void PersistentVector<T, Bits>::Append(const T& value) {
+	if (!m_tail) {
+		m_tail = std::make_shared<Leaf>();
+	} else if (m_size - GetTailOffset() == WIDTH) {
+		PushTail(m_tail);
+		m_tail = std::make_shared<Leaf>();
+	} else if (!m_tail.unique()) {
+		m_tail = std::make_shared<Leaf>(*m_tail);
+	}
+
+	const_cast<Leaf*>(m_tail.get())->Set(m_size & MASK, value);
+	m_size++;
+}
+
+template<class T, int Bits>
+void PersistentVector<T, Bits>::PushTail(const_shared_ptr<Leaf> tail) {
+	if (!m_root) {
+		m_root = std::make_shared<Branch>();
+	}
+
+	if ((m_size >> BITS) > (static_cast<size_t>(1) << m_shift)) {
+		//the trie is full; grow it by a level
+		auto root = std::make_shared<Branch>();
+		root->children[0] = m_root;
+		root->children[1] = NewPath(m_shift, tail);
+		m_root = root;
+		m_shift += BITS;
+	} else {
+		m_root = PushTail(m_size, m_shift, m_root, tail);
+	}
+}
+
+template<class T, int Bits>
+const plain_shared_ptr<typename PersistentVector<T, Bits>::Branch> PersistentVector<
+		T, Bits>::PushTail(const size_t size, const int level,
+		const_shared_ptr<Branch> parent, const_shared_ptr<Leaf> tail) {
+	auto result = std::make_shared<Branch>(*parent);
+	const size_t index = ((size - 1) >> level) & MASK;
+	if (level == BITS) {
+		result->children[index] = tail;
+	} else {
+		auto child = std::static_pointer_cast<const Branch>(
+				parent->children[index]);
+		if (child) {
+			result->children[index] = PushTail(size, level - BITS, child,
+					tail);
+		} else {
+			result->children[index] = NewPath(level - BITS, tail);
+		}
+	}
+	return result;
+}
+
+template<class T, int Bits>
+const plain_shared_ptr<void> PersistentVector<T, Bits>::NewPath(const int level,
+		const_shared_ptr<Leaf> leaf) {
+	if (level == 0) {
+		return leaf;
+	}
+
+	auto result = std::make_shared<Branch>();
+	result->children[0] = NewPath(level - BITS, leaf);
+	return result;
+}
+
+template<class T, int Bits>
+const plain_shared_ptr<void> PersistentVector<T, Bits>::Assign(const int level,
+		const_shared_ptr<void> node, const size_t index, const T& value) {
+	if (level == 0) {
+		auto result = std::make_shared<Leaf>(
+				*std::static_pointer_cast<const Leaf>(node));
+		result->Set(index & MASK, value);
+		return result;
+	}
+
+	auto branch = std::static_pointer_cast<const Branch>(node);
+	auto result = std::make_shared<Branch>(*branch);
+	const size_t sub_index = (index >> level) & MASK;
+	result->children[sub_index] = Assign(level - BITS,
+			branch->children[sub_index], index, value);
+	return result;
+}
+
+//the element types of arrays
+template class PersistentVector<bool> ;
+template class PersistentVector<int> ;
+template class PersistentVector<double> ;
+template class PersistentVector<plain_shared_ptr<std::string>> ;
+template class PersistentVector<Value> ;
+
+//the symbols of a symbol map
+class Symbol;
+template class PersistentVector<plain_shared_ptr<Symbol>, 3> ;
@@ -0,0 +1,242 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PERSISTENT_VECTOR_H_
+#define PERSISTENT_VECTOR_H_
+
+#include <cstddef>
+#include <bitset>
+#include <defaults.h>
+#include <value.h>
+
+/**
+ * One leaf of a PersistentVector: a contiguous block of elements.
+ */
+template<class T, size_t Width> struct PersistentVectorLeaf {
+	typedef const T& const_reference;
+
+	const T& Get(const size_t index) const {
+		return values[index];
+	}
+
+	void Set(const size_t index, const T& value) {
+		values[index] = value;
+	}
+
+	T values[Width];
+};
+
+/**
+ * Booleans are packed into a bitset.
+ */
+template<size_t Width> struct PersistentVectorLeaf<bool, Width> {
+	typedef bool const_reference;
+
+	const bool Get(const size_t index) const {
+		return bits[index];
+	}
+
+	void Set(const size_t index, const bool value) {
+		bits[index] = value;
+	}
+
+	std::bitset<Width> bits;
+};
+
+/**
+ * An immutable vector of elements with structural sharing, implemented as a 32-way
+ * trie with a separate tail node (cf. Clojure's PersistentVector). A narrower
+ * trie may be used for vectors that are expected to be small.
+ *
+ * Updates return a new vector that shares all but the modified path with the
+ * original, so an update costs O(log32 n) and an append amortized O(1).
+ *
+ * Elements are stored unboxed in the leaves, so a vector of primitives is a
+ * sequence of contiguous blocks of 32 elements each.
+ *
+ * A vector can also be updated in place. Nodes that are shared with another
+ * vector are copied first, so a copy of a vector costs O(1) and the copy and
+ * the original each pay for the nodes they subsequently modify. An empty
+ * vector allocates no nodes.
+ */
+template<class T, int Bits = 5> class PersistentVector {
+private:
+	static const int BITS = Bits;
+	static const size_t WIDTH = 1 << BITS;
+	static const size_t MASK = WIDTH - 1;
+
+public:
+	PersistentVector();
+
+	const size_t GetSize() const {
+		return m_size;
+	}
+
+	/**
+	 * Get the element at the given index, which must be less than the size.
+	 */
+	const typename PersistentVectorLeaf<T, WIDTH>::const_reference Get(
+			const size_t index) const {
+		return GetLeaf(index)->Get(index & MASK);
+	}
+
+	/**
+	 * Replace the element at the given index, which must be less than the size.
+	 */
+	void Set(const size_t index, const T& value);
+
+	/**
+	 * Append an element.
+	 */
+	void Append(const T& value);
+
+	/**
+	 * Call the given visitor with each element in order, a leaf at a time.
+	 */
+	template<class Visitor> void ForEach(Visitor visitor) const {
+		for (size_t offset = 0; offset < m_size; offset += WIDTH) {
+			const Leaf* leaf = GetLeaf(offset);
+			const size_t count =
+					m_size - offset < WIDTH ? m_size - offset : WIDTH;
+			for (size_t i = 0; i < count; i++) {
+				visitor(leaf->Get(i));
+			}
+		}
+	}
+
+	/**
+	 * Walk the nodes of the trie for the cycle collector. The tracer's Enter is
+	 * called with the address and reference count of each node; if it returns
+	 * true, the node's children (or, for a leaf, each of its elements, via the
+	 * given element visitor) are visited before a matching call to Leave.
+	 */
+	template<class Tracer, class ElementVisitor> void Trace(Tracer& tracer,
+			ElementVisitor visit_element) const {
+		if (m_root && tracer.Enter(m_root.get(), m_root.use_count())) {
+			TraceBranch(tracer, visit_element, m_root.get(), m_shift);
+			tracer.Leave();
+		}
+
+		if (m_tail && tracer.Enter(m_tail.get(), m_tail.use_count())) {
+			TraceLeaf(visit_element, m_tail.get());
+			tracer.Leave();
+		}
+	}
+
+	/**
+	 * Return a copy of this vector with the element at the given index replaced.
+	 * The index must be less than the size.
+	 */
+	const PersistentVector WithValue(const size_t index, const T& value) const;
+
+	/**
+	 * Return a copy of this vector with count elements appended, each of which is
+	 * obtained by calling the given generator.
+	 */
+	template<class Generator> const PersistentVector WithAppended(
+			const size_t count, Generator generator) const {
+		PersistentVector result(*this);
+		if (count == 0) {
+			return result;
+		}
+
+		//the new tail isn't visible to anyone else until we're done, so it can be filled in place
+		auto tail = m_tail ?
+				std::make_shared<Leaf>(*m_tail) : std::make_shared<Leaf>();
+		size_t tail_size = m_size - GetTailOffset();
+		for (size_t i = 0; i < count; i++) {
+			if (tail_size == WIDTH) {
+				result.PushTail(tail);
+				tail = std::make_shared<Leaf>();
+				tail_size = 0;
+			}
+
+			tail->Set(tail_size++, generator());
+			result.m_size++;
+		}
+
+		result.m_tail = tail;
+		return result;
+	}
+
+private:
+	/**
+	 * Interior trie node. Children are branches, or leaves at the bottom level.
+	 */
+	struct Branch {
+		plain_shared_ptr<void> children[WIDTH];
+	};
+
+	typedef PersistentVectorLeaf<T, WIDTH> Leaf;
+
+	const size_t GetTailOffset() const {
+		return m_size < WIDTH ? 0 : ((m_size - 1) >> BITS) << BITS;
+	}
+
+	const Leaf* GetLeaf(const size_t index) const;
+
+	template<class Tracer, class ElementVisitor> static void TraceBranch(
+			Tracer& tracer, ElementVisitor& visit_element, const Branch* branch,
+			const int level) {
+		for (size_t i = 0; i < WIDTH; i++) {
+			const plain_shared_ptr<void>& child = branch->children[i];
+			if (child && tracer.Enter(child.get(), child.use_count())) {
+				if (level > BITS) {
+					TraceBranch(tracer, visit_element,
+							static_cast<const Branch*>(child.get()),
+							level - BITS);
+				} else {
+					TraceLeaf(visit_element,
+							static_cast<const Leaf*>(child.get()));
+				}
+				tracer.Leave();
+			}
+		}
+	}
+
+	template<class ElementVisitor> static void TraceLeaf(
+			ElementVisitor& visit_element, const Leaf* leaf) {
+		for (size_t i = 0; i < WIDTH; i++) {
+			visit_element(leaf->values[i]);
+		}
+	}
+
+	/**
+	 * Get the leaf holding the given index for modification, first copying any
+	 * nodes on its path that are shared.
+	 */
+	Leaf* GetMutableLeaf(const size_t index);
+
+	void PushTail(const_shared_ptr<Leaf> tail);
+
+	static const plain_shared_ptr<Branch> PushTail(const size_t size,
+			const int level, const_shared_ptr<Branch> parent,
+			const_shared_ptr<Leaf> tail);
+	static const plain_shared_ptr<void> NewPath(const int level,
+			const_shared_ptr<Leaf> leaf);
+	static const plain_shared_ptr<void> Assign(const int level,
+			const_shared_ptr<void> node, const size_t index, const T& value);
+
+	size_t m_size;
+	int m_shift;
+	plain_shared_ptr<Branch> m_root;
+	plain_shared_ptr<Leaf> m_tail;
+};
+
+#endif /* PERSISTENT_VECTOR_H_ */
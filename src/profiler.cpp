@@ -0,0 +1,133 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include <profiler.h>
+
+thread_local Profiler* Profiler::s_active = nullptr;
+std::atomic<Profiler*> Profiler::s_running(nullptr);
+std::atomic<int> Profiler::s_pending_ticks(0);
+
+Profiler::Profiler(const std::string& root_name) :
+		m_root_name(root_name), m_frames(), m_samples(), m_sample_count(0), m_stack(), m_running(
+				false) {
+	Push(m_root_name, 0);
+}
+
+Profiler::~Profiler() {
+	Stop();
+}
+
+const bool Profiler::Start() {
+	//the timer and its signal belong to the process
+	Profiler* expected = nullptr;
+	if (!s_running.compare_exchange_strong(expected, this)) {
+		return false;
+	}
+
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = &Profiler::OnTick;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGPROF, &action, nullptr) != 0) {
+		s_running = nullptr;
+		return false;
+	}
+
+	struct itimerval timer;
+	timer.it_interval.tv_sec = 0;
+	timer.it_interval.tv_usec = 1000000 / FREQUENCY;
+	timer.it_value = timer.it_interval;
+	if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+		signal(SIGPROF, SIG_DFL);
+		s_running = nullptr;
+		return false;
+	}
+
+	s_active = this;
+	m_running = true;
+	return true;
+}
+
+void Profiler::Stop() {
+	if (!m_running) {
+		return;
+	}
+
+	struct itimerval timer;
+	memset(&timer, 0, sizeof(timer));
+	setitimer(ITIMER_PROF, &timer, nullptr);
+	signal(SIGPROF, SIG_DFL);
+
+	//ticks since the last safepoint are dropped
+	s_pending_ticks = 0;
+	s_active = nullptr;
+	s_running = nullptr;
+	m_running = false;
+}
+
+const bool Profiler::Write(const std::string& file_name) const {
+	std::ofstream out(file_name.c_str());
+	if (!out) {
+		return false;
+	}
+
+	//sorted, so that profiles of the same run compare equal
+	std::vector<std::pair<std::string, size_t>> samples(m_samples.begin(),
+			m_samples.end());
+	std::sort(samples.begin(), samples.end());
+	for (const auto& sample : samples) {
+		out << sample.first << " " << sample.second << "\n";
+	}
+
+	out.close();
+	return !out.fail();
+}
+
+void Profiler::Sample(const int line) {
+	const int ticks = s_pending_ticks.exchange(0);
+	if (ticks == 0) {
+		return;
+	}
+
+	//each frame is annotated with the line it is executing, which for all but
+	//the innermost frame is the line its callee was invoked from
+	m_stack.clear();
+	for (size_t i = 0; i < m_frames.size(); i++) {
+		if (i > 0) {
+			m_stack += ';';
+		}
+		m_stack += *m_frames[i].name;
+		m_stack += ':';
+		m_stack += std::to_string(
+				i + 1 < m_frames.size() ? m_frames[i + 1].line : line);
+	}
+
+	m_samples[m_stack] += ticks;
+	m_sample_count += ticks;
+}
+
+void Profiler::OnTick(int signal) {
+	s_pending_ticks.fetch_add(1, std::memory_order_relaxed);
+}
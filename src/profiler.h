@@ -0,0 +1,153 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A sampling profiler for newt scripts.
+ *
+ * The interpreters maintain the profiler's logical call stack: the name of each
+ * function being invoked, along with the line it was invoked from. A timer signal
+ * fires at a fixed rate of CPU time; the handler merely counts the tick, and the
+ * interpreter records the pending ticks against the current call stack at its
+ * next safepoint, which it reaches at every statement (and, in the virtual
+ * machine, at every jump and call), passing the line being executed. The profile
+ * is written as collapsed stacks, one line per distinct stack followed by its
+ * sample count, which is the input format of flame graph tools.
+ *
+ * Only one profiler may run at a time in a process. It profiles the thread that
+ * started it: scripts on other threads see no active profiler. The timer counts
+ * the CPU time of the whole process, though, so while other threads are busy,
+ * the profile's total overstates the time spent on the profiled thread.
+ */
+class Profiler {
+public:
+	/**
+	 * Create a profiler whose stacks are rooted at a frame with the given name.
+	 */
+	Profiler(const std::string& root_name);
+	virtual ~Profiler();
+
+	/**
+	 * Start sampling. Returns false if the timer could not be set up.
+	 */
+	const bool Start();
+	void Stop();
+
+	/**
+	 * Write the profile to the given file. Returns false if it cannot be written.
+	 */
+	const bool Write(const std::string& file_name) const;
+
+	const size_t GetSampleCount() const {
+		return m_sample_count;
+	}
+
+	/**
+	 * Enter a call of the function with the given name, made from the given line.
+	 * The name must outlive the call.
+	 */
+	void Push(const std::string& name, const int line) {
+		Frame frame = { &name, line };
+		m_frames.push_back(frame);
+	}
+
+	void Pop() {
+		m_frames.pop_back();
+	}
+
+	/**
+	 * Replace the function of the innermost call, as a tail call does.
+	 */
+	void Rename(const std::string& name) {
+		m_frames.back().name = &name;
+	}
+
+	/**
+	 * Record the pending ticks, if any, against the current call stack, with the
+	 * given line of the innermost call being executed.
+	 */
+	void Sample(const int line);
+
+	/**
+	 * The profiler running on the calling thread, or null if there is none.
+	 */
+	static Profiler* GetActive() {
+		return s_active;
+	}
+
+	static const bool IsSamplePending() {
+		return s_pending_ticks.load(std::memory_order_relaxed) != 0 && s_active;
+	}
+
+	static const int FREQUENCY = 1000;
+
+private:
+	Profiler(const Profiler& other) = delete;
+	Profiler& operator=(const Profiler& other) = delete;
+
+	struct Frame {
+		const std::string* name;
+		int line;
+	};
+
+	static void OnTick(int signal);
+
+	const std::string m_root_name;
+	std::vector<Frame> m_frames;
+	std::unordered_map<std::string, size_t> m_samples;
+	size_t m_sample_count;
+	std::string m_stack;
+	bool m_running;
+
+	static thread_local Profiler* s_active;
+	static std::atomic<Profiler*> s_running;
+	static std::atomic<int> s_pending_ticks;
+};
+
+/**
+ * Enters a call on the running profiler's call stack, if there is one, for the
+ * lifetime of the object.
+ */
+class ProfiledCall {
+public:
+	ProfiledCall(const std::string& name, const int line) :
+			m_profiler(Profiler::GetActive()) {
+		if (m_profiler) {
+			m_profiler->Push(name, line);
+		}
+	}
+
+	~ProfiledCall() {
+		if (m_profiler) {
+			m_profiler->Pop();
+		}
+	}
+
+private:
+	Profiler* const m_profiler;
+};
+
+#endif /* PROFILER_H_ */
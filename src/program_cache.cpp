@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <program_cache.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <driver.h>
+#include <statement_block.h>
+#include <syntax_tree_reader.h>
+#include <syntax_tree_writer.h>
+
+const char ProgramCache::MAGIC[4] = { 'N', 'W', 'T', 'C' };
+//incremented whenever the serialized form of the syntax tree changes
+const uint32_t ProgramCache::VERSION = 1;
+
+ProgramCache::ProgramCache(const std::string& file_name,
+		const std::string& cache_directory) :
+		m_source_read(false), m_source_hash(0), m_source_size(
+				0), m_cache_file_name() {
+	std::ifstream source(file_name.c_str(), std::ios::binary);
+	std::ostringstream contents;
+	contents << source.rdbuf();
+	if (source) {
+		const std::string data = contents.str();
+		m_source_read = true;
+		m_source_hash = Hash(data.data(), data.size());
+		m_source_size = data.size();
+	}
+
+	if (cache_directory.empty()) {
+		const std::string extension = ".nwt";
+		const bool has_extension = file_name.size() > extension.size()
+				&& file_name.compare(file_name.size() - extension.size(),
+						extension.size(), extension) == 0;
+		m_cache_file_name = file_name + (has_extension ? "c" : ".nwtc");
+	} else {
+		std::ostringstream name;
+		name << cache_directory << "/" << std::hex << std::setw(16)
+				<< std::setfill('0') << m_source_hash << ".nwtc";
+		m_cache_file_name = name.str();
+	}
+}
+
+ProgramCache::~ProgramCache() {
+}
+
+const bool ProgramCache::Load(Driver& driver) const {
+	if (!m_source_read) {
+		return false;
+	}
+
+	const int file = open(m_cache_file_name.c_str(), O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+
+	struct stat status;
+	if (fstat(file, &status) != 0
+			|| status.st_size < static_cast<off_t>(sizeof(Header))) {
+		close(file);
+		return false;
+	}
+
+	const size_t size = status.st_size;
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+
+	const char* contents = static_cast<const char*>(mapping);
+	Header header;
+	memcpy(&header, contents, sizeof(header));
+	const char* data = contents + sizeof(header);
+	const size_t data_size = size - sizeof(header);
+
+	plain_shared_ptr<StatementBlock> block = nullptr;
+	if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+			&& header.version == VERSION
+			&& header.source_hash == m_source_hash
+			&& header.source_size == m_source_size
+			&& header.data_size == data_size
+			&& header.data_hash == Hash(data, data_size)) {
+		block = SyntaxTreeReader(driver, data, data_size).Read();
+	}
+
+	//the tree doesn't refer to the mapping, so it can be released right away
+	munmap(mapping, size);
+
+	if (!block) {
+		return false;
+	}
+
+	driver.SetStatementBlock(block);
+	return true;
+}
+
+const bool ProgramCache::Store(const StatementBlock& block) const {
+	if (!m_source_read) {
+		return false;
+	}
+
+	SyntaxTreeWriter writer;
+	if (!writer.Write(block)) {
+		return false;
+	}
+	const std::string data = writer.GetData();
+
+	Header header;
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.source_hash = m_source_hash;
+	header.source_size = m_source_size;
+	header.data_hash = Hash(data.data(), data.size());
+	header.data_size = data.size();
+
+	//write to a temporary file first, so that concurrent runs of the same
+	//script never load a partially written cache file; the name is unique to
+	//the process and the store, since threads may store the same script too
+	static std::atomic<unsigned int> store_count(0);
+	const std::string temporary_file_name = m_cache_file_name + "."
+			+ std::to_string(getpid()) + "." + std::to_string(store_count++)
+			+ ".tmp";
+	std::ofstream out(temporary_file_name.c_str(), std::ios::binary);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(data.data(), data.size());
+	out.close();
+
+	if (out.fail()
+			|| rename(temporary_file_name.c_str(), m_cache_file_name.c_str())
+					!= 0) {
+		unlink(temporary_file_name.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+const uint64_t ProgramCache::Hash(const char* data, const size_t size) {
+	uint64_t result = 14695981039346656037ULL;
+	for (size_t i = 0; i < size; i++) {
+		result ^= static_cast<uint8_t>(data[i]);
+		result *= 1099511628211ULL;
+	}
+	return result;
+}
@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROGRAM_CACHE_H_
+#define PROGRAM_CACHE_H_
+
+#include <cstdint>
+#include <string>
+
+class Driver;
+class StatementBlock;
+
+/**
+ * An on-disk cache of parsed scripts. The syntax tree of a script is stored in
+ * a .nwtc file keyed by a hash of the script's contents, so that later runs can
+ * load the tree instead of parsing the script again.
+ *
+ * A cache file is written next to the script (script.nwt is cached as
+ * script.nwtc), or, given a cache directory, in that directory under the hash
+ * of the script. Cache files that are stale, truncated or written by a
+ * different version of the format are ignored, and replaced on the next store.
+ *
+ * Only the syntax tree is cached: semantic analysis populates execution
+ * contexts that live only as long as a run, so it is repeated on every run.
+ */
+class ProgramCache {
+public:
+	/**
+	 * Create a cache for the given script. If the cache directory is empty, the
+	 * cache file is written next to the script.
+	 */
+	ProgramCache(const std::string& file_name,
+			const std::string& cache_directory);
+	virtual ~ProgramCache();
+
+	/**
+	 * Load the cached syntax tree of the script into the given driver, as
+	 * though the driver had parsed the script. Returns false if there is no
+	 * valid cache file for the script's current contents.
+	 */
+	const bool Load(Driver& driver) const;
+
+	/**
+	 * Store the syntax tree of the script, which must not have been
+	 * preprocessed. Returns false if the tree could not be stored; this is not
+	 * an error, but the next run will have to parse the script again.
+	 */
+	const bool Store(const StatementBlock& block) const;
+
+	const std::string& GetCacheFileName() const {
+		return m_cache_file_name;
+	}
+
+	/**
+	 * The 64-bit FNV-1a hash of the given data.
+	 */
+	static const uint64_t Hash(const char* data, const size_t size);
+
+private:
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint64_t source_hash;
+		uint64_t source_size;
+		uint64_t data_hash;
+		uint64_t data_size;
+	};
+
+	static const char MAGIC[4];
+	static const uint32_t VERSION;
+
+	bool m_source_read;
+	uint64_t m_source_hash;
+	uint64_t m_source_size;
+	std::string m_cache_file_name;
+};
+
+#endif /* PROGRAM_CACHE_H_ */
@@ -20,15 +20,19 @@
 #ifndef RESULT_H_
 #define RESULT_H_
 
+#include <value.h>
+#include <statistics.h>
+
 class Error;
 
 class Result {
 public:
-	Result(const_shared_ptr<void> data, const ErrorListRef errors) :
+	Result(const Value& data, const ErrorListRef errors) :
 			m_data(data), m_errors(errors) {
+		STATISTICS_INCREMENT(RESULTS);
 	}
 
-	const_shared_ptr<void> GetData() const {
+	const Value& GetData() const {
 		return m_data;
 	}
 
@@ -37,7 +41,7 @@ public:
 	}
 
 private:
-	const_shared_ptr<void> m_data;
+	const Value m_data;
 	const ErrorListRef m_errors;
 };
 
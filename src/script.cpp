@@ -0,0 +1,293 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <script.h>
+#include <cycle_collector.h>
+#include <driver.h>
+#include <error.h>
+#include <execution_context.h>
+#include <function.h>
+#include <function_declaration.h>
+#include <primitive_type_specifier.h>
+#include <statement_block.h>
+#include <symbol.h>
+#include <utils.h>
+#include <virtual_machine.h>
+
+static void AppendErrors(ErrorListRef errors,
+		std::vector<std::string>& messages) {
+	//errors come to us in reverse order
+	auto reversed = ErrorList::Reverse(errors);
+	for (auto error : *reversed) {
+		messages.push_back(error->ToString());
+	}
+}
+
+static const BasicType GetBasicType(const_shared_ptr<TypeSpecifier> type) {
+	auto as_primitive = specifier_cast<PrimitiveTypeSpecifier>(type);
+	if (as_primitive) {
+		return as_primitive->GetBasicType();
+	}
+	return NONE;
+}
+
+ScriptValue::ScriptValue() :
+		m_type(NONE), m_string_value() {
+	m_double_value = 0;
+}
+
+ScriptValue::ScriptValue(const bool value) :
+		m_type(BOOLEAN), m_string_value() {
+	m_double_value = 0;
+	m_int_value = value;
+}
+
+ScriptValue::ScriptValue(const int value) :
+		m_type(INT), m_string_value() {
+	m_double_value = 0;
+	m_int_value = value;
+}
+
+ScriptValue::ScriptValue(const double value) :
+		m_type(DOUBLE), m_string_value() {
+	m_double_value = value;
+}
+
+ScriptValue::ScriptValue(const char* value) :
+		ScriptValue(std::make_shared<const std::string>(value)) {
+}
+
+ScriptValue::ScriptValue(const std::string& value) :
+		ScriptValue(std::make_shared<const std::string>(value)) {
+}
+
+ScriptValue::ScriptValue(const std::shared_ptr<const std::string> value) :
+		m_type(STRING), m_string_value(value) {
+	m_double_value = 0;
+}
+
+const std::string ScriptValue::ToString() const {
+	switch (m_type) {
+	case BOOLEAN:
+		return *AsString(GetBoolean());
+	case INT:
+		return *AsString(m_int_value);
+	case DOUBLE:
+		return *AsString(m_double_value);
+	case STRING:
+		return *m_string_value;
+	default:
+		return "";
+	}
+}
+
+Script::Script(std::unique_ptr<Driver> driver) :
+		m_driver(std::move(driver)), m_collector(new CycleCollector()),
+		m_virtual_machine(new VirtualMachine()), m_root_context(
+				make_shared<ExecutionContext>()) {
+}
+
+Script::~Script() {
+	//reclaim the cycles left over once the script's state is released, while
+	//the syntax tree they refer to still exists. the script's collector has
+	//tracked the frames captured on every thread that ran the script
+	CycleCollector::Scope scope(*m_collector);
+	m_root_context = nullptr;
+	m_virtual_machine = nullptr;
+	m_collector->Collect();
+}
+
+const std::shared_ptr<Script> Script::Load(const std::string& file_name,
+		std::vector<std::string>& errors, const bool optimize) {
+	std::unique_ptr<Driver> driver(new Driver());
+	const int parse_result = driver->parse(file_name, NO_TRACE);
+	if (parse_result != 0 || driver->GetErrorCount() != 0) {
+		//the parse errors themselves have been reported by the driver
+		errors.push_back(
+				"Unable to parse '" + file_name + "': "
+						+ std::to_string(driver->GetErrorCount())
+						+ " error(s) found.");
+		return nullptr;
+	}
+
+	auto block = driver->GetStatementBlock();
+	std::shared_ptr<Script> script(new Script(std::move(driver)));
+	CycleCollector::Scope scope(*script->m_collector);
+
+	ErrorListRef semantic_errors = block->preprocess(script->m_root_context);
+	if (!ErrorList::IsTerminator(semantic_errors)) {
+		AppendErrors(semantic_errors, errors);
+		return nullptr;
+	}
+
+	if (optimize) {
+		block->optimize(script->m_root_context);
+	}
+
+	ErrorListRef execution_errors = script->m_virtual_machine->Execute(*block,
+			script->m_root_context);
+	if (!ErrorList::IsTerminator(execution_errors)) {
+		AppendErrors(execution_errors, errors);
+		return nullptr;
+	}
+
+	return script;
+}
+
+const std::shared_ptr<ScriptFunction> Script::GetFunction(
+		const std::string& name) {
+	auto symbol = m_root_context->GetSymbol(Atom(name), SHALLOW);
+	if (symbol == Symbol::GetDefaultSymbol()
+			|| !specifier_cast<FunctionTypeSpecifier>(symbol->GetType())) {
+		return nullptr;
+	}
+
+	auto function = symbol->GetValue().GetReference<Function>();
+	std::vector<BasicType> parameter_types;
+	TypeSpecifierListRef parameter =
+			function->GetType()->GetParameterTypeList();
+	while (!TypeSpecifierList::IsTerminator(parameter)) {
+		const BasicType parameter_type = GetBasicType(parameter->GetData());
+		if (parameter_type == NONE) {
+			return nullptr;
+		}
+
+		parameter_types.push_back(parameter_type);
+		parameter = parameter->GetNext();
+	}
+
+	const BasicType return_type = GetBasicType(
+			function->GetType()->GetReturnType());
+	if (return_type == NONE) {
+		return nullptr;
+	}
+
+	return std::shared_ptr<ScriptFunction>(
+			new ScriptFunction(shared_from_this(), function,
+					make_shared<std::string>(name), parameter_types,
+					return_type));
+}
+
+const std::shared_ptr<const int> Script::GetExitCode() const {
+	return m_root_context->GetExitCode();
+}
+
+ScriptFunction::ScriptFunction(const std::shared_ptr<Script> script,
+		const std::shared_ptr<const Function> function,
+		const std::shared_ptr<const std::string> name,
+		const std::vector<BasicType>& parameter_types,
+		const BasicType return_type) :
+		m_script(script), m_function(function), m_name(name), m_parameter_types(
+				parameter_types), m_return_type(return_type), m_call_sites() {
+	//arguments are converted to the parameter types before the call
+	for (size_t count = 0; count <= parameter_types.size(); count++) {
+		std::vector<BasicType> argument_types(parameter_types.begin(),
+				parameter_types.begin() + count);
+		m_call_sites.emplace_back(
+				new CallSite(argument_types, return_type, name, 0));
+	}
+}
+
+ScriptFunction::~ScriptFunction() {
+}
+
+const bool ScriptFunction::Call(const std::vector<ScriptValue>& arguments,
+		ScriptValue& result, std::vector<std::string>& errors) {
+	if (arguments.size() > m_parameter_types.size()) {
+		errors.push_back(
+				"Too many arguments in call to '" + *m_name
+						+ "': expected at most "
+						+ std::to_string(m_parameter_types.size()) + ", got "
+						+ std::to_string(arguments.size()) + ".");
+		return false;
+	}
+
+	std::vector<Register> registers(arguments.size());
+	for (size_t i = 0; i < arguments.size(); i++) {
+		const ScriptValue& argument = arguments[i];
+		const BasicType argument_type = argument.GetType();
+		const BasicType parameter_type = m_parameter_types[i];
+		if (argument_type == NONE) {
+			errors.push_back(
+					"Argument " + std::to_string(i + 1) + " in call to '"
+							+ *m_name + "' has no value.");
+			return false;
+		}
+
+		if (argument_type > parameter_type) {
+			errors.push_back(
+					"Argument " + std::to_string(i + 1) + " in call to '"
+							+ *m_name + "' is of type "
+							+ type_to_string(argument_type)
+							+ ", which cannot be assigned to a parameter"
+							+ " of type " + type_to_string(parameter_type)
+							+ ".");
+			return false;
+		}
+
+		//widen the argument as an assignment would
+		Register& target = registers[i];
+		switch (parameter_type) {
+		case BOOLEAN:
+		case INT:
+			target.int_value = argument.GetInt();
+			break;
+		case DOUBLE:
+			target.double_value =
+					argument_type == DOUBLE ?
+							argument.GetDouble() : argument.GetInt();
+			break;
+		default:
+			target.reference =
+					argument_type == STRING ?
+							argument.GetString() :
+							make_shared<std::string>(argument.ToString());
+			break;
+		}
+	}
+
+	Register value;
+	CycleCollector::Scope scope(*m_script->m_collector);
+	ErrorListRef call_errors = m_script->m_virtual_machine->Call(*m_function,
+			*m_call_sites[arguments.size()], registers.data(), value,
+			m_script->m_root_context);
+	if (!ErrorList::IsTerminator(call_errors)) {
+		AppendErrors(call_errors, errors);
+		return false;
+	}
+
+	switch (m_return_type) {
+	case BOOLEAN:
+		result = ScriptValue(value.int_value != 0);
+		break;
+	case INT:
+		result = ScriptValue(value.int_value);
+		break;
+	case DOUBLE:
+		result = ScriptValue(value.double_value);
+		break;
+	default:
+		auto string_value = static_pointer_cast<const string>(value.reference);
+		result = ScriptValue(
+				string_value ? string_value : make_shared<const string>());
+		break;
+	}
+
+	return true;
+}
@@ -0,0 +1,190 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPT_H_
+#define SCRIPT_H_
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <type.h>
+
+class CycleCollector;
+class Driver;
+class ExecutionContext;
+class VirtualMachine;
+class Function;
+struct CallSite;
+class ScriptFunction;
+
+/**
+ * A primitive value passed to or returned from a script function.
+ */
+class ScriptValue {
+public:
+	ScriptValue();
+	ScriptValue(const bool value);
+	ScriptValue(const int value);
+	ScriptValue(const double value);
+	ScriptValue(const char* value);
+	ScriptValue(const std::string& value);
+	ScriptValue(const std::shared_ptr<const std::string> value);
+
+	/**
+	 * The type of the value, or NONE for a value that was never assigned.
+	 */
+	const BasicType GetType() const {
+		return m_type;
+	}
+
+	const bool GetBoolean() const {
+		return m_int_value != 0;
+	}
+
+	const int GetInt() const {
+		return m_int_value;
+	}
+
+	const double GetDouble() const {
+		return m_double_value;
+	}
+
+	const std::shared_ptr<const std::string> GetString() const {
+		return m_string_value;
+	}
+
+	const std::string ToString() const;
+
+private:
+	BasicType m_type;
+	union {
+		int m_int_value;
+		double m_double_value;
+	};
+	std::shared_ptr<const std::string> m_string_value;
+};
+
+/**
+ * A script that has been parsed, analyzed and run once, for embedding newt in
+ * another program.
+ *
+ * Loading a script executes its top-level statements, which declare its
+ * functions and global state. The functions can then be looked up by name and
+ * called any number of times; each call runs the function on the bytecode
+ * virtual machine, which compiles the function's body on the first call only.
+ *
+ * The state of a script is shared by all calls of its functions. A script is
+ * kept alive by the functions looked up in it.
+ *
+ * Scripts share nothing mutable with each other, so different scripts may be
+ * loaded and called on different threads at the same time. A single script,
+ * along with its functions, must only be used by one thread at a time.
+ */
+class Script: public std::enable_shared_from_this<Script> {
+public:
+	virtual ~Script();
+
+	/**
+	 * Load the script in the given file. Returns null, having appended
+	 * descriptions of what went wrong to the given list of errors, if the
+	 * script cannot be parsed, fails semantic analysis, or fails to run.
+	 */
+	static const std::shared_ptr<Script> Load(const std::string& file_name,
+			std::vector<std::string>& errors, const bool optimize = true);
+
+	/**
+	 * Look up a top-level function. Returns null if the script has no such
+	 * function, or if any of the function's parameters or its return type is
+	 * not a primitive type.
+	 */
+	const std::shared_ptr<ScriptFunction> GetFunction(
+			const std::string& name);
+
+	/**
+	 * The exit code set by an exit statement, or null if none has run.
+	 */
+	const std::shared_ptr<const int> GetExitCode() const;
+
+private:
+	friend class ScriptFunction;
+
+	Script(std::unique_ptr<Driver> driver);
+
+	//declared first, so that the syntax tree outlives all that refers to it
+	std::unique_ptr<Driver> m_driver;
+	//tracks the frames captured by calls of the script on any thread
+	std::unique_ptr<CycleCollector> m_collector;
+	std::unique_ptr<VirtualMachine> m_virtual_machine;
+	std::shared_ptr<ExecutionContext> m_root_context;
+};
+
+/**
+ * A top-level function of a loaded script.
+ */
+class ScriptFunction {
+public:
+	virtual ~ScriptFunction();
+
+	const std::string& GetName() const {
+		return *m_name;
+	}
+
+	/**
+	 * The types of the function's parameters.
+	 */
+	const std::vector<BasicType>& GetParameterTypes() const {
+		return m_parameter_types;
+	}
+
+	const BasicType GetReturnType() const {
+		return m_return_type;
+	}
+
+	/**
+	 * Call the function. Each argument must be assignable to the type of its
+	 * parameter, and is widened to that type as it would be in a script;
+	 * trailing parameters without an argument take their default values.
+	 * Returns false, having appended descriptions of what went wrong to the
+	 * given list of errors, if the arguments do not match the parameters or
+	 * the call fails.
+	 */
+	const bool Call(const std::vector<ScriptValue>& arguments,
+			ScriptValue& result, std::vector<std::string>& errors);
+
+private:
+	friend class Script;
+
+	ScriptFunction(const std::shared_ptr<Script> script,
+			const std::shared_ptr<const Function> function,
+			const std::shared_ptr<const std::string> name,
+			const std::vector<BasicType>& parameter_types,
+			const BasicType return_type);
+
+	//declared first, so that the script outlives the function
+	const std::shared_ptr<Script> m_script;
+	const std::shared_ptr<const Function> m_function;
+	const std::shared_ptr<const std::string> m_name;
+	const std::vector<BasicType> m_parameter_types;
+	const BasicType m_return_type;
+
+	//one call site for each number of arguments the function may be called with
+	std::vector<std::unique_ptr<const CallSite>> m_call_sites;
+};
+
+#endif /* SCRIPT_H_ */
@@ -19,7 +19,8 @@
 
 #include <array_type_specifier.h>
 #include <array.h>
-#include <typeinfo>
+#include <mutex>
+#include <unordered_map>
 #include <array_declaration_statement.h>
 #include <expression.h>
 #include <sum_type_specifier.h>
@@ -32,14 +33,36 @@ const string ArrayTypeSpecifier::ToString() const {
 	return buffer.str();
 }
 
+const_shared_ptr<ArrayTypeSpecifier> ArrayTypeSpecifier::Get(
+		const_shared_ptr<TypeSpecifier> element_type_specifier) {
+	if (!element_type_specifier->IsCanonical()) {
+		return const_shared_ptr<ArrayTypeSpecifier>(
+				new ArrayTypeSpecifier(element_type_specifier, false));
+	}
+
+	static std::mutex mutex;
+	static unordered_map<const TypeSpecifier*,
+			plain_shared_ptr<ArrayTypeSpecifier>> instances;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& instance = instances[element_type_specifier.get()];
+	if (!instance) {
+		instance = plain_shared_ptr<ArrayTypeSpecifier>(
+				new ArrayTypeSpecifier(element_type_specifier, true));
+	}
+	return instance;
+}
+
 bool ArrayTypeSpecifier::operator ==(const TypeSpecifier& other) const {
-	try {
-		const ArrayTypeSpecifier& as_array =
-				dynamic_cast<const ArrayTypeSpecifier&>(other);
-		return *GetElementTypeSpecifier() == *as_array.GetElementTypeSpecifier();
-	} catch (std::bad_cast& e) {
+	if (this == &other) {
+		return true;
+	}
+
+	if (other.GetKind() != ARRAY) {
 		return false;
 	}
+
+	auto& as_array = static_cast<const ArrayTypeSpecifier&>(other);
+	return *m_element_type_specifier == *as_array.m_element_type_specifier;
 }
 
 const_shared_ptr<DeclarationStatement> ArrayTypeSpecifier::GetDeclarationStatement(
@@ -52,23 +75,23 @@ const_shared_ptr<DeclarationStatement> ArrayTypeSpecifier::GetDeclarationStateme
 			name, name_position, initializer_expression);
 }
 
-const_shared_ptr<void> ArrayTypeSpecifier::DefaultValue(
+const Value ArrayTypeSpecifier::DefaultValue(
 		const TypeTable& type_table) const {
-	return const_shared_ptr<void>(
-			new Array(m_element_type_specifier, type_table));
+	return Array::Create(m_element_type_specifier);
 }
 
-const bool ArrayTypeSpecifier::IsAssignableTo(
+const bool ArrayTypeSpecifier::ComputeAssignableTo(
 		const_shared_ptr<TypeSpecifier> other) const {
-	const_shared_ptr<SumTypeSpecifier> as_sum = dynamic_pointer_cast<
-			const SumTypeSpecifier>(other);
-	if (as_sum) {
-		return as_sum->ContainsType(*this, ALLOW_WIDENING);
+	switch (other->GetKind()) {
+	case SUM:
+		return static_cast<const SumTypeSpecifier&>(*other).ContainsType(*this,
+				ALLOW_WIDENING);
+	case ARRAY: {
+		auto& as_array = static_cast<const ArrayTypeSpecifier&>(*other);
+		return m_element_type_specifier->IsAssignableTo(
+				as_array.GetElementTypeSpecifier());
+	}
+	default:
+		return false;
 	}
-
-	const_shared_ptr<ArrayTypeSpecifier> as_array = std::dynamic_pointer_cast<
-			const ArrayTypeSpecifier>(other);
-	return as_array
-			&& m_element_type_specifier->IsAssignableTo(
-					as_array->GetElementTypeSpecifier());
 }
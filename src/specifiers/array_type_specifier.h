@@ -28,19 +28,19 @@ class Statement;
 using namespace std;
 class ArrayTypeSpecifier: public TypeSpecifier {
 public:
-	ArrayTypeSpecifier(const_shared_ptr<TypeSpecifier> element_type_specifier) :
-			m_element_type_specifier(element_type_specifier) {
-	}
+	/**
+	 * Get the specifier of arrays of the given element type. The result is canonical
+	 * if the element type is.
+	 */
+	static const_shared_ptr<ArrayTypeSpecifier> Get(
+			const_shared_ptr<TypeSpecifier> element_type_specifier);
 
 	virtual ~ArrayTypeSpecifier() {
 	}
 
 	virtual const string ToString() const;
 
-	virtual const bool IsAssignableTo(
-			const_shared_ptr<TypeSpecifier> other) const;
-
-	virtual const_shared_ptr<void> DefaultValue(
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const;
 
 	virtual bool operator==(const TypeSpecifier& other) const;
@@ -55,8 +55,22 @@ public:
 			const yy::location name_position,
 			const_shared_ptr<Expression> initializer_expression) const;
 
+protected:
+	virtual const bool ComputeAssignableTo(
+			const_shared_ptr<TypeSpecifier> other) const;
+
 private:
+	ArrayTypeSpecifier(const_shared_ptr<TypeSpecifier> element_type_specifier,
+			const bool canonical) :
+			TypeSpecifier(ARRAY, canonical ? this : nullptr), m_element_type_specifier(
+					element_type_specifier) {
+	}
+
 	const_shared_ptr<TypeSpecifier> m_element_type_specifier;
 };
 
+template<> struct SpecifierKind<ArrayTypeSpecifier> {
+	static const TypeSpecifier::Kind value = TypeSpecifier::ARRAY;
+};
+
 #endif /* ARRAY_TYPE_SPECIFIER_H_ */
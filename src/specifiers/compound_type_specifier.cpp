@@ -18,19 +18,28 @@
  */
 
 #include <compound_type_specifier.h>
-#include <typeinfo>
+#include <mutex>
+#include <unordered_map>
 #include <struct_instantiation_statement.h>
 #include <expression.h>
 #include <sum_type_specifier.h>
 
-bool CompoundTypeSpecifier::operator ==(const TypeSpecifier& other) const {
-	try {
-		const CompoundTypeSpecifier& as_compound =
-				dynamic_cast<const CompoundTypeSpecifier&>(other);
-		return GetTypeName() == as_compound.GetTypeName();
-	} catch (std::bad_cast& e) {
-		return false;
+const_shared_ptr<CompoundTypeSpecifier> CompoundTypeSpecifier::Get(
+		const Atom& type_name) {
+	static std::mutex mutex;
+	static unordered_map<Atom, plain_shared_ptr<CompoundTypeSpecifier>> instances;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& instance = instances[type_name];
+	if (!instance) {
+		instance = plain_shared_ptr<CompoundTypeSpecifier>(
+				new CompoundTypeSpecifier(type_name));
 	}
+	return instance;
+}
+
+bool CompoundTypeSpecifier::operator ==(const TypeSpecifier& other) const {
+	//compound specifiers are interned by name
+	return this == &other;
 }
 
 const_shared_ptr<DeclarationStatement> CompoundTypeSpecifier::GetDeclarationStatement(
@@ -43,15 +52,15 @@ const_shared_ptr<DeclarationStatement> CompoundTypeSpecifier::GetDeclarationStat
 			type_position, name, name_position, initializer_expression);
 }
 
-const bool CompoundTypeSpecifier::IsAssignableTo(
+const bool CompoundTypeSpecifier::ComputeAssignableTo(
 		const_shared_ptr<TypeSpecifier> other) const {
-	const_shared_ptr<SumTypeSpecifier> as_sum = dynamic_pointer_cast<
-			const SumTypeSpecifier>(other);
-	if (as_sum) {
-		return as_sum->ContainsType(*this, ALLOW_WIDENING);
+	switch (other->GetKind()) {
+	case SUM:
+		return static_cast<const SumTypeSpecifier&>(*other).ContainsType(*this,
+				ALLOW_WIDENING);
+	case COMPOUND:
+		return this == other.get();
+	default:
+		return false;
 	}
-
-	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(other);
-	return as_compound && as_compound->GetTypeName().compare(m_type_name) == 0;
 }
@@ -30,22 +30,28 @@ class SymbolContext;
 
 class CompoundTypeSpecifier: public TypeSpecifier {
 public:
-	CompoundTypeSpecifier(const string& type_name) :
-			m_type_name(type_name) {
-	}
+	/**
+	 * Get the specifier of the named struct type, which is always canonical.
+	 */
+	static const_shared_ptr<CompoundTypeSpecifier> Get(const Atom& type_name);
+
 	virtual ~CompoundTypeSpecifier() {
 	}
 
-	const string GetTypeName() const {
-		return m_type_name;
+	const string& GetTypeName() const {
+		return m_type_name.GetName();
 	}
 
-	virtual const string ToString() const {
+	/**
+	 * The interned type name, which lookups and comparisons should use.
+	 */
+	const Atom& GetTypeAtom() const {
 		return m_type_name;
 	}
 
-	virtual const bool IsAssignableTo(
-			const_shared_ptr<TypeSpecifier> other) const;
+	virtual const string ToString() const {
+		return m_type_name.GetName();
+	}
 
 	virtual const_shared_ptr<DeclarationStatement> GetDeclarationStatement(
 			const yy::location position, const_shared_ptr<TypeSpecifier> type,
@@ -53,15 +59,27 @@ public:
 			const yy::location name_position,
 			const_shared_ptr<Expression> initializer_expression) const;
 
-	virtual const_shared_ptr<void> DefaultValue(
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const {
 		return type_table.GetDefaultValue(m_type_name); //this result cannot be cached because the type table is mutable
 	}
 
 	virtual bool operator==(const TypeSpecifier& other) const;
 
+protected:
+	virtual const bool ComputeAssignableTo(
+			const_shared_ptr<TypeSpecifier> other) const;
+
 private:
-	const string m_type_name;
+	CompoundTypeSpecifier(const Atom& type_name) :
+			TypeSpecifier(COMPOUND, this), m_type_name(type_name) {
+	}
+
+	const Atom m_type_name;
+};
+
+template<> struct SpecifierKind<CompoundTypeSpecifier> {
+	static const TypeSpecifier::Kind value = TypeSpecifier::COMPOUND;
 };
 
 #endif /* SPECIFIERS_COMPOUND_TYPE_SPECIFIER_H_ */
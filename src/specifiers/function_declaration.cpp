@@ -31,13 +31,17 @@
 
 FunctionDeclaration::FunctionDeclaration(DeclarationListRef parameter_list,
 		const_shared_ptr<TypeSpecifier> return_type) :
-		FunctionTypeSpecifier(GetTypeList(parameter_list), return_type), m_parameter_list(
-				parameter_list) {
+		FunctionTypeSpecifier(GetTypeList(parameter_list), return_type,
+				FunctionTypeSpecifier::Get(GetTypeList(parameter_list),
+						return_type)), m_parameter_list(parameter_list) {
 }
 
 FunctionDeclaration::FunctionDeclaration(const FunctionDeclaration& other) :
 		FunctionTypeSpecifier(other.GetParameterTypeList(),
-				other.GetReturnType()), m_parameter_list(other.m_parameter_list) {
+				other.GetReturnType(),
+				FunctionTypeSpecifier::Get(other.GetParameterTypeList(),
+						other.GetReturnType())), m_parameter_list(
+				other.m_parameter_list) {
 }
 
 FunctionDeclaration::~FunctionDeclaration() {
@@ -67,7 +71,7 @@ const_shared_ptr<FunctionDeclaration> FunctionDeclaration::FromTypeSpecifier(
 			type_specifier.GetReturnType());
 }
 
-const_shared_ptr<void> FunctionDeclaration::DefaultValue(
+const Value FunctionDeclaration::DefaultValue(
 		const TypeTable& type_table) const {
 	return GetDefaultFunctionDeclaration(*this, type_table);
 }
@@ -33,7 +33,7 @@ public:
 	static const_shared_ptr<FunctionDeclaration> FromTypeSpecifier(
 			const FunctionTypeSpecifier& type_specifier);
 
-	virtual const_shared_ptr<void> DefaultValue(
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const;
 
 	virtual const_shared_ptr<DeclarationStatement> GetDeclarationStatement(
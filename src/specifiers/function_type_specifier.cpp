@@ -18,7 +18,9 @@
  */
 
 #include <function_type_specifier.h>
-#include <typeinfo>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <declaration_statement.h>
 #include <sstream>
 #include <assert.h>
@@ -34,13 +36,57 @@
 
 FunctionTypeSpecifier::FunctionTypeSpecifier(
 		TypeSpecifierListRef parameter_type_list,
-		const_shared_ptr<TypeSpecifier> return_type) :
-		m_parameter_type_list(parameter_type_list), m_return_type(return_type) {
+		const_shared_ptr<TypeSpecifier> return_type, const bool canonical) :
+		TypeSpecifier(FUNCTION, canonical ? this : nullptr), m_parameter_type_list(
+				parameter_type_list), m_return_type(return_type) {
 }
 
-FunctionTypeSpecifier::FunctionTypeSpecifier(const FunctionTypeSpecifier& other) :
-		m_parameter_type_list(other.m_parameter_type_list), m_return_type(
-				other.m_return_type) {
+FunctionTypeSpecifier::FunctionTypeSpecifier(
+		TypeSpecifierListRef parameter_type_list,
+		const_shared_ptr<TypeSpecifier> return_type,
+		const_shared_ptr<FunctionTypeSpecifier> type) :
+		TypeSpecifier(FUNCTION, type->GetCanonical()), m_parameter_type_list(
+				parameter_type_list), m_return_type(return_type) {
+}
+
+const_shared_ptr<FunctionTypeSpecifier> FunctionTypeSpecifier::Get(
+		TypeSpecifierListRef parameter_type_list,
+		const_shared_ptr<TypeSpecifier> return_type) {
+	//a signature is identified by its canonical return and parameter types, in order
+	std::vector<plain_shared_ptr<TypeSpecifier>> types;
+	types.push_back(return_type);
+	TypeSpecifierListRef subject = parameter_type_list;
+	while (!TypeSpecifierList::IsTerminator(subject)) {
+		types.push_back(subject->GetData());
+		subject = subject->GetNext();
+	}
+
+	std::vector<const TypeSpecifier*> key;
+	for (auto iter = types.begin(); iter != types.end(); ++iter) {
+		if (!(*iter)->IsCanonical()) {
+			return const_shared_ptr<FunctionTypeSpecifier>(
+					new FunctionTypeSpecifier(parameter_type_list, return_type,
+							false));
+		}
+		key.push_back(iter->get());
+	}
+
+	static std::mutex mutex;
+	static std::map<std::vector<const TypeSpecifier*>,
+			plain_shared_ptr<FunctionTypeSpecifier>> instances;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& instance = instances[key];
+	if (!instance) {
+		//the given list may belong to a parse; the canonical specifier needs its own
+		TypeSpecifierListRef canonical_list = TypeSpecifierList::GetTerminator();
+		for (auto iter = types.rbegin(); iter != types.rend() - 1; ++iter) {
+			canonical_list = TypeSpecifierList::From(*iter, canonical_list);
+		}
+
+		instance = plain_shared_ptr<FunctionTypeSpecifier>(
+				new FunctionTypeSpecifier(canonical_list, return_type, true));
+	}
+	return instance;
 }
 
 FunctionTypeSpecifier::~FunctionTypeSpecifier() {
@@ -64,49 +110,52 @@ const string FunctionTypeSpecifier::ToString() const {
 	return buffer.str();
 }
 
-const bool FunctionTypeSpecifier::IsAssignableTo(
+const bool FunctionTypeSpecifier::ComputeAssignableTo(
 		const_shared_ptr<TypeSpecifier> other) const {
-	const_shared_ptr<SumTypeSpecifier> as_sum = dynamic_pointer_cast<
-			const SumTypeSpecifier>(other);
-	if (as_sum) {
-		return as_sum->ContainsType(*this, ALLOW_WIDENING);
+	if (other->GetKind() == SUM) {
+		return static_cast<const SumTypeSpecifier&>(*other).ContainsType(*this,
+				ALLOW_WIDENING);
 	}
 
 	return *this == *other;
 }
 
-const_shared_ptr<void> FunctionTypeSpecifier::DefaultValue(
+const Value FunctionTypeSpecifier::DefaultValue(
 		const TypeTable& type_table) const {
-	const static const_shared_ptr<void> default_value = GetDefaultFunction(
-			*this, type_table);
-	return default_value;
+	//not cached statically: the default depends on this specifier's signature,
+	//and must not outlive the nodes of the program that declared it
+	return GetDefaultFunction(*this, type_table);
 }
 
 bool FunctionTypeSpecifier::operator ==(const TypeSpecifier& other) const {
-	try {
-		const FunctionTypeSpecifier& as_function =
-				dynamic_cast<const FunctionTypeSpecifier&>(other);
-		if (*m_return_type == *as_function.GetReturnType()) {
-			TypeSpecifierListRef subject = m_parameter_type_list;
-			TypeSpecifierListRef other_subject =
-					as_function.GetParameterTypeList();
-			while (!TypeSpecifierList::IsTerminator(subject)) {
-				const_shared_ptr<TypeSpecifier> type = subject->GetData();
-				const_shared_ptr<TypeSpecifier> other_type =
-						other_subject->GetData();
-				if (*type == *other_type) {
-					subject = subject->GetNext();
-					other_subject = other_subject->GetNext();
-				} else {
-					return false;
-				}
-			}
+	const TypeSpecifier* canonical = GetCanonical();
+	if (canonical && canonical == other.GetCanonical()) {
+		return true;
+	}
 
-			return true;
-		} else {
-			return false;
+	if (other.GetKind() != FUNCTION) {
+		return false;
+	}
+
+	const FunctionTypeSpecifier& as_function =
+			static_cast<const FunctionTypeSpecifier&>(other);
+	if (*m_return_type == *as_function.GetReturnType()) {
+		TypeSpecifierListRef subject = m_parameter_type_list;
+		TypeSpecifierListRef other_subject = as_function.GetParameterTypeList();
+		while (!TypeSpecifierList::IsTerminator(subject)) {
+			const_shared_ptr<TypeSpecifier> type = subject->GetData();
+			const_shared_ptr<TypeSpecifier> other_type =
+					other_subject->GetData();
+			if (*type == *other_type) {
+				subject = subject->GetNext();
+				other_subject = other_subject->GetNext();
+			} else {
+				return false;
+			}
 		}
-	} catch (std::bad_cast& e) {
+
+		return true;
+	} else {
 		return false;
 	}
 }
@@ -29,15 +29,18 @@ class Function;
 
 class FunctionTypeSpecifier: public TypeSpecifier {
 public:
-	FunctionTypeSpecifier(TypeSpecifierListRef parameter_type_list,
+	/**
+	 * Get the specifier of functions with the given signature. The result is
+	 * canonical if the parameter and return types are.
+	 */
+	static const_shared_ptr<FunctionTypeSpecifier> Get(
+			TypeSpecifierListRef parameter_type_list,
 			const_shared_ptr<TypeSpecifier> return_type);
-	FunctionTypeSpecifier(const FunctionTypeSpecifier& other);
+
 	virtual ~FunctionTypeSpecifier();
 
 	virtual const string ToString() const;
-	virtual const bool IsAssignableTo(
-			const_shared_ptr<TypeSpecifier> other) const;
-	virtual const_shared_ptr<void> DefaultValue(
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const;
 
 	virtual bool operator==(const TypeSpecifier &other) const;
@@ -56,6 +59,17 @@ public:
 		return m_return_type;
 	}
 protected:
+	/**
+	 * Create a specifier that is not canonical itself, but has the canonical
+	 * specifier of the given type (if any).
+	 */
+	FunctionTypeSpecifier(TypeSpecifierListRef parameter_type_list,
+			const_shared_ptr<TypeSpecifier> return_type,
+			const_shared_ptr<FunctionTypeSpecifier> type);
+
+	virtual const bool ComputeAssignableTo(
+			const_shared_ptr<TypeSpecifier> other) const;
+
 	static const_shared_ptr<StatementBlock> GetDefaultStatementBlock(
 			const_shared_ptr<TypeSpecifier> return_type,
 			const TypeTable& type_table);
@@ -65,8 +79,15 @@ protected:
 			const TypeTable& type_table);
 
 private:
+	FunctionTypeSpecifier(TypeSpecifierListRef parameter_type_list,
+			const_shared_ptr<TypeSpecifier> return_type, const bool canonical);
+
 	TypeSpecifierListRef m_parameter_type_list;
 	const_shared_ptr<TypeSpecifier> m_return_type;
 };
 
+template<> struct SpecifierKind<FunctionTypeSpecifier> {
+	static const TypeSpecifier::Kind value = TypeSpecifier::FUNCTION;
+};
+
 #endif /* FUNCTION_TYPE_SPECIFIER_H_ */
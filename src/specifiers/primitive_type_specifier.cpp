@@ -24,28 +24,21 @@
 #include <sum_type_specifier.h>
 #include <memory>
 
-const string PrimitiveTypeSpecifier::ToString(
-		const_shared_ptr<void> value) const {
+const string PrimitiveTypeSpecifier::ToString(const Value& value) const {
 	ostringstream buffer;
 	const BasicType type = GetBasicType();
 	switch (type) {
 	case BasicType::BOOLEAN:
 	case BasicType::INT: {
-		const_shared_ptr<int> default_value = static_pointer_cast<const int>(
-				value);
-		buffer << *default_value;
+		buffer << value.GetInt();
 		break;
 	}
 	case BasicType::DOUBLE: {
-		const_shared_ptr<double> default_value = static_pointer_cast<
-				const double>(value);
-		buffer << *default_value;
+		buffer << value.GetDouble();
 		break;
 	}
 	case BasicType::STRING: {
-		const_shared_ptr<string> default_value = static_pointer_cast<
-				const string>(value);
-		buffer << "\"" << *default_value << "\"";
+		buffer << "\"" << *(value.GetReference<string>()) << "\"";
 		break;
 	}
 	default:
@@ -55,81 +48,69 @@ const string PrimitiveTypeSpecifier::ToString(
 	return buffer.str();
 }
 
-const bool PrimitiveTypeSpecifier::IsAssignableTo(
+const bool PrimitiveTypeSpecifier::ComputeAssignableTo(
 		const_shared_ptr<TypeSpecifier> other) const {
-	const_shared_ptr<PrimitiveTypeSpecifier> other_as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(other);
-	if (other_as_primitive) {
-		const BasicType other_type = other_as_primitive->GetBasicType();
+	switch (other->GetKind()) {
+	case PRIMITIVE: {
+		const BasicType other_type = static_cast<const PrimitiveTypeSpecifier&>(
+				*other).GetBasicType();
 		return other_type != BasicType::NONE && m_basic_type <= other_type;
 	}
-
-	const_shared_ptr<SumTypeSpecifier> as_sum = dynamic_pointer_cast<
-			const SumTypeSpecifier>(other);
-	if (as_sum) {
-		return as_sum->ContainsType(*this, ALLOW_WIDENING);
+	case SUM:
+		return static_cast<const SumTypeSpecifier&>(*other).ContainsType(*this,
+				ALLOW_WIDENING);
+	default:
+		return false;
 	}
-
-	return false;
 }
 
-const_shared_ptr<void> PrimitiveTypeSpecifier::DefaultValue(
+const Value PrimitiveTypeSpecifier::DefaultValue(
 		const TypeTable& type_table) const {
 	const BasicType basic_type = GetBasicType();
 
 	switch (basic_type) {
 	case BasicType::BOOLEAN:
-		static const_shared_ptr<void> default_boolean_value = const_shared_ptr<
-				void>(new bool(false));
-		return default_boolean_value;
+		return Value(false);
 	case BasicType::INT:
-		static const_shared_ptr<void> default_int_value =
-				const_shared_ptr<void>(new int(0));
-		return default_int_value;
+		return Value(0);
 	case BasicType::DOUBLE:
-		static const_shared_ptr<void> default_double_value = const_shared_ptr<
-				void>(new double(0.0));
-		return default_double_value;
+		return Value(0.0);
 	case BasicType::STRING:
-		static const_shared_ptr<void> default_string_value = const_shared_ptr<
-				void>(new string(""));
+		static const Value default_string_value = const_shared_ptr<string>(
+				new string(""));
 		return default_string_value;
 	default:
 		assert(false);
-		return nullptr;
+		return Value();
 	}
 }
 
-const_shared_ptr<PrimitiveTypeSpecifier> PrimitiveTypeSpecifier::GetNone() {
-	static const_shared_ptr<PrimitiveTypeSpecifier> instance = const_shared_ptr<
-			PrimitiveTypeSpecifier>(
+const_shared_ptr<PrimitiveTypeSpecifier>& PrimitiveTypeSpecifier::GetNone() {
+	static const_shared_ptr<PrimitiveTypeSpecifier> instance = make_immortal(
 			new PrimitiveTypeSpecifier(BasicType::NONE));
 	return instance;
 }
 
-const_shared_ptr<PrimitiveTypeSpecifier> PrimitiveTypeSpecifier::GetBoolean() {
-	static const_shared_ptr<PrimitiveTypeSpecifier> instance = const_shared_ptr<
-			PrimitiveTypeSpecifier>(
+const_shared_ptr<PrimitiveTypeSpecifier>& PrimitiveTypeSpecifier::GetBoolean() {
+	static const_shared_ptr<PrimitiveTypeSpecifier> instance = make_immortal(
 			new PrimitiveTypeSpecifier(BasicType::BOOLEAN));
 	return instance;
 }
 
-const_shared_ptr<PrimitiveTypeSpecifier> PrimitiveTypeSpecifier::GetInt() {
-	static const_shared_ptr<PrimitiveTypeSpecifier> instance = const_shared_ptr<
-			PrimitiveTypeSpecifier>(new PrimitiveTypeSpecifier(BasicType::INT));
+const_shared_ptr<PrimitiveTypeSpecifier>& PrimitiveTypeSpecifier::GetInt() {
+	static const_shared_ptr<PrimitiveTypeSpecifier> instance = make_immortal(
+			new PrimitiveTypeSpecifier(BasicType::INT));
 	return instance;
 }
 
-const_shared_ptr<PrimitiveTypeSpecifier> PrimitiveTypeSpecifier::GetDouble() {
-	static const_shared_ptr<PrimitiveTypeSpecifier> instance = const_shared_ptr<
-			PrimitiveTypeSpecifier>(
+const_shared_ptr<PrimitiveTypeSpecifier>& PrimitiveTypeSpecifier::GetDouble() {
+	static const_shared_ptr<PrimitiveTypeSpecifier> instance = make_immortal(
 			new PrimitiveTypeSpecifier(BasicType::DOUBLE));
 	return instance;
 }
 
-const_shared_ptr<PrimitiveTypeSpecifier> PrimitiveTypeSpecifier::GetString() {
-	static const_shared_ptr<PrimitiveTypeSpecifier> instance = const_shared_ptr<
-			PrimitiveTypeSpecifier>(
+const_shared_ptr<PrimitiveTypeSpecifier>& PrimitiveTypeSpecifier::GetString() {
+	static const_shared_ptr<PrimitiveTypeSpecifier> instance = make_immortal(
 			new PrimitiveTypeSpecifier(BasicType::STRING));
 	return instance;
 }
@@ -151,13 +132,8 @@ const_shared_ptr<PrimitiveTypeSpecifier> PrimitiveTypeSpecifier::FromBasicType(
 }
 
 bool PrimitiveTypeSpecifier::operator ==(const TypeSpecifier& other) const {
-	try {
-		const PrimitiveTypeSpecifier& as_primitive =
-				dynamic_cast<const PrimitiveTypeSpecifier&>(other);
-		return GetBasicType() == as_primitive.GetBasicType();
-	} catch (std::bad_cast& e) {
-		return false;
-	}
+	//primitive specifiers are singletons
+	return this == &other;
 }
 
 const_shared_ptr<DeclarationStatement> PrimitiveTypeSpecifier::GetDeclarationStatement(
@@ -170,24 +146,21 @@ const_shared_ptr<DeclarationStatement> PrimitiveTypeSpecifier::GetDeclarationSta
 }
 
 const_shared_ptr<Symbol> PrimitiveTypeSpecifier::GetSymbol(
-		const_shared_ptr<void> value) const {
+		const Value& value) const {
 	const BasicType basic_type = GetBasicType();
 	switch (basic_type) {
 	case BOOLEAN: {
-		return const_shared_ptr<Symbol>(
-				new Symbol(static_pointer_cast<const bool>(value)));
+		return const_shared_ptr<Symbol>(new Symbol(value.GetBoolean()));
 	}
 	case INT: {
-		return const_shared_ptr<Symbol>(
-				new Symbol(static_pointer_cast<const int>(value)));
+		return const_shared_ptr<Symbol>(new Symbol(value.GetInt()));
 	}
 	case DOUBLE: {
-		return const_shared_ptr<Symbol>(
-				new Symbol(static_pointer_cast<const double>(value)));
+		return const_shared_ptr<Symbol>(new Symbol(value.GetDouble()));
 	}
 	case STRING: {
 		return const_shared_ptr<Symbol>(
-				new Symbol(static_pointer_cast<const string>(value)));
+				new Symbol(value.GetReference<string>()));
 	}
 	default:
 		assert(false);
@@ -38,12 +38,9 @@ public:
 		return type_to_string(m_basic_type);
 	}
 
-	const string ToString(const_shared_ptr<void> value) const;
+	const string ToString(const Value& value) const;
 
-	virtual const bool IsAssignableTo(
-			const_shared_ptr<TypeSpecifier> other) const;
-
-	virtual const_shared_ptr<void> DefaultValue(
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const;
 
 	virtual bool operator==(const TypeSpecifier &other) const;
@@ -54,8 +51,7 @@ public:
 			const yy::location name_position,
 			const_shared_ptr<Expression> initializer_expression) const;
 
-	virtual const_shared_ptr<Symbol> GetSymbol(
-			const_shared_ptr<void> value) const;
+	virtual const_shared_ptr<Symbol> GetSymbol(const Value& value) const;
 
 	const BasicType GetBasicType() const {
 		return m_basic_type;
@@ -64,22 +60,30 @@ public:
 	static const_shared_ptr<PrimitiveTypeSpecifier> FromBasicType(
 			BasicType type);
 
-	static const_shared_ptr<PrimitiveTypeSpecifier> GetNone();
+	static const_shared_ptr<PrimitiveTypeSpecifier>& GetNone();
+
+	static const_shared_ptr<PrimitiveTypeSpecifier>& GetBoolean();
 
-	static const_shared_ptr<PrimitiveTypeSpecifier> GetBoolean();
+	static const_shared_ptr<PrimitiveTypeSpecifier>& GetInt();
 
-	static const_shared_ptr<PrimitiveTypeSpecifier> GetInt();
+	static const_shared_ptr<PrimitiveTypeSpecifier>& GetDouble();
 
-	static const_shared_ptr<PrimitiveTypeSpecifier> GetDouble();
+	static const_shared_ptr<PrimitiveTypeSpecifier>& GetString();
 
-	static const_shared_ptr<PrimitiveTypeSpecifier> GetString();
+protected:
+	virtual const bool ComputeAssignableTo(
+			const_shared_ptr<TypeSpecifier> other) const;
 
 private:
 	PrimitiveTypeSpecifier(const BasicType basic_type) :
-			m_basic_type(basic_type) {
+			TypeSpecifier(PRIMITIVE, this), m_basic_type(basic_type) {
 	}
 
 	const BasicType m_basic_type;
 };
 
+template<> struct SpecifierKind<PrimitiveTypeSpecifier> {
+	static const TypeSpecifier::Kind value = TypeSpecifier::PRIMITIVE;
+};
+
 #endif /* SPECIFIERS_PRIMITIVE_TYPE_SPECIFIER_H_ */
@@ -19,14 +19,52 @@
 
 #include <sum_type_specifier.h>
 #include <sstream>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <sum_declaration_statement.h>
 
-SumTypeSpecifier::SumTypeSpecifier(const TypeSpecifierListRef types) :
-		m_types(types) {
+SumTypeSpecifier::SumTypeSpecifier(const TypeSpecifierListRef types,
+		const bool canonical) :
+		TypeSpecifier(SUM, canonical ? this : nullptr), m_types(types) {
 	//the specifier list should have at least two elements
 	assert(!TypeSpecifierList::IsTerminator(types->GetNext()));
 }
 
+const_shared_ptr<SumTypeSpecifier> SumTypeSpecifier::Get(
+		const TypeSpecifierListRef types) {
+	std::vector<plain_shared_ptr<TypeSpecifier>> members;
+	std::vector<const TypeSpecifier*> key;
+	TypeSpecifierListRef subject = types;
+	while (!TypeSpecifierList::IsTerminator(subject)) {
+		const_shared_ptr<TypeSpecifier> member = subject->GetData();
+		if (!member->IsCanonical()) {
+			return const_shared_ptr<SumTypeSpecifier>(
+					new SumTypeSpecifier(types, false));
+		}
+		members.push_back(member);
+		key.push_back(member.get());
+		subject = subject->GetNext();
+	}
+
+	static std::mutex mutex;
+	static std::map<std::vector<const TypeSpecifier*>,
+			plain_shared_ptr<SumTypeSpecifier>> instances;
+	std::lock_guard<std::mutex> lock(mutex);
+	auto& instance = instances[key];
+	if (!instance) {
+		//the given list may belong to a parse; the canonical specifier needs its own
+		TypeSpecifierListRef canonical_list = TypeSpecifierList::GetTerminator();
+		for (auto iter = members.rbegin(); iter != members.rend(); ++iter) {
+			canonical_list = TypeSpecifierList::From(*iter, canonical_list);
+		}
+
+		instance = plain_shared_ptr<SumTypeSpecifier>(
+				new SumTypeSpecifier(canonical_list, true));
+	}
+	return instance;
+}
+
 SumTypeSpecifier::~SumTypeSpecifier() {
 }
 
@@ -47,10 +85,10 @@ const string SumTypeSpecifier::ToString() const {
 	return buffer.str();
 }
 
-const bool SumTypeSpecifier::IsAssignableTo(
+const bool SumTypeSpecifier::ComputeAssignableTo(
 		const_shared_ptr<TypeSpecifier> other) const {
-	const_shared_ptr<SumTypeSpecifier> as_sum = std::dynamic_pointer_cast<
-			const SumTypeSpecifier>(other);
+	const_shared_ptr<SumTypeSpecifier> as_sum = specifier_cast<
+			SumTypeSpecifier>(other);
 
 	if (as_sum) {
 		TypeSpecifierListRef subject = m_types;
@@ -67,7 +105,7 @@ const bool SumTypeSpecifier::IsAssignableTo(
 	}
 }
 
-const_shared_ptr<void> SumTypeSpecifier::DefaultValue(
+const Value SumTypeSpecifier::DefaultValue(
 		const TypeTable& type_table) const {
 	return GetDefaultMember()->DefaultValue(type_table);
 }
@@ -83,34 +121,37 @@ const_shared_ptr<DeclarationStatement> SumTypeSpecifier::GetDeclarationStatement
 }
 
 bool SumTypeSpecifier::operator ==(const TypeSpecifier& other) const {
-	try {
-		const SumTypeSpecifier& as_sum =
-				dynamic_cast<const SumTypeSpecifier&>(other);
+	if (this == &other) {
+		return true;
+	}
 
-		//verify member types of this type specifier exist in the other type specifier
-		TypeSpecifierListRef subject = m_types;
-		while (!TypeSpecifierList::IsTerminator(subject)) {
-			if (as_sum.ContainsType(*subject->GetData(), STRICT)) {
-				subject = subject->GetNext();
-			} else {
-				return false;
-			}
-		}
+	if (other.GetKind() != SUM) {
+		return false;
+	}
 
-		//verify member types of the other type specifier exist in this type specifier
-		subject = as_sum.m_types;
-		while (!TypeSpecifierList::IsTerminator(subject)) {
-			if (ContainsType(*subject->GetData(), STRICT)) {
-				subject = subject->GetNext();
-			} else {
-				return false;
-			}
+	const SumTypeSpecifier& as_sum = static_cast<const SumTypeSpecifier&>(other);
+
+	//verify member types of this type specifier exist in the other type specifier
+	TypeSpecifierListRef subject = m_types;
+	while (!TypeSpecifierList::IsTerminator(subject)) {
+		if (as_sum.ContainsType(*subject->GetData(), STRICT)) {
+			subject = subject->GetNext();
+		} else {
+			return false;
 		}
+	}
 
-		return true;
-	} catch (std::bad_cast& e) {
-		return false;
+	//verify member types of the other type specifier exist in this type specifier
+	subject = as_sum.m_types;
+	while (!TypeSpecifierList::IsTerminator(subject)) {
+		if (ContainsType(*subject->GetData(), STRICT)) {
+			subject = subject->GetNext();
+		} else {
+			return false;
+		}
 	}
+
+	return true;
 }
 
 const bool SumTypeSpecifier::ContainsType(const TypeSpecifier& other,
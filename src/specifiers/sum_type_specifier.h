@@ -28,17 +28,26 @@ enum ComparisonMode {
 
 class SumTypeSpecifier: public TypeSpecifier {
 public:
-	SumTypeSpecifier(const TypeSpecifierListRef types);
+	/**
+	 * Get the specifier of the sum of the given types. Sums are identified by
+	 * their ordered list of members, since the first member is the default.
+	 * The result is canonical if all members are.
+	 */
+	static const_shared_ptr<SumTypeSpecifier> Get(
+			const TypeSpecifierListRef types);
+
 	virtual ~SumTypeSpecifier();
 
 	const const_shared_ptr<TypeSpecifier> GetDefaultMember() const {
 		return m_types->GetData();
 	}
 
+	const TypeSpecifierListRef GetTypeList() const {
+		return m_types;
+	}
+
 	virtual const string ToString() const;
-	virtual const bool IsAssignableTo(
-			const_shared_ptr<TypeSpecifier> other) const;
-	virtual const_shared_ptr<void> DefaultValue(
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const;
 
 	virtual const_shared_ptr<DeclarationStatement> GetDeclarationStatement(
@@ -52,8 +61,18 @@ public:
 	const bool ContainsType(const TypeSpecifier &other,
 			ComparisonMode mode) const;
 
+protected:
+	virtual const bool ComputeAssignableTo(
+			const_shared_ptr<TypeSpecifier> other) const;
+
 private:
+	SumTypeSpecifier(const TypeSpecifierListRef types, const bool canonical);
+
 	const TypeSpecifierListRef m_types;
 };
 
+template<> struct SpecifierKind<SumTypeSpecifier> {
+	static const TypeSpecifier::Kind value = TypeSpecifier::SUM;
+};
+
 #endif /* SPECIFIERS_SUM_TYPE_SPECIFIER_H_ */
@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <type_specifier.h>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+typedef std::pair<const TypeSpecifier*, const TypeSpecifier*> type_pair;
+
+struct TypePairHash {
+	size_t operator()(const type_pair& pair) const {
+		return std::hash<const TypeSpecifier*>()(pair.first) * 31
+				+ std::hash<const TypeSpecifier*>()(pair.second);
+	}
+};
+
+typedef std::unordered_map<type_pair, bool, TypePairHash> assignability_map;
+
+assignability_map& GetAssignabilityCache() {
+	//each thread memoizes on its own, so that lookups take no lock
+	static thread_local assignability_map cache;
+	return cache;
+}
+}
+
+const bool TypeSpecifier::IsAssignableTo(
+		const_shared_ptr<TypeSpecifier> other) const {
+	const TypeSpecifier* canonical = m_canonical;
+	const TypeSpecifier* other_canonical = other->m_canonical;
+	if (!canonical || !other_canonical
+			|| (m_kind == PRIMITIVE && other->m_kind == PRIMITIVE)) {
+		//primitive checks are cheaper than a lookup
+		return ComputeAssignableTo(other);
+	}
+
+	assignability_map& cache = GetAssignabilityCache();
+	const type_pair key(canonical, other_canonical);
+	auto result = cache.find(key);
+	if (result != cache.end()) {
+		return result->second;
+	}
+
+	const bool assignable = ComputeAssignableTo(other);
+	cache.insert(std::make_pair(key, assignable));
+	return assignable;
+}
@@ -23,6 +23,7 @@
 #include <defaults.h>
 #include <string>
 #include <linked_list.h>
+#include <value.h>
 
 class Expression;
 class DeclarationStatement;
@@ -30,15 +31,50 @@ class TypeTable;
 class Symbol;
 
 using namespace std;
+
+/**
+ * A type. Type specifiers are canonicalized: specifiers built from canonical parts
+ * through the factories of the specifier classes are interned, so that equal types
+ * are the same object. Canonical specifiers are never destroyed, which lets their
+ * addresses serve as keys; in particular, whether one canonical type is assignable
+ * to another is computed once (per thread) and then memoized.
+ *
+ * Canonical specifiers are immutable and shared by all threads; the factories
+ * that intern them may be called from any thread.
+ *
+ * Specifiers that carry more than their type (such as function declarations, which
+ * also name their parameters) are not canonical themselves, but may refer to the
+ * canonical specifier of their type.
+ */
 class TypeSpecifier {
 public:
+	enum Kind {
+		PRIMITIVE, ARRAY, COMPOUND, FUNCTION, SUM
+	};
+
 	virtual ~TypeSpecifier() {
 	}
 
+	const Kind GetKind() const {
+		return m_kind;
+	}
+
+	/**
+	 * The canonical specifier of this type, or null if the type has none.
+	 */
+	const TypeSpecifier* GetCanonical() const {
+		return m_canonical;
+	}
+
+	const bool IsCanonical() const {
+		return m_canonical == this;
+	}
+
 	virtual const string ToString() const = 0;
-	virtual const bool IsAssignableTo(
-			const_shared_ptr<TypeSpecifier> other) const = 0;
-	virtual const_shared_ptr<void> DefaultValue(
+
+	const bool IsAssignableTo(const_shared_ptr<TypeSpecifier> other) const;
+
+	virtual const Value DefaultValue(
 			const TypeTable& type_table) const = 0;
 
 	virtual const_shared_ptr<DeclarationStatement> GetDeclarationStatement(
@@ -51,8 +87,42 @@ public:
 	virtual bool operator!=(const TypeSpecifier &other) const {
 		return !(*this == other);
 	}
+
+protected:
+	/**
+	 * Create a specifier of the given kind. A canonical specifier passes itself as
+	 * its canonical specifier.
+	 */
+	TypeSpecifier(const Kind kind, const TypeSpecifier* canonical) :
+			m_kind(kind), m_canonical(canonical) {
+	}
+
+	virtual const bool ComputeAssignableTo(
+			const_shared_ptr<TypeSpecifier> other) const = 0;
+
+private:
+	const Kind m_kind;
+	const TypeSpecifier* m_canonical;
 };
 
+/**
+ * The kind tag of each specifier class that has one of its own.
+ */
+template<class T> struct SpecifierKind;
+
+/**
+ * Cast a specifier to the given specifier class if it is of that class's kind, and
+ * return null otherwise. Unlike a dynamic cast, this costs a single comparison.
+ */
+template<class T> const std::shared_ptr<const T> specifier_cast(
+		const std::shared_ptr<const TypeSpecifier>& specifier) {
+	if (specifier && specifier->GetKind() == SpecifierKind<T>::value) {
+		return std::static_pointer_cast<const T>(specifier);
+	} else {
+		return nullptr;
+	}
+}
+
 typedef const LinkedList<const TypeSpecifier, ALLOW_DUPLICATES> TypeSpecifierList;
 typedef shared_ptr<TypeSpecifierList> TypeSpecifierListRef;
 
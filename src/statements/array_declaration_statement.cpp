@@ -36,7 +36,7 @@ const ErrorListRef ArrayDeclarationStatement::preprocess(
 	ErrorListRef errors = ErrorList::GetTerminator();
 
 	const_shared_ptr<CompoundTypeSpecifier> element_type_as_compound =
-			dynamic_pointer_cast<const CompoundTypeSpecifier>(
+			specifier_cast<CompoundTypeSpecifier>(
 					m_type->GetElementTypeSpecifier());
 	if (element_type_as_compound) {
 		//check that element type exists
@@ -54,14 +54,13 @@ const ErrorListRef ArrayDeclarationStatement::preprocess(
 	}
 
 	if (ErrorList::IsTerminator(errors)) {
-		const Array* array = nullptr;
-		auto name = GetName();
+		plain_shared_ptr<Array> array;
 		auto initializer_expression = GetInitializerExpression();
 		if (initializer_expression) {
 			const_shared_ptr<TypeSpecifier> initializer_expression_type =
 					initializer_expression->GetType(execution_context);
 			const_shared_ptr<ArrayTypeSpecifier> as_array =
-					std::dynamic_pointer_cast<const ArrayTypeSpecifier>(
+					specifier_cast<ArrayTypeSpecifier>(
 							initializer_expression_type);
 			if (!as_array
 					|| !initializer_expression_type->IsAssignableTo(m_type)) {
@@ -78,18 +77,16 @@ const ErrorListRef ArrayDeclarationStatement::preprocess(
 		}
 
 		if (ErrorList::IsTerminator(errors)) {
-			array = new Array(m_type->GetElementTypeSpecifier(),
-					*execution_context->GetTypeTable());
+			array = Array::Create(m_type->GetElementTypeSpecifier());
 		}
 
 		volatile_shared_ptr<SymbolTable> symbol_table = static_pointer_cast<
 				SymbolTable>(execution_context);
 
 		if (array) {
-			auto wrapper = const_shared_ptr<Array>(array);
-			auto symbol = const_shared_ptr<Symbol>(new Symbol(wrapper));
-			InsertResult insert_result = symbol_table->InsertSymbol(*name,
-					symbol);
+			auto symbol = const_shared_ptr<Symbol>(new Symbol(array));
+			InsertResult insert_result = symbol_table->InsertSymbol(
+					GetNameAtom(), symbol);
 			if (insert_result == SYMBOL_EXISTS) {
 				errors = ErrorList::From(
 						make_shared<Error>(Error::SEMANTIC,
@@ -116,13 +113,12 @@ const ErrorListRef ArrayDeclarationStatement::execute(
 		errors = initializer_result->GetErrors();
 
 		if (ErrorList::IsTerminator(errors)) {
-			auto array = static_pointer_cast<const Array>(
-					initializer_result->GetData());
+			auto array = initializer_result->GetData().GetReference<Array>();
 			auto symbol_context = execution_context;
-			SetResult result = symbol_context->SetSymbol(*GetName(), array);
+			SetResult result = symbol_context->SetSymbol(GetNameAtom(), array);
 			errors = ToErrorListRef(result,
 					GetInitializerExpression()->GetPosition(), GetName(),
-					symbol_context->GetSymbol(GetName(), SHALLOW)->GetType(),
+					symbol_context->GetSymbol(GetNameAtom(), SHALLOW)->GetType(),
 					array->GetTypeSpecifier());
 		}
 	}
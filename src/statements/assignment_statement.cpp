@@ -29,8 +29,10 @@
 #include <execution_context.h>
 #include <typeinfo>
 #include <variable_expression.h>
+#include <function_expression.h>
 #include <compound_type.h>
 #include <type_specifier.h>
+#include <statement_block.h>
 
 AssignmentStatement::AssignmentStatement(const_shared_ptr<Variable> variable,
 		const AssignmentType op_type, const_shared_ptr<Expression> expression) :
@@ -45,18 +47,27 @@ const ErrorListRef AssignmentStatement::preprocess(
 	ErrorListRef errors = ErrorList::GetTerminator();
 
 	const_shared_ptr<string> variable_name = m_variable->GetName();
-	auto symbol = execution_context->GetSymbol(variable_name, DEEP);
+	auto symbol = execution_context->GetSymbol(m_variable->GetNameAtom(),
+			DEEP);
 	const_shared_ptr<TypeSpecifier> symbol_type = symbol->GetType();
 
 	int variable_line = m_variable->GetLocation().begin.line;
 	int variable_column = m_variable->GetLocation().begin.column;
 
 	if (symbol != Symbol::GetDefaultSymbol()) {
+		//validating a function literal also computes the layout of its frames
+		if (dynamic_pointer_cast<const FunctionExpression>(m_expression)) {
+			errors = m_expression->Validate(execution_context);
+			if (!ErrorList::IsTerminator(errors)) {
+				return errors;
+			}
+		}
+
 		const_shared_ptr<BasicVariable> basic_variable = dynamic_pointer_cast<
 				const BasicVariable>(m_variable);
 		if (basic_variable) {
 			const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-					dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+					specifier_cast<PrimitiveTypeSpecifier>(
 							symbol_type);
 			const_shared_ptr<TypeSpecifier> expression_type =
 					m_expression->GetType(execution_context);
@@ -77,7 +88,7 @@ const ErrorListRef AssignmentStatement::preprocess(
 			}
 
 			const_shared_ptr<ArrayTypeSpecifier> as_array =
-					dynamic_pointer_cast<const ArrayTypeSpecifier>(symbol_type);
+					specifier_cast<ArrayTypeSpecifier>(symbol_type);
 			if (as_array) {
 				//reassigning raw array reference, not an array element
 				if (!expression_type->IsAssignableTo(symbol_type)) {
@@ -94,7 +105,7 @@ const ErrorListRef AssignmentStatement::preprocess(
 			}
 
 			const_shared_ptr<CompoundTypeSpecifier> as_compound =
-					dynamic_pointer_cast<const CompoundTypeSpecifier>(
+					specifier_cast<CompoundTypeSpecifier>(
 							symbol_type);
 			if (as_compound) {
 				//reassigning raw struct reference, not a member
@@ -141,7 +152,7 @@ const ErrorListRef AssignmentStatement::preprocess(
 				const MemberVariable>(m_variable);
 		if (member_variable) {
 			const_shared_ptr<CompoundTypeSpecifier> as_compound =
-					dynamic_pointer_cast<const CompoundTypeSpecifier>(
+					specifier_cast<CompoundTypeSpecifier>(
 							member_variable->GetContainer()->GetType(
 									execution_context));
 
@@ -366,12 +377,12 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		return evaluation;
 	}
 
-	auto void_value = evaluation->GetData();
+	auto expression_value = evaluation->GetData();
 
 	const_shared_ptr<TypeSpecifier> expression_type_specifier =
 			expression->GetType(execution_context);
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+			specifier_cast<PrimitiveTypeSpecifier>(
 					expression_type_specifier);
 
 	if (as_primitive) {
@@ -380,14 +391,14 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		case BOOLEAN: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const bool>(void_value)), op,
+					expression_value.GetBoolean(), op,
 					execution_context, new_value);
 			break;
 		}
 		case INT: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const int>(void_value)), op,
+					expression_value.GetInt(), op,
 					execution_context, new_value);
 			break;
 		}
@@ -406,8 +417,7 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 						expression_type_specifier->ToString()), errors);
 	}
 
-	const_shared_ptr<int> wrapper = make_shared<int>(new_value);
-	return make_shared<Result>(wrapper, errors);
+	return make_shared<Result>(Value(new_value), errors);
 }
 
 const_shared_ptr<Result> AssignmentStatement::do_op(
@@ -424,12 +434,12 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		return evaluation;
 	}
 
-	auto void_value = evaluation->GetData();
+	auto expression_value = evaluation->GetData();
 
 	const_shared_ptr<TypeSpecifier> expression_type_specifier =
 			expression->GetType(execution_context);
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+			specifier_cast<PrimitiveTypeSpecifier>(
 					expression_type_specifier);
 
 	if (as_primitive) {
@@ -438,20 +448,20 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		case BOOLEAN:
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const bool>(void_value)), op,
+					expression_value.GetBoolean(), op,
 					execution_context, new_value);
 			break;
 		case INT: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const int>(void_value)), op,
+					expression_value.GetInt(), op,
 					execution_context, new_value);
 			break;
 		}
 		case DOUBLE: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const double>(void_value)), op,
+					expression_value.GetDouble(), op,
 					execution_context, new_value);
 			break;
 		}
@@ -470,8 +480,7 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 						expression_type_specifier->ToString()), errors);
 	}
 
-	const_shared_ptr<void> wrapper = make_shared<double>(new_value);
-	return make_shared<Result>(wrapper, errors);
+	return make_shared<Result>(Value(new_value), errors);
 }
 
 const_shared_ptr<Result> AssignmentStatement::do_op(
@@ -488,12 +497,12 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		return evaluation;
 	}
 
-	auto void_value = evaluation->GetData();
+	auto expression_value = evaluation->GetData();
 
 	const_shared_ptr<TypeSpecifier> expression_type_specifier =
 			expression->GetType(execution_context);
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+			specifier_cast<PrimitiveTypeSpecifier>(
 					expression_type_specifier);
 
 	if (as_primitive) {
@@ -502,27 +511,27 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 		case BOOLEAN:
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const bool>(void_value)), op,
+					expression_value.GetBoolean(), op,
 					execution_context, new_value);
 			break;
 		case INT: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const int>(void_value)), op,
+					expression_value.GetInt(), op,
 					execution_context, new_value);
 			break;
 		}
 		case DOUBLE: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					*(static_pointer_cast<const double>(void_value)), op,
+					expression_value.GetDouble(), op,
 					execution_context, new_value);
 			break;
 		}
 		case STRING: {
 			errors = do_op(variable_name, variable_type, variable_line,
 					variable_column, value,
-					static_pointer_cast<const string>(void_value), op,
+					expression_value.GetReference<string>(), op,
 					execution_context, new_value);
 			break;
 		}
@@ -541,8 +550,8 @@ const_shared_ptr<Result> AssignmentStatement::do_op(
 						expression_type_specifier->ToString()), errors);
 	}
 
-	auto wrapper = const_shared_ptr<void>(new_value);
-	return make_shared<Result>(wrapper, errors);
+	return make_shared<Result>(Value(const_shared_ptr<string>(new_value)),
+			errors);
 }
 
 const ErrorListRef AssignmentStatement::execute(
@@ -557,7 +566,8 @@ const ErrorListRef AssignmentStatement::execute(
 	int variable_line = m_variable->GetLocation().begin.line;
 	int variable_column = m_variable->GetLocation().begin.column;
 
-	auto symbol = execution_context->GetSymbol(variable_name, DEEP);
+	auto symbol = execution_context->GetSymbol(m_variable->GetNameAtom(),
+			DEEP);
 
 	if (symbol && symbol != Symbol::GetDefaultSymbol()) {
 		errors = m_variable->AssignValue(execution_context, m_expression,
@@ -571,3 +581,13 @@ const ErrorListRef AssignmentStatement::execute(
 
 	return errors;
 }
+
+const_shared_ptr<StatementBlock> AssignmentStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_expression = Expression::Fold(m_expression, execution_context);
+	return nullptr;
+}
+
+const yy::location AssignmentStatement::GetPosition() const {
+	return m_variable->GetLocation();
+}
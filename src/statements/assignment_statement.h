@@ -28,6 +28,7 @@
 using namespace std;
 
 class Expression;
+class StatementBlock;
 class Variable;
 class ArrayVariable;
 class MemberVariable;
@@ -58,12 +59,17 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const {
 		return ErrorList::GetTerminator();
 	}
 
+	virtual const yy::location GetPosition() const;
+
 	static const ErrorListRef do_op(const_shared_ptr<string> variable_name,
 			const BasicType variable_type, int variable_line,
 			int variable_column, const bool old_value,
@@ -124,7 +130,7 @@ public:
 private:
 	const_shared_ptr<Variable> m_variable;
 	const AssignmentType m_op_type;
-	const const_shared_ptr<Expression> m_expression;
+	mutable plain_shared_ptr<Expression> m_expression;
 
 };
 
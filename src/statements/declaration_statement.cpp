@@ -18,13 +18,23 @@
  */
 
 #include <declaration_statement.h>
+#include <expression.h>
+#include <statement_block.h>
 
 DeclarationStatement::DeclarationStatement(const yy::location position,
 		const_shared_ptr<string> name, const yy::location name_position,
 		const_shared_ptr<Expression> initializer_expression) :
-		m_position(position), m_name(name), m_name_position(name_position), m_initializer_expression(
+		m_position(position), m_name(name), m_name_atom(*name), m_name_position(
+				name_position), m_initializer_expression(
 				initializer_expression) {
 }
 
 DeclarationStatement::~DeclarationStatement() {
 }
+
+const_shared_ptr<StatementBlock> DeclarationStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_initializer_expression = Expression::Fold(m_initializer_expression,
+			execution_context);
+	return nullptr;
+}
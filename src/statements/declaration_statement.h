@@ -22,8 +22,10 @@
 
 #include <statement.h>
 #include <string>
+#include <atom.h>
 
 class Expression;
+class StatementBlock;
 class TypeSpecifier;
 
 using namespace std;
@@ -46,7 +48,10 @@ public:
 		return ErrorList::GetTerminator();
 	}
 
-	const yy::location GetPosition() const {
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
+	virtual const yy::location GetPosition() const {
 		return m_position;
 	}
 
@@ -54,6 +59,13 @@ public:
 		return m_name;
 	}
 
+	/**
+	 * The interned name, which symbol lookups should use.
+	 */
+	const Atom& GetNameAtom() const {
+		return m_name_atom;
+	}
+
 	const yy::location GetNamePosition() const {
 		return m_name_position;
 	}
@@ -65,8 +77,9 @@ public:
 private:
 	const yy::location m_position;
 	const_shared_ptr<string> m_name;
+	const Atom m_name_atom;
 	const yy::location m_name_position;
-	const_shared_ptr<Expression> m_initializer_expression;
+	mutable plain_shared_ptr<Expression> m_initializer_expression;
 };
 
 typedef const LinkedList<const DeclarationStatement, NO_DUPLICATES> DeclarationList;
@@ -22,6 +22,7 @@
 #include <assert.h>
 #include <error.h>
 #include <execution_context.h>
+#include <statement_block.h>
 
 ExitStatement::ExitStatement() :
 		m_exit_expression(nullptr) {
@@ -42,7 +43,7 @@ const ErrorListRef ExitStatement::preprocess(
 		const_shared_ptr<TypeSpecifier> expression_type_specifier =
 				m_exit_expression->GetType(execution_context);
 		const_shared_ptr<PrimitiveTypeSpecifier> expression_as_primitive =
-				std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+				specifier_cast<PrimitiveTypeSpecifier>(
 						expression_type_specifier);
 
 		if (expression_as_primitive == nullptr
@@ -73,10 +74,24 @@ const ErrorListRef ExitStatement::execute(
 		if (!ErrorList::IsTerminator(evaluation->GetErrors())) {
 			return evaluation->GetErrors();
 		} else {
-			exit_code = static_pointer_cast<const int>(evaluation->GetData());
+			exit_code = make_shared<int>(evaluation->GetData().GetInt());
 		}
 	}
 
 	execution_context->SetExitCode(exit_code);
 	return ErrorList::GetTerminator();
 }
+
+const_shared_ptr<StatementBlock> ExitStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_exit_expression = Expression::Fold(m_exit_expression, execution_context);
+	return nullptr;
+}
+
+const yy::location ExitStatement::GetPosition() const {
+	if (m_exit_expression) {
+		return m_exit_expression->GetPosition();
+	} else {
+		return GetDefaultLocation();
+	}
+}
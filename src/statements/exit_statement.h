@@ -23,6 +23,7 @@
 #include "statement.h"
 
 class Expression;
+class StatementBlock;
 class Error;
 
 class ExitStatement: public Statement {
@@ -37,14 +38,23 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const {
 		return ErrorList::GetTerminator();
 	}
 
+	virtual const yy::location GetPosition() const;
+
+	const_shared_ptr<Expression> GetExitExpression() const {
+		return m_exit_expression;
+	}
+
 private:
-	const_shared_ptr<Expression> m_exit_expression;
+	mutable plain_shared_ptr<Expression> m_exit_expression;
 };
 
 #endif /* EXIT_STATEMENT_H_ */
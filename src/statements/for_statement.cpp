@@ -52,11 +52,8 @@ const ErrorListRef ForStatement::preprocess(
 		const shared_ptr<ExecutionContext> execution_context) const {
 	ErrorListRef errors;
 
-	const auto new_parent = SymbolContextList::From(execution_context,
-			execution_context->GetParent());
-	const shared_ptr<ExecutionContext> new_execution_context =
-			execution_context->WithContents(m_block_context)->WithParent(
-					new_parent);
+	const shared_ptr<ExecutionContext> new_execution_context = GetBlockContext(
+			execution_context);
 
 	if (m_initial) {
 		errors = m_initial->preprocess(new_execution_context);
@@ -85,11 +82,8 @@ const ErrorListRef ForStatement::execute(
 		shared_ptr<ExecutionContext> execution_context) const {
 	ErrorListRef initialization_errors;
 
-	const auto new_parent = SymbolContextList::From(execution_context,
-			execution_context->GetParent());
-	const shared_ptr<ExecutionContext> new_execution_context =
-			execution_context->WithContents(m_block_context)->WithParent(
-					new_parent);
+	const shared_ptr<ExecutionContext> new_execution_context = GetBlockContext(
+			execution_context);
 
 	if (m_initial) {
 		initialization_errors = m_initial->execute(new_execution_context);
@@ -105,7 +99,7 @@ const ErrorListRef ForStatement::execute(
 		return evaluation->GetErrors();
 	}
 
-	while (*(static_pointer_cast<const bool>(evaluation->GetData()))) {
+	while (evaluation->GetData().GetBoolean()) {
 		ErrorListRef iteration_errors = ErrorList::GetTerminator();
 		if (m_statement_block) {
 			iteration_errors = m_statement_block->execute(
@@ -138,6 +132,14 @@ const ErrorListRef ForStatement::GetReturnStatementErrors(
 			execution_context);
 }
 
+const shared_ptr<ExecutionContext> ForStatement::GetBlockContext(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	const auto new_parent = SymbolContextList::From(execution_context,
+			execution_context->GetParent());
+	return execution_context->WithContents(m_block_context)->WithParent(
+			new_parent);
+}
+
 ForStatement::ForStatement(const_shared_ptr<Statement> initial,
 		const_shared_ptr<Expression> loop_expression,
 		const_shared_ptr<AssignmentStatement> loop_assignment,
@@ -148,3 +150,20 @@ ForStatement::ForStatement(const_shared_ptr<Statement> initial,
 	assert(loop_expression);
 	assert(loop_assignment);
 }
+
+const_shared_ptr<StatementBlock> ForStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	if (m_initial) {
+		m_initial->optimize(execution_context);
+	}
+	m_loop_expression = Expression::Fold(m_loop_expression, execution_context);
+	m_loop_assignment->optimize(execution_context);
+	if (m_statement_block) {
+		m_statement_block->optimize(execution_context);
+	}
+	return nullptr;
+}
+
+const yy::location ForStatement::GetPosition() const {
+	return m_loop_expression->GetPosition();
+}
@@ -47,10 +47,37 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const yy::location GetPosition() const;
+
+	const_shared_ptr<Statement> GetInitial() const {
+		return m_initial;
+	}
+
+	const_shared_ptr<Expression> GetLoopExpression() const {
+		return m_loop_expression;
+	}
+
+	const_shared_ptr<AssignmentStatement> GetLoopAssignment() const {
+		return m_loop_assignment;
+	}
+
+	const_shared_ptr<StatementBlock> GetStatementBlock() const {
+		return m_statement_block;
+	}
+
+	/**
+	 * Get the context in which the loop initializer, condition, body and assignment are evaluated.
+	 */
+	const shared_ptr<ExecutionContext> GetBlockContext(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 private:
 	ForStatement(const_shared_ptr<Statement> initial,
 			const_shared_ptr<Expression> loop_expression,
@@ -58,7 +85,7 @@ private:
 			const_shared_ptr<StatementBlock> statement_block);
 
 	const_shared_ptr<Statement> m_initial;
-	const_shared_ptr<Expression> m_loop_expression;
+	mutable plain_shared_ptr<Expression> m_loop_expression;
 	const_shared_ptr<AssignmentStatement> m_loop_assignment;
 	const_shared_ptr<StatementBlock> m_statement_block;
 	shared_ptr<ExecutionContext> m_block_context;
@@ -47,14 +47,14 @@ const ErrorListRef FunctionDeclarationStatement::preprocess(
 
 	auto type_table = execution_context->GetTypeTable();
 
-	auto existing = execution_context->GetSymbol(GetName(), SHALLOW);
+	auto existing = execution_context->GetSymbol(GetNameAtom(), SHALLOW);
 
 	if (existing == nullptr || existing == Symbol::GetDefaultSymbol()) {
 		if (GetInitializerExpression()) {
 			const_shared_ptr<TypeSpecifier> expression_type =
 					GetInitializerExpression()->GetType(execution_context);
 			const_shared_ptr<FunctionTypeSpecifier> as_function =
-					std::dynamic_pointer_cast<const FunctionTypeSpecifier>(
+					specifier_cast<FunctionTypeSpecifier>(
 							expression_type);
 
 			if (as_function) {
@@ -74,12 +74,12 @@ const ErrorListRef FunctionDeclarationStatement::preprocess(
 		if (ErrorList::IsTerminator(errors)) {
 			auto value = m_type->DefaultValue(*type_table);
 			auto symbol = const_shared_ptr<Symbol>(
-					new Symbol(static_pointer_cast<const Function>(value)));
+					new Symbol(value.GetReference<Function>()));
 
 			volatile_shared_ptr<SymbolTable> symbol_table = static_pointer_cast<
 					SymbolTable>(execution_context);
-			InsertResult insert_result = symbol_table->InsertSymbol(*GetName(),
-					symbol);
+			InsertResult insert_result = symbol_table->InsertSymbol(
+					GetNameAtom(), symbol);
 
 			if (insert_result != INSERT_SUCCESS) {
 				assert(false);
@@ -47,6 +47,10 @@ public:
 
 	virtual const_shared_ptr<TypeSpecifier> GetType() const;
 
+	const yy::location GetTypePosition() const {
+		return m_type_position;
+	}
+
 private:
 	const_shared_ptr<FunctionTypeSpecifier> m_type;
 	const yy::location m_type_position;
@@ -26,6 +26,7 @@
 #include <type.h>
 #include <error.h>
 #include <execution_context.h>
+#include <constant_expression.h>
 
 IfStatement::IfStatement(const_shared_ptr<Expression> expression,
 		const_shared_ptr<StatementBlock> block) :
@@ -92,7 +93,7 @@ const ErrorListRef IfStatement::execute(
 	const_shared_ptr<Result> evaluation = m_expression->Evaluate(
 			execution_context);
 	//NOTE: we are relying on our preprocessing passing to guarantee that the previous evaluation returned no errors
-	bool test = *(static_pointer_cast<const bool>(evaluation->GetData()));
+	bool test = evaluation->GetData().GetBoolean();
 
 	if (test) {
 		SymbolContextListRef new_parent = SymbolContextList::From(
@@ -125,3 +126,31 @@ const ErrorListRef IfStatement::GetReturnStatementErrors(
 	}
 	return errors;
 }
+
+const_shared_ptr<StatementBlock> IfStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_expression = Expression::Fold(m_expression, execution_context);
+	m_block->optimize(execution_context);
+	if (m_else_block) {
+		m_else_block->optimize(execution_context);
+	}
+
+	if (std::dynamic_pointer_cast<const ConstantExpression>(m_expression)) {
+		//the blocks execute in the enclosing context, so the live branch
+		//can be spliced directly into the enclosing block
+		if (m_expression->Evaluate(execution_context)->GetData().GetBoolean()) {
+			return m_block;
+		} else if (m_else_block) {
+			return m_else_block;
+		} else {
+			return make_shared<StatementBlock>(StatementList::GetTerminator(),
+					m_block->GetLocation());
+		}
+	}
+
+	return nullptr;
+}
+
+const yy::location IfStatement::GetPosition() const {
+	return m_expression->GetPosition();
+}
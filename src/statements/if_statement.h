@@ -40,18 +40,31 @@ public:
 		return m_expression;
 	}
 
+	const_shared_ptr<StatementBlock> GetBlock() const {
+		return m_block;
+	}
+
+	const_shared_ptr<StatementBlock> GetElseBlock() const {
+		return m_else_block;
+	}
+
 	virtual const ErrorListRef preprocess(
 			const shared_ptr<ExecutionContext> execution_context) const;
 
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const yy::location GetPosition() const;
+
 private:
-	const_shared_ptr<Expression> m_expression;
+	mutable plain_shared_ptr<Expression> m_expression;
 	const_shared_ptr<StatementBlock> m_block;
 	const_shared_ptr<StatementBlock> m_else_block;
 	shared_ptr<ExecutionContext> m_block_context;
@@ -22,6 +22,7 @@
 #include <invoke_expression.h>
 #include <variable.h>
 #include <variable_expression.h>
+#include <statement_block.h>
 
 InvokeStatement::InvokeStatement(const_shared_ptr<Variable> variable,
 		ArgumentListRef argument_list, const yy::location argument_list_position) :
@@ -59,3 +60,13 @@ const ErrorListRef InvokeStatement::execute(
 
 	return result->GetErrors();
 }
+
+const_shared_ptr<StatementBlock> InvokeStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_argument_list = Expression::Fold(m_argument_list, execution_context);
+	return nullptr;
+}
+
+const yy::location InvokeStatement::GetPosition() const {
+	return m_variable->GetLocation();
+}
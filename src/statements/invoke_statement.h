@@ -23,6 +23,7 @@
 #include <expression.h>
 #include <statement.h>
 
+class StatementBlock;
 class Variable;
 
 class InvokeStatement: public Statement {
@@ -38,15 +39,32 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const {
 		return ErrorList::GetTerminator();
 	}
 
+	virtual const yy::location GetPosition() const;
+
+	const_shared_ptr<Variable> GetVariable() const {
+		return m_variable;
+	}
+
+	ArgumentListRef GetArgumentList() const {
+		return m_argument_list;
+	}
+
+	const yy::location GetArgumentListPosition() const {
+		return m_argument_list_position;
+	}
+
 private:
 	const_shared_ptr<Variable> m_variable;
-	ArgumentListRef m_argument_list;
+	mutable ArgumentListRef m_argument_list;
 	const yy::location m_argument_list_position;
 };
 
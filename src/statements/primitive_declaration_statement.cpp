@@ -36,7 +36,7 @@ const ErrorListRef PrimitiveDeclarationStatement::preprocess(
 		errors = GetInitializerExpression()->Validate(execution_context);
 	}
 
-	auto as_primitive = std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+	auto as_primitive = specifier_cast<PrimitiveTypeSpecifier>(
 			m_type);
 
 	if (as_primitive) {
@@ -44,8 +44,8 @@ const ErrorListRef PrimitiveDeclarationStatement::preprocess(
 			const_shared_ptr<TypeSpecifier> expression_type_specifier =
 					GetInitializerExpression()->GetType(execution_context);
 
-			auto expression_as_primitive = std::dynamic_pointer_cast<
-					const PrimitiveTypeSpecifier>(expression_type_specifier);
+			auto expression_as_primitive =
+					specifier_cast<PrimitiveTypeSpecifier>(expression_type_specifier);
 
 			if (expression_as_primitive == nullptr
 					|| !expression_as_primitive->IsAssignableTo(as_primitive)) {
@@ -68,8 +68,8 @@ const ErrorListRef PrimitiveDeclarationStatement::preprocess(
 	}
 
 	if (symbol != Symbol::GetDefaultSymbol()) {
-		InsertResult insert_result = execution_context->InsertSymbol(*GetName(),
-				symbol);
+		InsertResult insert_result = execution_context->InsertSymbol(
+				GetNameAtom(), symbol);
 		if (insert_result == SYMBOL_EXISTS) {
 			errors = ErrorList::From(
 					make_shared<Error>(Error::SEMANTIC,
@@ -36,6 +36,10 @@ public:
 		return m_type;
 	}
 
+	const yy::location GetTypePosition() const {
+		return m_type_position;
+	}
+
 private:
 	const_shared_ptr<TypeSpecifier> m_type;
 	const yy::location m_type_position;
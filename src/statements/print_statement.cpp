@@ -20,6 +20,7 @@
 #include <expression.h>
 #include "print_statement.h"
 #include <defaults.h>
+#include <statement_block.h>
 
 PrintStatement::PrintStatement(const int line_number,
 		const_shared_ptr<Expression> expression) :
@@ -39,9 +40,19 @@ const ErrorListRef PrintStatement::execute(
 
 	if (ErrorList::IsTerminator(errors)) {
 		std::cout
-				<< *(static_pointer_cast<const string>(string_result->GetData()))
+				<< *(string_result->GetData().GetReference<string>())
 				<< "\n";
 	}
 
 	return errors;
 }
+
+const_shared_ptr<StatementBlock> PrintStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_expression = Expression::Fold(m_expression, execution_context);
+	return nullptr;
+}
+
+const yy::location PrintStatement::GetPosition() const {
+	return m_expression->GetPosition();
+}
@@ -23,6 +23,7 @@
 #include "statement.h"
 
 class Expression;
+class StatementBlock;
 
 class PrintStatement: public Statement {
 public:
@@ -38,6 +39,13 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
+	const int GetLineNumber() const {
+		return m_line_number;
+	}
+
 	const_shared_ptr<Expression> GetExpression() const {
 		return m_expression;
 	}
@@ -48,9 +56,11 @@ public:
 		return ErrorList::GetTerminator();
 	}
 
+	virtual const yy::location GetPosition() const;
+
 private:
 	const int m_line_number;
-	const_shared_ptr<Expression> m_expression;
+	mutable plain_shared_ptr<Expression> m_expression;
 };
 
 #endif /* PRINT_STATEMENT_H_ */
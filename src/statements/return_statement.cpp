@@ -20,9 +20,15 @@
 #include <return_statement.h>
 #include <expression.h>
 #include <execution_context.h>
+#include <statement_block.h>
+#include <invoke_expression.h>
+#include <function.h>
+#include <function_declaration.h>
+#include <primitive_type_specifier.h>
+#include <profiler.h>
 
 ReturnStatement::ReturnStatement(const_shared_ptr<Expression> expression) :
-		m_expression(expression) {
+		m_expression(expression), m_tail_call(nullptr) {
 }
 
 ReturnStatement::~ReturnStatement() {
@@ -30,13 +36,47 @@ ReturnStatement::~ReturnStatement() {
 
 const ErrorListRef ReturnStatement::preprocess(
 		const shared_ptr<ExecutionContext> execution_context) const {
+	m_tail_call = std::dynamic_pointer_cast<const InvokeExpression>(
+			m_expression);
 	return m_expression->Validate(execution_context);
 }
 
 const ErrorListRef ReturnStatement::execute(
 		shared_ptr<ExecutionContext> execution_context) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
-	auto result = m_expression->Evaluate(execution_context);
+	plain_shared_ptr<Result> result;
+
+	TailCall* tail_call = execution_context->GetTailCall();
+	if (m_tail_call && tail_call) {
+		auto function_result = m_tail_call->GetExpression()->Evaluate(
+				execution_context);
+		errors = function_result->GetErrors();
+		if (!ErrorList::IsTerminator(errors)) {
+			return errors;
+		}
+
+		auto function = function_result->GetData().GetReference<Function>();
+		if (*function->GetType()->GetReturnType() == *tail_call->return_type) {
+			//the result of the call needs no conversion, so the call can be
+			//made in place of this frame
+			tail_call->function = function;
+			tail_call->arguments = m_tail_call->GetArgumentListRef();
+			tail_call->name = &m_tail_call->GetFunctionName();
+
+			//end the execution of the frame; the call supplies the actual value
+			static const_shared_ptr<Symbol> pending = make_immortal(
+					new Symbol(PrimitiveTypeSpecifier::GetNone(), Value()));
+			execution_context->SetReturnValue(pending);
+			return errors;
+		}
+
+		ProfiledCall call(m_tail_call->GetFunctionName(),
+				m_tail_call->GetPosition().begin.line);
+		result = function->Evaluate(m_tail_call->GetArgumentListRef(),
+				execution_context);
+	} else {
+		result = m_expression->Evaluate(execution_context);
+	}
 
 	errors = result->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
@@ -65,3 +105,16 @@ const ErrorListRef ReturnStatement::GetReturnStatementErrors(
 
 	return errors;
 }
+
+const_shared_ptr<StatementBlock> ReturnStatement::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	m_expression = Expression::Fold(m_expression, execution_context);
+	if (m_tail_call && m_tail_call != m_expression) {
+		m_tail_call = nullptr;
+	}
+	return nullptr;
+}
+
+const yy::location ReturnStatement::GetPosition() const {
+	return m_expression->GetPosition();
+}
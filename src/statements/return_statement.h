@@ -23,6 +23,8 @@
 #include <statement.h>
 
 class Expression;
+class InvokeExpression;
+class StatementBlock;
 
 class ReturnStatement: public Statement {
 public:
@@ -35,12 +37,30 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const;
 
+	virtual const yy::location GetPosition() const;
+
+	const_shared_ptr<Expression> GetExpression() const {
+		return m_expression;
+	}
+
+	/**
+	 * The invocation whose result is returned, if any. Such a call need not keep
+	 * the frame of the function that makes it.
+	 */
+	const_shared_ptr<InvokeExpression> GetTailCall() const {
+		return m_tail_call;
+	}
+
 private:
-	const_shared_ptr<Expression> m_expression;
+	mutable plain_shared_ptr<Expression> m_expression;
+	mutable plain_shared_ptr<InvokeExpression> m_tail_call;
 };
 
 #endif /* STATEMENTS_RETURN_STATEMENT_H_ */
@@ -26,6 +26,7 @@
 
 class ExecutionContext;
 class Result;
+class StatementBlock;
 class TypeSpecifier;
 
 class Statement {
@@ -44,9 +45,24 @@ public:
 	virtual const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const = 0;
 
+	/**
+	 * Optimize the statement in place, once pre-processing has succeeded.
+	 * Returns a block whose statements are to be executed in place of this
+	 * statement, or nullptr if the statement is to be kept.
+	 */
+	virtual const_shared_ptr<StatementBlock> optimize(
+			const shared_ptr<ExecutionContext> execution_context) const {
+		return nullptr;
+	}
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const = 0;
+
+	/**
+	 * The location of the statement in the source.
+	 */
+	virtual const yy::location GetPosition() const = 0;
 };
 
 typedef const LinkedList<const Statement, NO_DUPLICATES> StatementList;
@@ -23,6 +23,8 @@
 #include "statement.h"
 #include <execution_context.h>
 #include <type_specifier.h>
+#include <profiler.h>
+#include <statistics.h>
 
 using namespace std;
 
@@ -56,6 +58,11 @@ const ErrorListRef StatementBlock::execute(
 	auto subject = m_statements;
 	while (!StatementList::IsTerminator(subject)) {
 		const_shared_ptr<Statement> statement = subject->GetData();
+		STATISTICS_COUNT(STATEMENTS, *statement);
+		if (Profiler::IsSamplePending()) {
+			Profiler::GetActive()->Sample(statement->GetPosition().begin.line);
+		}
+
 		auto errors = statement->execute(execution_context);
 		if (!ErrorList::IsTerminator(errors)
 				|| execution_context->GetReturnValue()
@@ -71,6 +78,34 @@ const ErrorListRef StatementBlock::execute(
 	return ErrorList::GetTerminator();
 }
 
+void StatementBlock::optimize(
+		const shared_ptr<ExecutionContext> execution_context) const {
+	bool changed = false;
+	StatementListRef result = StatementList::GetTerminator();
+	auto subject = m_statements;
+	while (!StatementList::IsTerminator(subject)) {
+		const_shared_ptr<Statement> statement = subject->GetData();
+		auto replacement = statement->optimize(execution_context);
+		if (replacement) {
+			auto replacement_subject = replacement->GetStatementList();
+			while (!StatementList::IsTerminator(replacement_subject)) {
+				result = StatementList::From(replacement_subject->GetData(),
+						result);
+				replacement_subject = replacement_subject->GetNext();
+			}
+			changed = true;
+		} else {
+			result = StatementList::From(statement, result);
+		}
+
+		subject = subject->GetNext();
+	}
+
+	if (changed) {
+		m_statements = StatementList::Reverse(result);
+	}
+}
+
 const ErrorListRef StatementBlock::GetReturnStatementErrors(
 		const_shared_ptr<TypeSpecifier> type_specifier,
 		const shared_ptr<ExecutionContext> execution_context) const {
@@ -36,6 +36,11 @@ public:
 	const ErrorListRef execute(
 			shared_ptr<ExecutionContext> execution_context) const;
 
+	/**
+	 * Fold constant expressions and eliminate dead branches in place.
+	 */
+	void optimize(const shared_ptr<ExecutionContext> execution_context) const;
+
 	virtual const ErrorListRef GetReturnStatementErrors(
 			const_shared_ptr<TypeSpecifier> type_specifier,
 			const shared_ptr<ExecutionContext> execution_context) const;
@@ -44,8 +49,12 @@ public:
 		return m_location;
 	}
 
+	StatementListRef GetStatementList() const {
+		return m_statements;
+	}
+
 private:
-	StatementListRef m_statements;
+	mutable StatementListRef m_statements;
 	const yy::location m_location;
 };
 
@@ -66,7 +66,7 @@ const ErrorListRef StructDeclarationStatement::preprocess(
 
 	//generate a temporary structure in which to perform evaluations
 	//of the member declaration statements
-	const shared_ptr<symbol_map> values = make_shared<symbol_map>();
+	const shared_ptr<SymbolMap> values = make_shared<SymbolMap>();
 	volatile_shared_ptr<SymbolTable> member_buffer = make_shared<SymbolTable>(
 			Modifier::NONE, values);
 	shared_ptr<ExecutionContext> struct_context =
@@ -102,25 +102,25 @@ const ErrorListRef StructDeclarationStatement::preprocess(
 	}
 
 	volatile_shared_ptr<definition_map> mapping = make_shared<definition_map>();
-	symbol_map::iterator iter;
+	SymbolMap::const_iterator iter;
 	if (ErrorList::IsTerminator(errors)) {
 		//we've evaluated everything without issue
 		//extract member declaration information into immutable MemberDefinition
 		for (iter = values->begin(); iter != values->end(); ++iter) {
-			const string member_name = iter->first;
-			auto symbol = iter->second;
+			const Atom& member_name = iter->first;
+			auto symbol = values->GetSymbol(iter->second);
 			const_shared_ptr<TypeSpecifier> type = symbol->GetType();
 			auto value = symbol->GetValue();
 			const_shared_ptr<MemberDefinition> definition = make_shared<
 					MemberDefinition>(type, value);
 			mapping->insert(
-					pair<const string, const_shared_ptr<MemberDefinition>>(
+					pair<const Atom, const_shared_ptr<MemberDefinition>>(
 							member_name, definition));
 		}
 	}
 
 	auto type = make_shared<CompoundType>(mapping, modifiers);
-	type_table->AddType(*GetName(), type);
+	type_table->AddType(GetNameAtom(), type);
 	return errors;
 }
 
@@ -50,10 +50,10 @@ const ErrorListRef StructInstantiationStatement::preprocess(
 
 	const_shared_ptr<CompoundType> type =
 			execution_context->GetTypeTable()->GetType(
-					m_type_specifier->GetTypeName());
+					m_type_specifier->GetTypeAtom());
 
 	if (type != CompoundType::GetDefaultCompoundType()) {
-		auto existing = execution_context->GetSymbol(GetName(), SHALLOW);
+		auto existing = execution_context->GetSymbol(GetNameAtom(), SHALLOW);
 		if (existing == Symbol::GetDefaultSymbol()) {
 			plain_shared_ptr<const CompoundTypeInstance> instance;
 			if (GetInitializerExpression()) {
@@ -64,28 +64,26 @@ const ErrorListRef StructInstantiationStatement::preprocess(
 
 				if (ErrorList::IsTerminator(errors)) {
 					const_shared_ptr<CompoundTypeSpecifier> as_compound_specifier =
-							std::dynamic_pointer_cast<
-									const CompoundTypeSpecifier>(
+							specifier_cast<CompoundTypeSpecifier>(
 									expression_type);
 
 					if (as_compound_specifier
-							&& m_type_specifier->GetTypeName().compare(
-									as_compound_specifier->GetTypeName())
-									== 0) {
+							&& m_type_specifier->GetTypeAtom()
+									== as_compound_specifier->GetTypeAtom()) {
 						if (GetInitializerExpression()->IsConstant()) {
 							const_shared_ptr<Result> result =
 									GetInitializerExpression()->Evaluate(
 											execution_context);
 							errors = result->GetErrors();
 							if (ErrorList::IsTerminator(errors)) {
-								instance = static_pointer_cast<
-										const CompoundTypeInstance>(
-										result->GetData());
+								instance =
+										result->GetData().GetReference<
+												CompoundTypeInstance>();
 							}
 						} else {
 							//generate default instance
 							instance = CompoundTypeInstance::GetDefaultInstance(
-									m_type_specifier->GetTypeName(), type);
+									m_type_specifier->GetTypeAtom(), type);
 						}
 					} else {
 						errors =
@@ -101,14 +99,14 @@ const ErrorListRef StructInstantiationStatement::preprocess(
 				}
 			} else {
 				instance = CompoundTypeInstance::GetDefaultInstance(
-						m_type_specifier->GetTypeName(), type);
+						m_type_specifier->GetTypeAtom(), type);
 			}
 
 			if (ErrorList::IsTerminator(errors)) {
 				//we've been able to get a good initial value (that is, no errors have occurred)
 				auto symbol = const_shared_ptr<Symbol>(new Symbol(instance));
 				const InsertResult insert_result =
-						execution_context->InsertSymbol(*GetName(), symbol);
+						execution_context->InsertSymbol(GetNameAtom(), symbol);
 
 				if (insert_result != INSERT_SUCCESS) {
 					assert(false);
@@ -151,8 +149,8 @@ const ErrorListRef StructInstantiationStatement::execute(
 		if (ErrorList::IsTerminator(errors)) {
 			auto void_value = evaluation->GetData();
 			const_shared_ptr<const CompoundTypeInstance> instance =
-					static_pointer_cast<const CompoundTypeInstance>(void_value);
-			execution_context->SetSymbol(*GetName(), instance);
+					void_value.GetReference<CompoundTypeInstance>();
+			execution_context->SetSymbol(GetNameAtom(), instance);
 		}
 	}
 
@@ -77,8 +77,8 @@ const ErrorListRef SumDeclarationStatement::preprocess(
 		symbol = make_shared<Symbol>(sum);
 	}
 
-	InsertResult insert_result = execution_context->InsertSymbol(*GetName(),
-			symbol);
+	InsertResult insert_result = execution_context->InsertSymbol(
+			GetNameAtom(), symbol);
 	if (insert_result == SYMBOL_EXISTS) {
 		errors = ErrorList::From(
 				make_shared<Error>(Error::SEMANTIC, Error::PREVIOUS_DECLARATION,
@@ -45,6 +45,10 @@ public:
 
 	virtual const_shared_ptr<TypeSpecifier> GetType() const;
 
+	const yy::location GetTypePosition() const {
+		return m_type_position;
+	}
+
 private:
 	const_shared_ptr<SumTypeSpecifier> m_type;
 	const yy::location m_type_position;
@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <statistics.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <iomanip>
+#include <vector>
+#include <benchmark.h>
+#include <bytecode.h>
+
+thread_local size_t Statistics::s_counters[COUNTER_COUNT];
+thread_local std::unordered_map<std::type_index, size_t> Statistics::s_nodes[
+		NODE_KIND_COUNT];
+
+namespace {
+thread_local size_t instruction_counts[OPCODE_COUNT];
+
+const char* const opcode_names[] = {
+#define OPCODE_NAME(name) #name,
+		OPCODES(OPCODE_NAME)
+#undef OPCODE_NAME
+		};
+
+const std::string Demangle(const char* name) {
+	int status = 0;
+	char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+	if (status != 0) {
+		return name;
+	}
+
+	const std::string result(demangled);
+	std::free(demangled);
+	return result;
+}
+
+void PrintCounts(std::ostream& out, const std::string& title,
+		std::vector<std::pair<std::string, size_t>> counts) {
+	//most frequent first
+	std::sort(counts.begin(), counts.end(),
+			[](const std::pair<std::string, size_t>& a,
+					const std::pair<std::string, size_t>& b) {
+				return a.second != b.second ?
+						a.second > b.second : a.first < b.first;
+			});
+
+	size_t total = 0;
+	for (const auto& count : counts) {
+		total += count.second;
+	}
+
+	out << title << ": " << total << std::endl;
+	for (const auto& count : counts) {
+		out << "  " << std::left << std::setw(36) << count.first << std::right
+				<< std::setw(14) << count.second << std::endl;
+	}
+}
+}
+
+void Statistics::CountInstruction(const int opcode) {
+	instruction_counts[opcode]++;
+}
+
+const bool Statistics::IsEnabled() {
+#ifdef NEWT_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Statistics::Print(std::ostream& out) {
+	PrintNodes(out, STATEMENTS, "statements executed");
+	PrintNodes(out, EXPRESSIONS, "expressions evaluated");
+
+	std::vector<std::pair<std::string, size_t>> instructions;
+	for (int i = 0; i < OPCODE_COUNT; i++) {
+		if (instruction_counts[i] > 0) {
+			instructions.push_back(
+					std::make_pair(opcode_names[i], instruction_counts[i]));
+		}
+	}
+	PrintCounts(out, "instructions executed", instructions);
+
+	const size_t lookups = s_counters[SYMBOL_LOOKUPS];
+	out << "symbol lookups: " << lookups << " (average depth "
+			<< std::fixed << std::setprecision(2)
+			<< (lookups ?
+					static_cast<double>(s_counters[SYMBOL_LOOKUP_DEPTH])
+							/ lookups :
+					0.0) << ")" << std::endl;
+	out << "results allocated: " << s_counters[RESULTS] << std::endl;
+	out << "error lists allocated: " << s_counters[ERROR_LISTS] << std::endl;
+	out << "allocations: " << Benchmark::GetAllocationCount() << " ("
+			<< s_counters[ALLOCATED_BYTES] << " bytes)" << std::endl;
+}
+
+void Statistics::PrintNodes(std::ostream& out, const NodeKind kind,
+		const std::string& title) {
+	std::vector<std::pair<std::string, size_t>> counts;
+	for (const auto& node : s_nodes[kind]) {
+		counts.push_back(
+				std::make_pair(Demangle(node.first.name()), node.second));
+	}
+	PrintCounts(out, title, counts);
+}
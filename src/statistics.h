@@ -0,0 +1,106 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATISTICS_H_
+#define STATISTICS_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+
+/**
+ * Counters of the work done by the interpreter, printed by the --stats flag.
+ *
+ * Counting is only compiled in when NEWT_STATS is defined (e.g. by adding
+ * -DNEWT_STATS to the compiler flags). Otherwise the STATISTICS_ macros expand
+ * to nothing, so the counters cost nothing in a regular build.
+ *
+ * The counters are kept per thread, and Print reports those of the calling
+ * thread.
+ */
+class Statistics {
+public:
+	enum Counter {
+		SYMBOL_LOOKUPS,
+		//the number of parent contexts walked by symbol lookups
+		SYMBOL_LOOKUP_DEPTH,
+		RESULTS,
+		ERROR_LISTS,
+		//the size of the allocations made through operator new
+		ALLOCATED_BYTES,
+		COUNTER_COUNT
+	};
+
+	enum NodeKind {
+		STATEMENTS, EXPRESSIONS, NODE_KIND_COUNT
+	};
+
+	static void Increment(const Counter counter, const size_t amount = 1) {
+		s_counters[counter] += amount;
+	}
+
+	/**
+	 * Count the execution of a syntax tree node of the given class.
+	 */
+	static void Count(const NodeKind kind, const std::type_info& type) {
+		s_nodes[kind][std::type_index(type)]++;
+	}
+
+	/**
+	 * Count the execution of a virtual machine instruction.
+	 */
+	static void CountInstruction(const int opcode);
+
+	static void Print(std::ostream& out);
+
+	/**
+	 * True if counting has been compiled in.
+	 */
+	static const bool IsEnabled();
+
+private:
+	static void PrintNodes(std::ostream& out, const NodeKind kind,
+			const std::string& title);
+
+	//plain arrays, since allocations are counted from operator new
+	static thread_local size_t s_counters[COUNTER_COUNT];
+	static thread_local std::unordered_map<std::type_index, size_t> s_nodes[
+			NODE_KIND_COUNT];
+};
+
+#ifdef NEWT_STATS
+#define STATISTICS_INCREMENT(counter) \
+	Statistics::Increment(Statistics::counter)
+#define STATISTICS_ADD(counter, amount) \
+	Statistics::Increment(Statistics::counter, amount)
+#define STATISTICS_COUNT(kind, node) \
+	Statistics::Count(Statistics::kind, typeid(node))
+#define STATISTICS_COUNT_INSTRUCTION(opcode) \
+	Statistics::CountInstruction(opcode)
+#else
+#define STATISTICS_INCREMENT(counter) ((void) 0)
+#define STATISTICS_ADD(counter, amount) ((void) 0)
+#define STATISTICS_COUNT(kind, node) ((void) 0)
+#define STATISTICS_COUNT_INSTRUCTION(opcode) ((void) 0)
+#endif
+
+#endif /* STATISTICS_H_ */
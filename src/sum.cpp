@@ -22,19 +22,24 @@
 #include <sstream>
 #include <indent.h>
 #include <symbol.h>
+#include <cycle_collector.h>
 
 Sum::Sum(const_shared_ptr<SumTypeSpecifier> type,
-		const_shared_ptr<TypeSpecifier> tag, const_shared_ptr<void> value) :
+		const_shared_ptr<TypeSpecifier> tag, const Value& value) :
 		m_type(type), m_tag(tag), m_value(value) {
 	assert(m_type);
 	assert(m_tag);
 	assert(m_type != m_tag);
-	assert(m_value);
+	assert(!m_value.IsEmpty());
 }
 
 Sum::~Sum() {
 }
 
+void Sum::Trace(Tracer& tracer) const {
+	tracer.Visit(m_tag, m_value);
+}
+
 const string Sum::ToString(const TypeTable& type_table,
 		const Indent& indent) const {
 	ostringstream buffer;
@@ -44,7 +49,7 @@ const string Sum::ToString(const TypeTable& type_table,
 }
 
 const_shared_ptr<Sum> Sum::WithValue(const_shared_ptr<TypeSpecifier> tag,
-		const_shared_ptr<void> value) const {
+		const Value& value) const {
 	if (!tag->IsAssignableTo(m_type)) {
 		return nullptr;
 	}
@@ -21,20 +21,22 @@
 #define SUM_H_
 
 #include <sum_type_specifier.h>
+#include <value.h>
 
 class Indent;
+class Tracer;
 
 class Sum {
 public:
 	Sum(const_shared_ptr<SumTypeSpecifier> type,
-			const_shared_ptr<TypeSpecifier> tag, const_shared_ptr<void> value);
+			const_shared_ptr<TypeSpecifier> tag, const Value& value);
 	virtual ~Sum();
 
 	const const_shared_ptr<SumTypeSpecifier> GetType() const {
 		return m_type;
 	}
 
-	const const_shared_ptr<void> GetValue() const {
+	const Value& GetValue() const {
 		return m_value;
 	}
 
@@ -45,12 +47,14 @@ public:
 	const string ToString(const TypeTable& type_table,
 			const Indent& indent) const;
 
+	void Trace(Tracer& tracer) const;
+
 	const_shared_ptr<Sum> WithValue(const_shared_ptr<TypeSpecifier> tag,
-			const_shared_ptr<void> value) const;
+			const Value& value) const;
 private:
 	const_shared_ptr<SumTypeSpecifier> m_type;
 	const_shared_ptr<TypeSpecifier> m_tag;
-	const_shared_ptr<void> m_value;
+	const Value m_value;
 };
 
 #endif /* SUM_H_ */
@@ -34,53 +34,47 @@
 #include <sum.h>
 #include <primitive_type_specifier.h>
 #include <memory>
+#include <cycle_collector.h>
 
-Symbol::Symbol(const_shared_ptr<bool> value) :
-		Symbol(PrimitiveTypeSpecifier::GetBoolean(),
-				static_pointer_cast<const void>(value)) {
+Symbol::Symbol(const bool value) :
+		Symbol(PrimitiveTypeSpecifier::GetBoolean(), Value(value)) {
 }
 
-Symbol::Symbol(const_shared_ptr<int> value) :
-		Symbol(PrimitiveTypeSpecifier::GetInt(),
-				static_pointer_cast<const void>(value)) {
+Symbol::Symbol(const int value) :
+		Symbol(PrimitiveTypeSpecifier::GetInt(), Value(value)) {
 }
 
-Symbol::Symbol(const_shared_ptr<double> value) :
-		Symbol(PrimitiveTypeSpecifier::GetDouble(),
-				static_pointer_cast<const void>(value)) {
+Symbol::Symbol(const double value) :
+		Symbol(PrimitiveTypeSpecifier::GetDouble(), Value(value)) {
 }
 
 Symbol::Symbol(const_shared_ptr<string> value) :
-		Symbol(PrimitiveTypeSpecifier::GetString(),
-				static_pointer_cast<const void>(value)) {
+		Symbol(PrimitiveTypeSpecifier::GetString(), value) {
 }
 
 Symbol::Symbol(const_shared_ptr<Array> value) :
-		Symbol(value->GetTypeSpecifier(),
-				static_pointer_cast<const void>(value)) {
+		Symbol(value->GetTypeSpecifier(), value) {
 }
 
 Symbol::Symbol(const_shared_ptr<CompoundTypeInstance> value) :
-		Symbol(value->GetTypeSpecifier(),
-				static_pointer_cast<const void>(value)) {
+		Symbol(value->GetTypeSpecifier(), value) {
 }
 
 Symbol::Symbol(const_shared_ptr<Function> value) :
-		Symbol(value->GetType(), static_pointer_cast<const void>(value)) {
+		Symbol(value->GetType(), value) {
 }
 
 Symbol::Symbol(const_shared_ptr<Sum> value) :
-		Symbol(value->GetType(), static_pointer_cast<const void>(value)) {
+		Symbol(value->GetType(), value) {
 }
 
-Symbol::Symbol(const_shared_ptr<TypeSpecifier> type,
-		const_shared_ptr<void> value) :
+Symbol::Symbol(const_shared_ptr<TypeSpecifier> type, const Value& value) :
 		m_type(type), m_value(value) {
 	assert(type);
 }
 
 const_shared_ptr<Symbol> Symbol::WithValue(const_shared_ptr<TypeSpecifier> type,
-		const_shared_ptr<void> value) const {
+		const Value& value) const {
 	if (!type->IsAssignableTo(this->m_type)) {
 		return GetDefaultSymbol();
 	}
@@ -93,9 +87,9 @@ const string Symbol::ToString(const TypeTable& type_table,
 	return ToString(m_type, m_value, type_table, indent);
 }
 
-const_shared_ptr<Symbol> Symbol::GetDefaultSymbol() {
-	const static const_shared_ptr<Symbol> DefaultSymbol = const_shared_ptr<
-			Symbol>(new Symbol(PrimitiveTypeSpecifier::GetNone(), nullptr));
+const_shared_ptr<Symbol>& Symbol::GetDefaultSymbol() {
+	const static const_shared_ptr<Symbol> DefaultSymbol = make_immortal(
+			new Symbol(PrimitiveTypeSpecifier::GetNone(), Value()));
 
 	return DefaultSymbol;
 }
@@ -103,46 +97,50 @@ const_shared_ptr<Symbol> Symbol::GetDefaultSymbol() {
 Symbol::~Symbol() {
 }
 
+void Symbol::Trace(Tracer& tracer) const {
+	tracer.Visit(m_type, m_value);
+}
+
 const string Symbol::ToString(const_shared_ptr<TypeSpecifier> type,
-		const_shared_ptr<void> value, const TypeTable& type_table,
+		const Value& value, const TypeTable& type_table,
 		const Indent& indent) {
 	ostringstream buffer;
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(type);
+			specifier_cast<PrimitiveTypeSpecifier>(type);
 	if (as_primitive) {
 		buffer << " ";
 		buffer << as_primitive->ToString(value);
 	}
 
-	const_shared_ptr<ArrayTypeSpecifier> as_array = std::dynamic_pointer_cast<
-			const ArrayTypeSpecifier>(type);
+	const_shared_ptr<ArrayTypeSpecifier> as_array =
+			specifier_cast<ArrayTypeSpecifier>(type);
 	if (as_array) {
 		buffer << endl;
-		auto array = static_pointer_cast<const Array>(value);
+		auto array = value.GetReference<Array>();
 		buffer << array->ToString(type_table, indent);
 	}
 
 	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(type);
+			specifier_cast<CompoundTypeSpecifier>(type);
 	if (as_compound) {
 		buffer << endl;
-		auto compound_type_instance = static_pointer_cast<
-				const CompoundTypeInstance>(value);
+		auto compound_type_instance = value.GetReference<
+				CompoundTypeInstance>();
 		buffer << compound_type_instance->ToString(type_table, indent + 1);
 	}
 
 	const_shared_ptr<FunctionTypeSpecifier> as_function =
-			std::dynamic_pointer_cast<const FunctionTypeSpecifier>(type);
+			specifier_cast<FunctionTypeSpecifier>(type);
 	if (as_function) {
 		buffer << endl;
-		auto function = static_pointer_cast<const Function>(value);
+		auto function = value.GetReference<Function>();
 		buffer << function->ToString(type_table, indent + 1);
 	}
 
-	const_shared_ptr<SumTypeSpecifier> as_sum = std::dynamic_pointer_cast<
-			const SumTypeSpecifier>(type);
+	const_shared_ptr<SumTypeSpecifier> as_sum =
+			specifier_cast<SumTypeSpecifier>(type);
 	if (as_sum) {
-		auto sum = static_pointer_cast<const Sum>(value);
+		auto sum = value.GetReference<Sum>();
 		buffer << sum->ToString(type_table, indent);
 	}
 
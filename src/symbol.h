@@ -26,6 +26,7 @@
 #include <defaults.h>
 #include <type.h>
 #include <indent.h>
+#include <value.h>
 
 using namespace std;
 
@@ -35,14 +36,15 @@ class Array;
 class CompoundTypeInstance;
 class Function;
 class Sum;
+class Tracer;
 
 class Symbol {
 	friend class SymbolContext;
 	friend class ReturnStatement;
 public:
-	Symbol(const_shared_ptr<bool> value);
-	Symbol(const_shared_ptr<int> value);
-	Symbol(const_shared_ptr<double> value);
+	Symbol(const bool value);
+	Symbol(const int value);
+	Symbol(const double value);
 	Symbol(const_shared_ptr<string> value);
 	Symbol(const_shared_ptr<Array> value);
 	Symbol(const_shared_ptr<CompoundTypeInstance> value);
@@ -55,29 +57,30 @@ public:
 		return m_type;
 	}
 
-	const_shared_ptr<void> GetValue() const {
+	const Value& GetValue() const {
 		return m_value;
 	}
 
-	static const_shared_ptr<Symbol> GetDefaultSymbol();
+	static const_shared_ptr<Symbol>& GetDefaultSymbol();
 
 	virtual const string ToString(const TypeTable& type_table,
 			const Indent& indent) const;
 
 	static const string ToString(const_shared_ptr<TypeSpecifier> type,
-			const_shared_ptr<void> value, const TypeTable& type_table,
+			const Value& value, const TypeTable& type_table,
 			const Indent& indent);
 
+	void Trace(Tracer& tracer) const;
+
 protected:
-	Symbol(const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value);
+	Symbol(const_shared_ptr<TypeSpecifier> type, const Value& value);
 
 	virtual const_shared_ptr<Symbol> WithValue(
-			const_shared_ptr<TypeSpecifier> type,
-			const_shared_ptr<void> value) const;
+			const_shared_ptr<TypeSpecifier> type, const Value& value) const;
 
 private:
 	const_shared_ptr<TypeSpecifier> m_type;
-	const_shared_ptr<void> m_value;
+	const Value m_value;
 };
 
 #endif /* SYMBOL_H_ */
@@ -20,6 +20,7 @@
 #include <compound_type_instance.h>
 #include <function.h>
 #include <function_declaration.h>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <defaults.h>
@@ -27,6 +28,7 @@
 #include "symbol_table.h"
 #include <execution_context.h>
 #include <sum.h>
+#include <cycle_collector.h>
 
 #include "type.h"
 #include "utils.h"
@@ -72,28 +74,54 @@ const ErrorListRef ToErrorListRef(const SetResult result,
 }
 
 SymbolContext::SymbolContext(const Modifier::Type modifiers) :
-		SymbolContext(modifiers, make_shared<symbol_map>()) {
+		SymbolContext(modifiers, make_shared<SymbolMap>()) {
 }
 
 SymbolContext::SymbolContext(const Modifier::Type modifiers,
-		const shared_ptr<symbol_map> values) :
+		const shared_ptr<SymbolMap> values) :
 		m_modifiers(modifiers), m_table(values) {
 }
 
 SymbolContext::~SymbolContext() {
 }
 
+void SymbolContext::Trace(Tracer& tracer) const {
+	tracer.Visit(m_table);
+}
+
+void SymbolMap::Trace(Tracer& tracer) const {
+	m_symbols.Trace(tracer, [&tracer](const plain_shared_ptr<Symbol>& symbol) {
+		tracer.Visit(symbol);
+	});
+}
+
 const_shared_ptr<Symbol> SymbolContext::GetSymbol(
-		const string& identifier) const {
-	auto result = m_table->find(identifier);
+		const Atom& identifier) const {
+	const size_t slot = m_table->GetSlot(identifier);
 
-	if (result != m_table->end()) {
-		return result->second;
+	if (slot != SymbolMap::NO_SLOT) {
+		return m_table->GetSymbol(slot);
 	} else {
 		return Symbol::GetDefaultSymbol();
 	}
 }
 
+const_shared_ptr<Symbol> SymbolContext::GetLocalSymbol(
+		const Atom& identifier, SymbolReference& reference) const {
+	if (!reference.IsIndex(m_table->GetIndex())) {
+		const size_t slot = m_table->GetSlot(identifier);
+		if (slot == SymbolMap::NO_SLOT) {
+			return Symbol::GetDefaultSymbol();
+		}
+
+		reference.depth = 0;
+		reference.slot = slot;
+		reference.index = m_table->GetIndex();
+	}
+
+	return m_table->GetSymbol(reference.slot);
+}
+
 const_shared_ptr<Symbol> SymbolContext::GetSymbol(
 		const_shared_ptr<string> identifier) const {
 	const_shared_ptr<Symbol> result = GetSymbol(*identifier);
@@ -102,99 +130,97 @@ const_shared_ptr<Symbol> SymbolContext::GetSymbol(
 
 const void SymbolContext::print(ostream &os, const TypeTable& type_table,
 		const Indent& indent) const {
-	symbol_map::iterator iter;
-	for (iter = m_table->begin(); iter != m_table->end(); ++iter) {
-		const string name = iter->first;
-		auto symbol = iter->second;
-		os << indent << symbol->GetType()->ToString() << " " << name << ":";
+	std::vector<Atom> names;
+	for (auto iter = m_table->begin(); iter != m_table->end(); ++iter) {
+		names.push_back(iter->first);
+	}
+	std::sort(names.begin(), names.end(), Atom::NameLess);
+
+	for (auto iter = names.begin(); iter != names.end(); ++iter) {
+		auto symbol = m_table->GetSymbol(m_table->GetSlot(*iter));
+		os << indent << symbol->GetType()->ToString() << " " << iter->GetName()
+				<< ":";
 		os << symbol->ToString(type_table, indent);
 		os << endl;
 	}
 }
 
-SetResult SymbolContext::SetSymbol(const string& identifier,
-		const_shared_ptr<bool> value) {
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
+		const bool value) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetBoolean(),
-			static_pointer_cast<const void>(value));
+			Value(value));
 }
-SetResult SymbolContext::SetSymbol(const string& identifier,
-		const_shared_ptr<int> value) {
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
+		const int value) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetInt(),
-			static_pointer_cast<const void>(value));
+			Value(value));
 }
-SetResult SymbolContext::SetSymbol(const string& identifier,
-		const_shared_ptr<double> value) {
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
+		const double value) {
 	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetDouble(),
-			static_pointer_cast<const void>(value));
+			Value(value));
 }
-SetResult SymbolContext::SetSymbol(const string& identifier,
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
 		const_shared_ptr<string> value) {
-	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetString(),
-			static_pointer_cast<const void>(value));
+	return SetSymbol(identifier, PrimitiveTypeSpecifier::GetString(), value);
 }
 
-SetResult SymbolContext::SetSymbol(const string& identifier,
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
 		const_shared_ptr<CompoundTypeInstance> value) {
-	return SetSymbol(identifier, value->GetTypeSpecifier(),
-			static_pointer_cast<const void>(value));
+	return SetSymbol(identifier, value->GetTypeSpecifier(), value);
 }
 
-SetResult SymbolContext::SetSymbol(const string& identifier,
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
 		const_shared_ptr<Array> value) {
-	return SetSymbol(identifier, value->GetTypeSpecifier(),
-			static_pointer_cast<const void>(value));
+	return SetSymbol(identifier, value->GetTypeSpecifier(), value);
 }
 
-SetResult SymbolContext::SetSymbol(const string& identifier,
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
 		const_shared_ptr<Function> value) {
-	return SetSymbol(identifier, value->GetType(),
-			static_pointer_cast<const void>(value));
+	return SetSymbol(identifier, value->GetType(), value);
 }
 
-SetResult SymbolContext::SetSymbol(const string& identifier,
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
 		const_shared_ptr<Sum> value) {
-	return SetSymbol(identifier, value->GetType(),
-			static_pointer_cast<const void>(value));
+	return SetSymbol(identifier, value->GetType(), value);
 }
 
-volatile_shared_ptr<SymbolContext> SymbolContext::GetDefault() {
-	static volatile_shared_ptr<SymbolContext> instance = make_shared<
+const_shared_ptr<SymbolContext> SymbolContext::GetDefault() {
+	static const_shared_ptr<SymbolContext> instance = make_shared<
 			SymbolContext>(Modifier::READONLY);
 	return instance;
 }
 
-SetResult SymbolContext::SetSymbol(const string& identifier,
-		const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value) {
-	auto result = m_table->find(identifier);
+SetResult SymbolContext::SetSymbol(const Atom& identifier,
+		const_shared_ptr<TypeSpecifier> type, const Value& value) {
+	const size_t slot = m_table->GetSlot(identifier);
 
-	if (result != m_table->end()) {
-		auto symbol = result->second;
-		if ((symbol->GetType()->IsAssignableTo(type))) {
-			if (m_modifiers & Modifier::READONLY) {
-				return MUTATION_DISALLOWED;
-			} else {
-				auto new_symbol = symbol->WithValue(type, value);
-
-				//TODO: error checking
-				m_table->erase(identifier);
-				m_table->insert(
-						std::pair<const string, const_shared_ptr<Symbol>>(
-								identifier, new_symbol));
+	if (slot != SymbolMap::NO_SLOT) {
+		return SetSlot(slot, type, value);
+	} else {
+		return UNDEFINED_SYMBOL;
+	}
+}
 
-				return SET_SUCCESS;
-			}
+SetResult SymbolContext::SetSlot(const size_t slot,
+		const_shared_ptr<TypeSpecifier> type, const Value& value) {
+	auto symbol = m_table->GetSymbol(slot);
+	if ((symbol->GetType()->IsAssignableTo(type))) {
+		if (m_modifiers & Modifier::READONLY) {
+			return MUTATION_DISALLOWED;
 		} else {
-			return INCOMPATIBLE_TYPE;
+			m_table->SetSymbol(slot, symbol->WithValue(type, value));
+			return SET_SUCCESS;
 		}
 	} else {
-		return UNDEFINED_SYMBOL;
+		return INCOMPATIBLE_TYPE;
 	}
 }
 
 volatile_shared_ptr<SymbolContext> SymbolContext::Clone() const {
 	return volatile_shared_ptr<SymbolContext>(
 			new SymbolContext(m_modifiers,
-					make_shared<symbol_map>(m_table->begin(), m_table->end())));
+					make_shared<SymbolMap>(*m_table)));
 }
 
 SymbolContext::SymbolContext(const SymbolContext& other) :
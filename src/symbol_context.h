@@ -22,12 +22,16 @@
 
 #include <array.h>
 #include <iostream>
-#include <map>
+#include <unordered_map>
+#include <vector>
+#include <atom.h>
 #include <modifier.h>
 #include <symbol.h>
+#include <persistent_vector.h>
 
 class CompoundTypeInstance;
 class Function;
+class Tracer;
 
 using namespace std;
 
@@ -44,15 +48,158 @@ const ErrorListRef ToErrorListRef(const SetResult result,
 		const_shared_ptr<TypeSpecifier> symbol_type,
 		const_shared_ptr<TypeSpecifier> value_type);
 
-struct comparator {
-	bool operator()(const string& lhs, const string& rhs) const {
-		return lhs < rhs;
+typedef unordered_map<Atom, size_t> slot_map;
+
+/**
+ * The names of a symbol map's slots, indexed both ways.
+ */
+struct SymbolIndex {
+	slot_map slots;
+	std::vector<Atom> names;
+};
+
+/**
+ * The symbols of a single scope. Symbols are stored in a flat vector of slots in
+ * insertion order, so that resolved references can index them directly. The name
+ * index is a hash table keyed by atom, so it is unordered; output that lists
+ * names must sort them itself.
+ *
+ * Copies share the name index until one of them inserts a new symbol. The slots
+ * are a persistent vector, so copies also share their slots until one of them
+ * sets a slot, which copies only the block of slots that holds it. Copying a
+ * table is therefore O(1). In particular, all instances of a struct type share
+ * the index of the type's layout.
+ */
+class SymbolMap {
+public:
+	typedef slot_map::const_iterator const_iterator;
+
+	SymbolMap() :
+			m_index(), m_symbols() {
+	}
+
+	SymbolMap(const SymbolMap& other) :
+			m_index(other.m_index), m_symbols(other.m_symbols) {
+	}
+
+	const size_t GetSlot(const Atom& name) const {
+		if (!m_index) {
+			return NO_SLOT;
+		}
+
+		auto result = m_index->slots.find(name);
+		if (result != m_index->slots.end()) {
+			return result->second;
+		} else {
+			return NO_SLOT;
+		}
+	}
+
+	const bool HasSlot(const size_t slot, const Atom& name) const {
+		return m_index && slot < m_index->names.size()
+				&& m_index->names[slot] == name;
+	}
+
+	/**
+	 * The index of slot names. Slots are only ever appended to an index, so a slot
+	 * resolved against an index continues to hold the same name for as long as the
+	 * index exists.
+	 */
+	const shared_ptr<SymbolIndex>& GetIndex() const {
+		return m_index;
+	}
+
+	const_shared_ptr<Symbol>& GetSymbol(const size_t slot) const {
+		return m_symbols.Get(slot);
+	}
+
+	void SetSymbol(const size_t slot, const_shared_ptr<Symbol> symbol) {
+		m_symbols.Set(slot, symbol);
+	}
+
+	/**
+	 * Add a symbol in a new slot. Returns false if the name is already taken.
+	 */
+	const bool Insert(const Atom& name, const_shared_ptr<Symbol> symbol) {
+		if (GetSlot(name) != NO_SLOT) {
+			return false;
+		}
+
+		if (!m_index) {
+			m_index = make_shared<SymbolIndex>();
+		} else if (!m_index.unique()) {
+			m_index = make_shared<SymbolIndex>(*m_index);
+		}
+
+		m_index->slots.insert(
+				std::pair<const Atom, size_t>(name, m_symbols.GetSize()));
+		m_symbols.Append(symbol);
+		m_index->names.push_back(name);
+		return true;
+	}
+
+	const size_t GetSize() const {
+		return m_symbols.GetSize();
+	}
+
+	/**
+	 * Remove every symbol. Used by the cycle collector to release the table of a
+	 * frame that is no longer reachable.
+	 */
+	void Clear() {
+		m_index = nullptr;
+		m_symbols = PersistentVector<plain_shared_ptr<Symbol>, 3>();
+	}
+
+	void Trace(Tracer& tracer) const;
+
+	const_iterator begin() const {
+		return m_index ? m_index->slots.begin() : GetEmptyIndex().begin();
+	}
+
+	const_iterator end() const {
+		return m_index ? m_index->slots.end() : GetEmptyIndex().end();
+	}
+
+	static const size_t NO_SLOT = static_cast<size_t>(-1);
+
+private:
+	SymbolMap& operator=(const SymbolMap&);
+
+	static const slot_map& GetEmptyIndex() {
+		static const slot_map empty_index;
+		return empty_index;
 	}
+
+	shared_ptr<SymbolIndex> m_index;
+	PersistentVector<plain_shared_ptr<Symbol>, 3> m_symbols;
 };
 
-typedef map<const string, plain_shared_ptr<Symbol>, comparator> symbol_map;
+/**
+ * The resolved location of a symbol: the number of parent contexts to traverse from
+ * the referencing context, and the slot in the table of the context so reached.
+ *
+ * The index the slot was resolved against is also recorded; while the table
+ * reached still has that index, the slot is known to hold the symbol without
+ * comparing names. The index is held weakly so that it remains free to grow.
+ */
+struct SymbolReference {
+	SymbolReference() :
+			depth(-1), slot(0), index() {
+	}
+
+	const bool IsIndex(const shared_ptr<SymbolIndex>& other) const {
+		return !index.owner_before(other) && !other.owner_before(index)
+				&& other;
+	}
+
+	int depth;
+	size_t slot;
+	std::weak_ptr<SymbolIndex> index;
+};
 
 class SymbolContext {
+	friend class CycleCollector;
 public:
 	SymbolContext(const Modifier::Type modifiers);
 	SymbolContext(const SymbolContext&);
@@ -76,42 +223,68 @@ public:
 		return m_modifiers & Modifier::READONLY;
 	}
 
+	/**
+	 * Copy this context's table. The copy shares its symbols with the original.
+	 */
+	const shared_ptr<SymbolMap> CopyTable() const {
+		return make_shared<SymbolMap>(*m_table);
+	}
+
 	const void print(ostream &os, const TypeTable& type_table,
 			const Indent& indent) const;
 
 	const_shared_ptr<Symbol> GetSymbol(
 			const_shared_ptr<string> identifier) const;
-	const_shared_ptr<Symbol> GetSymbol(const string& identifier) const;
+	const_shared_ptr<Symbol> GetSymbol(const Atom& identifier) const;
+
+	/**
+	 * Look up a symbol in this context's own table through a reference resolved by a
+	 * previous lookup, re-resolving the reference against this table if it is stale.
+	 */
+	const_shared_ptr<Symbol> GetLocalSymbol(const Atom& identifier,
+			SymbolReference& reference) const;
 
-	SetResult SetSymbol(const string& identifier, const_shared_ptr<bool> value);
-	SetResult SetSymbol(const string& identifier, const_shared_ptr<int> value);
-	SetResult SetSymbol(const string& identifier,
-			const_shared_ptr<double> value);
-	SetResult SetSymbol(const string& identifier,
+	SetResult SetSymbol(const Atom& identifier, const bool value);
+	SetResult SetSymbol(const Atom& identifier, const int value);
+	SetResult SetSymbol(const Atom& identifier, const double value);
+	SetResult SetSymbol(const Atom& identifier,
 			const_shared_ptr<string> value);
-	SetResult SetSymbol(const string& identifier,
+	SetResult SetSymbol(const Atom& identifier,
 			const_shared_ptr<Array> value);
-	SetResult SetSymbol(const string& identifier,
+	SetResult SetSymbol(const Atom& identifier,
 			const_shared_ptr<CompoundTypeInstance> value);
-	SetResult SetSymbol(const string& identifier,
+	SetResult SetSymbol(const Atom& identifier,
 			const_shared_ptr<Function> value);
-	SetResult SetSymbol(const string& identifier, const_shared_ptr<Sum> value);
+	SetResult SetSymbol(const Atom& identifier, const_shared_ptr<Sum> value);
+
+	/**
+	 * An empty, read-only context. It is shared by every thread, so it is
+	 * const.
+	 */
+	static const_shared_ptr<SymbolContext> GetDefault();
 
-	static volatile_shared_ptr<SymbolContext> GetDefault();
+	virtual void Trace(Tracer& tracer) const;
 
 protected:
-	const shared_ptr<symbol_map> GetTable() const {
+	const shared_ptr<SymbolMap>& GetTable() const {
 		return m_table;
 	}
 
 	SymbolContext(const Modifier::Type modifiers,
-			const shared_ptr<symbol_map> values);
+			const shared_ptr<SymbolMap> values);
+
+	virtual SetResult SetSymbol(const Atom& identifier,
+			const_shared_ptr<TypeSpecifier> type, const Value& value);
 
-	virtual SetResult SetSymbol(const string& identifier,
-			const_shared_ptr<TypeSpecifier> type, const_shared_ptr<void> value);
+	/**
+	 * Set the symbol in the given slot of this context's table, subject to the
+	 * same checks as setting it by name.
+	 */
+	SetResult SetSlot(const size_t slot, const_shared_ptr<TypeSpecifier> type,
+			const Value& value);
 private:
 	const Modifier::Type m_modifiers;
-	const shared_ptr<symbol_map> m_table;
+	const shared_ptr<SymbolMap> m_table;
 };
 
 #endif /* SYMBOL_CONTEXT_H_ */
@@ -19,6 +19,8 @@
 
 #include <symbol_context_list.h>
 #include <execution_context.h>
+#include <frame_pool.h>
+#include <cycle_collector.h>
 
 shared_ptr<SymbolContextList> SymbolContextList::From(
 		const shared_ptr<ExecutionContext> context,
@@ -28,8 +30,13 @@ shared_ptr<SymbolContextList> SymbolContextList::From(
 		return shared_ptr<SymbolContextList>(
 				new SymbolContextList(weak, context_parent));
 	} else {
-		return shared_ptr<SymbolContextList>(
-				new SymbolContextList(context, context_parent));
+		return allocate_shared<SymbolContextList>(
+				FrameAllocator<SymbolContextList>(), context, context_parent);
 	}
 
 }
+
+void SymbolContextList::Trace(Tracer& tracer) const {
+	tracer.Visit(m_data);
+	tracer.Visit(m_next);
+}
@@ -28,6 +28,8 @@ using namespace std;
 using namespace std;
 
 class ExecutionContext;
+class Tracer;
+template<typename T> class FrameAllocator;
 
 class SymbolContextList {
 public:
@@ -42,6 +44,18 @@ public:
 		}
 	}
 
+	/**
+	 * Get the context without taking a reference to it. The caller must ensure that
+	 * the context outlives its use.
+	 */
+	ExecutionContext* GetRawData() const {
+		if (m_data) {
+			return m_data.get();
+		} else {
+			return m_weak_data.lock().get();
+		}
+	}
+
 	bool IsWeak() const {
 		return !m_data;
 	}
@@ -63,7 +77,11 @@ public:
 		return terminator;
 	}
 
+	void Trace(Tracer& tracer) const;
+
 private:
+	template<typename U> friend class FrameAllocator;
+
 	SymbolContextList(const shared_ptr<ExecutionContext> data) :
 			SymbolContextList(data, GetTerminator()) {
 	}
@@ -37,25 +37,16 @@ SymbolTable::SymbolTable(const Modifier::Type modifiers) :
 }
 
 SymbolTable::SymbolTable(const Modifier::Type modifiers,
-		const shared_ptr<symbol_map> values) :
+		const shared_ptr<SymbolMap> values) :
 		SymbolContext(modifiers, values) {
 }
 
-InsertResult SymbolTable::InsertSymbol(const string& name,
+InsertResult SymbolTable::InsertSymbol(const Atom& name,
 		const_shared_ptr<Symbol> symbol) {
-	symbol_map::iterator search_result;
-
-	auto table = GetTable();
-	search_result = table->find(name);
-
-	if (search_result != table->end()) {
-		return SYMBOL_EXISTS;
-	} else {
-		table->insert(
-				std::pair<const string, const_shared_ptr<Symbol>>(name,
-						symbol));
-
+	if (GetTable()->Insert(name, symbol)) {
 		return INSERT_SUCCESS;
+	} else {
+		return SYMBOL_EXISTS;
 	}
 }
 
@@ -33,10 +33,10 @@ public:
 	SymbolTable();
 	SymbolTable(const Modifier::Type modifiers);
 	SymbolTable(const Modifier::Type modifiers,
-			const shared_ptr<symbol_map> values);
+			const shared_ptr<SymbolMap> values);
 	SymbolTable(const SymbolContext& other);
 
-	InsertResult InsertSymbol(const string& name,
+	InsertResult InsertSymbol(const Atom& name,
 			const_shared_ptr<Symbol> symbol);
 };
 
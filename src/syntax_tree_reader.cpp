@@ -0,0 +1,699 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <syntax_tree_reader.h>
+#include <cstring>
+#include <driver.h>
+#include <statement_block.h>
+#include <array_declaration_statement.h>
+#include <assignment_statement.h>
+#include <exit_statement.h>
+#include <for_statement.h>
+#include <function_declaration_statement.h>
+#include <if_statement.h>
+#include <inferred_declaration_statement.h>
+#include <invoke_statement.h>
+#include <primitive_declaration_statement.h>
+#include <print_statement.h>
+#include <return_statement.h>
+#include <struct_declaration_statement.h>
+#include <struct_instantiation_statement.h>
+#include <sum_declaration_statement.h>
+#include <arithmetic_expression.h>
+#include <comparison_expression.h>
+#include <constant_expression.h>
+#include <default_value_expression.h>
+#include <function_expression.h>
+#include <invoke_expression.h>
+#include <logic_expression.h>
+#include <unary_expression.h>
+#include <variable_expression.h>
+#include <with_expression.h>
+#include <array_variable.h>
+#include <basic_variable.h>
+#include <member_variable.h>
+#include <array_type_specifier.h>
+#include <compound_type_specifier.h>
+#include <function_declaration.h>
+#include <primitive_type_specifier.h>
+#include <sum_type_specifier.h>
+
+SyntaxTreeReader::SyntaxTreeReader(Driver& driver, const char* data,
+		const size_t size) :
+		m_driver(driver), m_data(data), m_end(data + size), m_strings(),
+				m_line(0), m_failed(false) {
+}
+
+SyntaxTreeReader::~SyntaxTreeReader() {
+}
+
+const_shared_ptr<StatementBlock> SyntaxTreeReader::Read() {
+	const size_t string_count = ReadCount();
+	m_strings.reserve(string_count);
+	for (size_t i = 0; i < string_count && !m_failed; i++) {
+		const size_t length = ReadCount();
+		if (!m_failed) {
+			m_strings.push_back(make_shared<string>(m_data, length));
+			m_data += length;
+		}
+	}
+
+	auto result = ReadBlock();
+	if (m_failed || m_data != m_end) {
+		return nullptr;
+	}
+
+	return result;
+}
+
+const_shared_ptr<StatementBlock> SyntaxTreeReader::ReadBlock() {
+	const size_t count = ReadCount();
+	std::vector<plain_shared_ptr<Statement>> statements;
+	statements.reserve(count);
+	for (size_t i = 0; i < count && !m_failed; i++) {
+		statements.push_back(ReadStatement());
+	}
+	const yy::location location = ReadLocation();
+	if (m_failed) {
+		return nullptr;
+	}
+
+	StatementListRef list = StatementList::GetTerminator();
+	for (auto iter = statements.rbegin(); iter != statements.rend(); ++iter) {
+		list = StatementList::From(*iter, list, m_driver.GetAllocator());
+	}
+	return m_driver.Create<StatementBlock>(list, location);
+}
+
+const_shared_ptr<StatementBlock> SyntaxTreeReader::ReadOptionalBlock() {
+	if (ReadUnsigned() == 0) {
+		return nullptr;
+	}
+	return ReadBlock();
+}
+
+const_shared_ptr<Statement> SyntaxTreeReader::ReadStatement() {
+	auto result = ReadStatement(ReadTag());
+	if (!result) {
+		Fail();
+	}
+	return result;
+}
+
+const_shared_ptr<Statement> SyntaxTreeReader::ReadStatement(
+		const SyntaxTreeTag tag) {
+	switch (tag) {
+	case DECLARATION_STATEMENT:
+	case STRUCT_DECLARATION_STATEMENT:
+		return ReadDeclaration(tag);
+	case ASSIGNMENT_STATEMENT: {
+		auto variable = ReadVariable();
+		const uint64_t op_type = ReadUnsigned();
+		auto expression = ReadExpression();
+		if (m_failed || op_type > MINUS_ASSIGN) {
+			return nullptr;
+		}
+		return m_driver.Create<AssignmentStatement>(variable,
+				AssignmentType(op_type), expression);
+	}
+	case EXIT_STATEMENT: {
+		auto expression = ReadOptionalExpression();
+		if (m_failed) {
+			return nullptr;
+		}
+		return expression ?
+				m_driver.Create<ExitStatement>(expression) :
+				m_driver.Create<ExitStatement>();
+	}
+	case FOR_STATEMENT: {
+		auto initial = ReadStatement();
+		auto loop_expression = ReadExpression();
+		auto loop_assignment = dynamic_pointer_cast<const AssignmentStatement>(
+				ReadStatement());
+		auto statement_block = ReadBlock();
+		if (m_failed || !loop_assignment) {
+			return nullptr;
+		}
+
+		if (auto as_assignment = dynamic_pointer_cast<
+				const AssignmentStatement>(initial)) {
+			return m_driver.Create<ForStatement>(as_assignment,
+					loop_expression, loop_assignment, statement_block);
+		} else if (auto as_declaration = dynamic_pointer_cast<
+				const DeclarationStatement>(initial)) {
+			return m_driver.Create<ForStatement>(as_declaration,
+					loop_expression, loop_assignment, statement_block);
+		}
+		return nullptr;
+	}
+	case IF_STATEMENT: {
+		auto expression = ReadExpression();
+		auto block = ReadBlock();
+		auto else_block = ReadOptionalBlock();
+		if (m_failed) {
+			return nullptr;
+		}
+		return else_block ?
+				m_driver.Create<IfStatement>(expression, block, else_block) :
+				m_driver.Create<IfStatement>(expression, block);
+	}
+	case INVOKE_STATEMENT: {
+		auto variable = ReadVariable();
+		auto argument_list = ReadArgumentList();
+		const yy::location argument_list_position = ReadLocation();
+		if (m_failed) {
+			return nullptr;
+		}
+		return m_driver.Create<InvokeStatement>(variable, argument_list,
+				argument_list_position);
+	}
+	case PRINT_STATEMENT: {
+		const int line_number = ReadSigned();
+		auto expression = ReadExpression();
+		if (m_failed) {
+			return nullptr;
+		}
+		return m_driver.Create<PrintStatement>(line_number, expression);
+	}
+	case RETURN_STATEMENT: {
+		auto expression = ReadExpression();
+		if (m_failed) {
+			return nullptr;
+		}
+		return m_driver.Create<ReturnStatement>(expression);
+	}
+	default:
+		return nullptr;
+	}
+}
+
+const_shared_ptr<DeclarationStatement> SyntaxTreeReader::ReadDeclaration() {
+	auto result = ReadDeclaration(ReadTag());
+	if (!result) {
+		Fail();
+	}
+	return result;
+}
+
+const_shared_ptr<DeclarationStatement> SyntaxTreeReader::ReadDeclaration(
+		const SyntaxTreeTag tag) {
+	if (tag == STRUCT_DECLARATION_STATEMENT) {
+		const yy::location position = ReadLocation();
+		auto name = ReadString();
+		const yy::location name_position = ReadLocation();
+		auto member_declaration_list = ReadDeclarationList();
+		const yy::location member_declaration_list_position = ReadLocation();
+		auto modifier_list = ReadModifierList();
+		const yy::location modifiers_location = ReadLocation();
+		if (m_failed) {
+			return nullptr;
+		}
+
+		return m_driver.Create<StructDeclarationStatement>(position,
+				CompoundTypeSpecifier::Get(*name), name, name_position,
+				member_declaration_list, member_declaration_list_position,
+				modifier_list, modifiers_location);
+	} else if (tag != DECLARATION_STATEMENT) {
+		return nullptr;
+	}
+
+	const yy::location position = ReadLocation();
+	auto type = ReadOptionalType();
+	const yy::location type_position =
+			type ? ReadLocation() : GetDefaultLocation();
+	auto name = ReadString();
+	const yy::location name_position = ReadLocation();
+	auto initializer_expression = ReadOptionalExpression();
+	if (m_failed) {
+		return nullptr;
+	}
+
+	//as in the grammar, the kind of declaration follows from the kind of type
+	if (!type) {
+		if (!initializer_expression) {
+			return nullptr;
+		}
+		return m_driver.Create<InferredDeclarationStatement>(position, name,
+				name_position, initializer_expression);
+	}
+
+	switch (type->GetKind()) {
+	case TypeSpecifier::PRIMITIVE:
+		return m_driver.Create<PrimitiveDeclarationStatement>(position, type,
+				type_position, name, name_position, initializer_expression);
+	case TypeSpecifier::ARRAY:
+		return m_driver.Create<ArrayDeclarationStatement>(position,
+				specifier_cast<ArrayTypeSpecifier>(type), type_position, name,
+				name_position, initializer_expression);
+	case TypeSpecifier::COMPOUND:
+		return m_driver.Create<StructInstantiationStatement>(position,
+				specifier_cast<CompoundTypeSpecifier>(type), type_position,
+				name, name_position, initializer_expression);
+	case TypeSpecifier::FUNCTION:
+		return m_driver.Create<FunctionDeclarationStatement>(position,
+				specifier_cast<FunctionTypeSpecifier>(type), type_position,
+				name, name_position, initializer_expression);
+	case TypeSpecifier::SUM:
+		return m_driver.Create<SumDeclarationStatement>(position,
+				specifier_cast<SumTypeSpecifier>(type), type_position, name,
+				name_position, initializer_expression);
+	default:
+		return nullptr;
+	}
+}
+
+DeclarationListRef SyntaxTreeReader::ReadDeclarationList() {
+	const size_t count = ReadCount();
+	std::vector<plain_shared_ptr<DeclarationStatement>> declarations;
+	declarations.reserve(count);
+	for (size_t i = 0; i < count && !m_failed; i++) {
+		declarations.push_back(ReadDeclaration());
+	}
+
+	DeclarationListRef result = DeclarationList::GetTerminator();
+	for (auto iter = declarations.rbegin(); iter != declarations.rend();
+			++iter) {
+		result = DeclarationList::From(*iter, result, m_driver.GetAllocator());
+	}
+	return result;
+}
+
+const_shared_ptr<Expression> SyntaxTreeReader::ReadExpression() {
+	auto result = ReadOptionalExpression();
+	if (!result) {
+		Fail();
+	}
+	return result;
+}
+
+const_shared_ptr<Expression> SyntaxTreeReader::ReadOptionalExpression() {
+	const SyntaxTreeTag tag = ReadTag();
+	switch (tag) {
+	case NO_NODE:
+		return nullptr;
+	case ARITHMETIC_EXPRESSION:
+	case COMPARISON_EXPRESSION:
+	case LOGIC_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		const uint64_t op = ReadUnsigned();
+		auto left = ReadExpression();
+		auto right = ReadExpression();
+		if (m_failed || op > GREATER_THAN_EQUAL) {
+			break;
+		}
+
+		const OperatorType operator_type = OperatorType(op);
+		if (tag == ARITHMETIC_EXPRESSION) {
+			return m_driver.Create<const ArithmeticExpression>(position,
+					operator_type, left, right);
+		} else if (tag == COMPARISON_EXPRESSION) {
+			return m_driver.Create<const ComparisonExpression>(position,
+					operator_type, left, right);
+		} else {
+			return m_driver.Create<const LogicExpression>(position,
+					operator_type, left, right);
+		}
+	}
+	case BOOLEAN_CONSTANT_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		const bool value = ReadUnsigned() != 0;
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<const ConstantExpression>(position, value);
+	}
+	case INT_CONSTANT_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		const int value = ReadSigned();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<const ConstantExpression>(position, value);
+	}
+	case DOUBLE_CONSTANT_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		const double value = ReadDouble();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<const ConstantExpression>(position, value);
+	}
+	case STRING_CONSTANT_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		const_shared_ptr<string> value = ReadString();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<const ConstantExpression>(position, value);
+	}
+	case DEFAULT_VALUE_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		auto type = ReadType();
+		const yy::location type_position = ReadLocation();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<const DefaultValueExpression>(position, type,
+				type_position);
+	}
+	case FUNCTION_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		auto parameter_list = ReadDeclarationList();
+		auto return_type = ReadType();
+		auto body = ReadBlock();
+		if (m_failed) {
+			break;
+		}
+		auto declaration = m_driver.Create<FunctionDeclaration>(
+				parameter_list, return_type);
+		return m_driver.Create<FunctionExpression>(position, declaration,
+				body);
+	}
+	case INVOKE_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		auto expression = ReadExpression();
+		auto argument_list = ReadArgumentList();
+		const yy::location argument_list_position = ReadLocation();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<InvokeExpression>(position, expression,
+				argument_list, argument_list_position);
+	}
+	case UNARY_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		const uint64_t op = ReadUnsigned();
+		auto expression = ReadExpression();
+		if (m_failed || op > GREATER_THAN_EQUAL) {
+			break;
+		}
+		return m_driver.Create<const UnaryExpression>(position,
+				OperatorType(op), expression);
+	}
+	case VARIABLE_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		auto variable = ReadVariable();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<VariableExpression>(position, variable);
+	}
+	case WITH_EXPRESSION: {
+		const yy::location position = ReadLocation();
+		auto source_expression = ReadExpression();
+		auto member_instantiation_list = ReadMemberInstantiationList();
+		const yy::location member_instantiation_list_position =
+				ReadLocation();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<const WithExpression>(position,
+				source_expression, member_instantiation_list,
+				member_instantiation_list_position);
+	}
+	default:
+		break;
+	}
+
+	Fail();
+	return nullptr;
+}
+
+ArgumentListRef SyntaxTreeReader::ReadArgumentList() {
+	const size_t count = ReadCount();
+	std::vector<plain_shared_ptr<Expression>> arguments;
+	arguments.reserve(count);
+	for (size_t i = 0; i < count && !m_failed; i++) {
+		arguments.push_back(ReadExpression());
+	}
+
+	ArgumentListRef result = ArgumentList::GetTerminator();
+	for (auto iter = arguments.rbegin(); iter != arguments.rend(); ++iter) {
+		result = ArgumentList::From(*iter, result, m_driver.GetAllocator());
+	}
+	return result;
+}
+
+MemberInstantiationListRef SyntaxTreeReader::ReadMemberInstantiationList() {
+	const size_t count = ReadCount();
+	std::vector<plain_shared_ptr<MemberInstantiation>> instantiations;
+	instantiations.reserve(count);
+	for (size_t i = 0; i < count && !m_failed; i++) {
+		auto name = ReadString();
+		const yy::location name_position = ReadLocation();
+		auto expression = ReadExpression();
+		if (!m_failed) {
+			instantiations.push_back(
+					m_driver.Create<MemberInstantiation>(name, name_position,
+							expression));
+		}
+	}
+
+	MemberInstantiationListRef result =
+			MemberInstantiationList::GetTerminator();
+	for (auto iter = instantiations.rbegin(); iter != instantiations.rend();
+			++iter) {
+		result = MemberInstantiationList::From(*iter, result,
+				m_driver.GetAllocator());
+	}
+	return result;
+}
+
+ModifierListRef SyntaxTreeReader::ReadModifierList() {
+	const size_t count = ReadCount();
+	std::vector<plain_shared_ptr<Modifier>> modifiers;
+	modifiers.reserve(count);
+	for (size_t i = 0; i < count && !m_failed; i++) {
+		const uint64_t type = ReadUnsigned();
+		const yy::location type_position = ReadLocation();
+		if (type > Modifier::READONLY) {
+			Fail();
+		} else if (!m_failed) {
+			modifiers.push_back(
+					m_driver.Create<Modifier>(Modifier::Type(type),
+							type_position));
+		}
+	}
+
+	ModifierListRef result = ModifierList::GetTerminator();
+	for (auto iter = modifiers.rbegin(); iter != modifiers.rend(); ++iter) {
+		result = ModifierList::From(*iter, result, m_driver.GetAllocator());
+	}
+
+	//the parser copies the head of a non-empty modifier list
+	return ModifierList::IsTerminator(result) ?
+			result : ModifierList::From(result);
+}
+
+const_shared_ptr<Variable> SyntaxTreeReader::ReadVariable() {
+	switch (ReadTag()) {
+	case BASIC_VARIABLE: {
+		auto name = ReadString();
+		const yy::location location = ReadLocation();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<BasicVariable>(name, location);
+	}
+	case ARRAY_VARIABLE: {
+		auto base_variable = ReadVariable();
+		auto expression = ReadExpression();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<ArrayVariable>(base_variable, expression);
+	}
+	case MEMBER_VARIABLE: {
+		auto container = ReadVariable();
+		auto member_variable = ReadVariable();
+		if (m_failed) {
+			break;
+		}
+		return m_driver.Create<MemberVariable>(container, member_variable);
+	}
+	default:
+		break;
+	}
+
+	Fail();
+	return nullptr;
+}
+
+const_shared_ptr<TypeSpecifier> SyntaxTreeReader::ReadType() {
+	auto result = ReadOptionalType();
+	if (!result) {
+		Fail();
+	}
+	return result;
+}
+
+const_shared_ptr<TypeSpecifier> SyntaxTreeReader::ReadOptionalType() {
+	switch (ReadTag()) {
+	case NO_NODE:
+		return nullptr;
+	case PRIMITIVE_TYPE:
+		switch (ReadUnsigned()) {
+		case BOOLEAN:
+			return PrimitiveTypeSpecifier::GetBoolean();
+		case INT:
+			return PrimitiveTypeSpecifier::GetInt();
+		case DOUBLE:
+			return PrimitiveTypeSpecifier::GetDouble();
+		case STRING:
+			return PrimitiveTypeSpecifier::GetString();
+		default:
+			break;
+		}
+		break;
+	case ARRAY_TYPE: {
+		auto element_type = ReadType();
+		if (m_failed) {
+			break;
+		}
+		return ArrayTypeSpecifier::Get(element_type);
+	}
+	case COMPOUND_TYPE: {
+		auto type_name = ReadString();
+		if (m_failed) {
+			break;
+		}
+		return CompoundTypeSpecifier::Get(*type_name);
+	}
+	case FUNCTION_TYPE: {
+		auto parameter_type_list = ReadTypeList();
+		auto return_type = ReadType();
+		if (m_failed) {
+			break;
+		}
+		return FunctionTypeSpecifier::Get(parameter_type_list, return_type);
+	}
+	case SUM_TYPE: {
+		auto type_list = ReadTypeList();
+		if (m_failed || TypeSpecifierList::IsTerminator(type_list)) {
+			break;
+		}
+		return SumTypeSpecifier::Get(type_list);
+	}
+	default:
+		break;
+	}
+
+	Fail();
+	return nullptr;
+}
+
+TypeSpecifierListRef SyntaxTreeReader::ReadTypeList() {
+	const size_t count = ReadCount();
+	std::vector<plain_shared_ptr<TypeSpecifier>> types;
+	types.reserve(count);
+	for (size_t i = 0; i < count && !m_failed; i++) {
+		types.push_back(ReadType());
+	}
+
+	TypeSpecifierListRef result = TypeSpecifierList::GetTerminator();
+	for (auto iter = types.rbegin(); iter != types.rend(); ++iter) {
+		result = TypeSpecifierList::From(*iter, result,
+				m_driver.GetAllocator());
+	}
+	return result;
+}
+
+const SyntaxTreeTag SyntaxTreeReader::ReadTag() {
+	const uint64_t tag = ReadUnsigned();
+	if (tag >= SYNTAX_TREE_TAG_COUNT) {
+		Fail();
+		return NO_NODE;
+	}
+	return SyntaxTreeTag(tag);
+}
+
+const yy::location SyntaxTreeReader::ReadLocation() {
+	yy::location result;
+	result.begin.line = m_line + ReadSigned();
+	result.begin.column = ReadUnsigned();
+	result.end.line = result.begin.line + ReadSigned();
+	result.end.column = ReadUnsigned();
+	m_line = result.begin.line;
+	return result;
+}
+
+const_shared_ptr<string> SyntaxTreeReader::ReadString() {
+	const uint64_t index = ReadUnsigned();
+	if (index >= m_strings.size()) {
+		Fail();
+		return make_shared<string>();
+	}
+	return m_strings[index];
+}
+
+const int64_t SyntaxTreeReader::ReadSigned() {
+	const uint64_t value = ReadUnsigned();
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+const uint64_t SyntaxTreeReader::ReadUnsigned() {
+	uint64_t result = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (m_data == m_end) {
+			break;
+		}
+
+		const uint8_t byte = *m_data++;
+		result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return result;
+		}
+	}
+
+	Fail();
+	return 0;
+}
+
+const double SyntaxTreeReader::ReadDouble() {
+	if (m_end - m_data < static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+		Fail();
+		return 0;
+	}
+
+	uint64_t bits = 0;
+	for (size_t i = 0; i < sizeof(bits); i++) {
+		bits |= static_cast<uint64_t>(static_cast<uint8_t>(*m_data++))
+				<< (i * 8);
+	}
+
+	double result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+const size_t SyntaxTreeReader::ReadCount() {
+	const uint64_t count = ReadUnsigned();
+	if (count > static_cast<uint64_t>(m_end - m_data)) {
+		Fail();
+		return 0;
+	}
+	return count;
+}
+
+void SyntaxTreeReader::Fail() {
+	//consume the rest of the data, so that every subsequent read fails too
+	m_failed = true;
+	m_data = m_end;
+}
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SYNTAX_TREE_READER_H_
+#define SYNTAX_TREE_READER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <defaults.h>
+#include <declaration_statement.h>
+#include <expression.h>
+#include <member_instantiation.h>
+#include <modifier.h>
+#include <statement.h>
+#include <syntax_tree_tag.h>
+#include <type_specifier.h>
+
+class Driver;
+class StatementBlock;
+class Variable;
+
+/**
+ * Rebuilds a syntax tree serialized by a SyntaxTreeWriter. Nodes are created
+ * through the given driver, exactly as the parser would have created them, so
+ * the result can be used in place of a freshly parsed tree.
+ *
+ * The data is not trusted: reads are bounds-checked, and malformed data makes
+ * the reader fail rather than build an inconsistent tree.
+ */
+class SyntaxTreeReader {
+public:
+	SyntaxTreeReader(Driver& driver, const char* data, const size_t size);
+	virtual ~SyntaxTreeReader();
+
+	/**
+	 * Read the tree, returning its main statement block, or null if the data is
+	 * malformed.
+	 */
+	const_shared_ptr<StatementBlock> Read();
+
+private:
+	const_shared_ptr<StatementBlock> ReadBlock();
+	const_shared_ptr<StatementBlock> ReadOptionalBlock();
+	const_shared_ptr<Statement> ReadStatement();
+	const_shared_ptr<Statement> ReadStatement(const SyntaxTreeTag tag);
+	const_shared_ptr<DeclarationStatement> ReadDeclaration();
+	const_shared_ptr<DeclarationStatement> ReadDeclaration(
+			const SyntaxTreeTag tag);
+	DeclarationListRef ReadDeclarationList();
+	const_shared_ptr<Expression> ReadExpression();
+	const_shared_ptr<Expression> ReadOptionalExpression();
+	ArgumentListRef ReadArgumentList();
+	MemberInstantiationListRef ReadMemberInstantiationList();
+	ModifierListRef ReadModifierList();
+	const_shared_ptr<Variable> ReadVariable();
+	const_shared_ptr<TypeSpecifier> ReadType();
+	const_shared_ptr<TypeSpecifier> ReadOptionalType();
+	TypeSpecifierListRef ReadTypeList();
+
+	const SyntaxTreeTag ReadTag();
+	const yy::location ReadLocation();
+	const_shared_ptr<string> ReadString();
+	const int64_t ReadSigned();
+	const uint64_t ReadUnsigned();
+	const double ReadDouble();
+
+	/**
+	 * Read an element count, which can be no larger than the remaining data.
+	 */
+	const size_t ReadCount();
+
+	/**
+	 * Mark the data as malformed. Subsequent reads return zero or null.
+	 */
+	void Fail();
+
+	Driver& m_driver;
+	const char* m_data;
+	const char* const m_end;
+	std::vector<plain_shared_ptr<string>> m_strings;
+	unsigned int m_line;
+	bool m_failed;
+};
+
+#endif /* SYNTAX_TREE_READER_H_ */
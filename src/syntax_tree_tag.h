@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SYNTAX_TREE_TAG_H_
+#define SYNTAX_TREE_TAG_H_
+
+/**
+ * The node tags of a serialized syntax tree. Each node is written as its tag
+ * followed by the fields its constructor takes, in order. Tags are part of the
+ * on-disk format, so new tags must be appended.
+ */
+enum SyntaxTreeTag {
+	NO_NODE = 0,
+
+	DECLARATION_STATEMENT,
+	STRUCT_DECLARATION_STATEMENT,
+	ASSIGNMENT_STATEMENT,
+	EXIT_STATEMENT,
+	FOR_STATEMENT,
+	IF_STATEMENT,
+	INVOKE_STATEMENT,
+	PRINT_STATEMENT,
+	RETURN_STATEMENT,
+
+	ARITHMETIC_EXPRESSION,
+	COMPARISON_EXPRESSION,
+	LOGIC_EXPRESSION,
+	BOOLEAN_CONSTANT_EXPRESSION,
+	INT_CONSTANT_EXPRESSION,
+	DOUBLE_CONSTANT_EXPRESSION,
+	STRING_CONSTANT_EXPRESSION,
+	DEFAULT_VALUE_EXPRESSION,
+	FUNCTION_EXPRESSION,
+	INVOKE_EXPRESSION,
+	UNARY_EXPRESSION,
+	VARIABLE_EXPRESSION,
+	WITH_EXPRESSION,
+
+	BASIC_VARIABLE,
+	ARRAY_VARIABLE,
+	MEMBER_VARIABLE,
+
+	PRIMITIVE_TYPE,
+	ARRAY_TYPE,
+	COMPOUND_TYPE,
+	FUNCTION_TYPE,
+	SUM_TYPE,
+
+	SYNTAX_TREE_TAG_COUNT
+};
+
+#endif /* SYNTAX_TREE_TAG_H_ */
@@ -0,0 +1,523 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <syntax_tree_writer.h>
+#include <cstring>
+#include <statement_block.h>
+#include <array_declaration_statement.h>
+#include <assignment_statement.h>
+#include <exit_statement.h>
+#include <for_statement.h>
+#include <function_declaration_statement.h>
+#include <if_statement.h>
+#include <inferred_declaration_statement.h>
+#include <invoke_statement.h>
+#include <primitive_declaration_statement.h>
+#include <print_statement.h>
+#include <return_statement.h>
+#include <struct_declaration_statement.h>
+#include <struct_instantiation_statement.h>
+#include <sum_declaration_statement.h>
+#include <arithmetic_expression.h>
+#include <comparison_expression.h>
+#include <constant_expression.h>
+#include <default_value_expression.h>
+#include <function_expression.h>
+#include <invoke_expression.h>
+#include <logic_expression.h>
+#include <unary_expression.h>
+#include <variable_expression.h>
+#include <with_expression.h>
+#include <array_variable.h>
+#include <basic_variable.h>
+#include <member_variable.h>
+#include <array_type_specifier.h>
+#include <compound_type_specifier.h>
+#include <function_declaration.h>
+#include <primitive_type_specifier.h>
+#include <sum_type_specifier.h>
+
+SyntaxTreeWriter::SyntaxTreeWriter() :
+		m_body(), m_strings(), m_string_indices(), m_line(0), m_failed(false) {
+}
+
+SyntaxTreeWriter::~SyntaxTreeWriter() {
+}
+
+const bool SyntaxTreeWriter::Write(const StatementBlock& block) {
+	WriteBlock(block);
+	return !m_failed;
+}
+
+const std::string SyntaxTreeWriter::GetData() const {
+	std::string result;
+	WriteUnsigned(result, m_string_indices.size());
+	result.reserve(result.size() + m_strings.size() + m_body.size());
+	result += m_strings;
+	result += m_body;
+	return result;
+}
+
+void SyntaxTreeWriter::WriteBlock(const StatementBlock& block) {
+	uint64_t count = 0;
+	for (auto subject = block.GetStatementList();
+			!StatementList::IsTerminator(subject); subject =
+					subject->GetNext()) {
+		count++;
+	}
+
+	WriteUnsigned(count);
+	for (auto subject = block.GetStatementList();
+			!StatementList::IsTerminator(subject); subject =
+					subject->GetNext()) {
+		WriteStatement(subject->GetData());
+	}
+	WriteLocation(block.GetLocation());
+}
+
+void SyntaxTreeWriter::WriteOptionalBlock(
+		const_shared_ptr<StatementBlock> block) {
+	WriteUnsigned(block ? 1 : 0);
+	if (block) {
+		WriteBlock(*block);
+	}
+}
+
+void SyntaxTreeWriter::WriteStatement(const_shared_ptr<Statement> statement) {
+	auto as_declaration = dynamic_pointer_cast<const DeclarationStatement>(
+			statement);
+	if (as_declaration) {
+		WriteDeclaration(as_declaration);
+		return;
+	}
+
+	auto as_assignment = dynamic_pointer_cast<const AssignmentStatement>(
+			statement);
+	auto as_exit = dynamic_pointer_cast<const ExitStatement>(statement);
+	auto as_for = dynamic_pointer_cast<const ForStatement>(statement);
+	auto as_if = dynamic_pointer_cast<const IfStatement>(statement);
+	auto as_invoke = dynamic_pointer_cast<const InvokeStatement>(statement);
+	auto as_print = dynamic_pointer_cast<const PrintStatement>(statement);
+	auto as_return = dynamic_pointer_cast<const ReturnStatement>(statement);
+
+	if (as_assignment) {
+		WriteTag(ASSIGNMENT_STATEMENT);
+		WriteVariable(as_assignment->GetVariable());
+		WriteUnsigned(as_assignment->GetOpType());
+		WriteExpression(as_assignment->GetExpression());
+	} else if (as_exit) {
+		WriteTag(EXIT_STATEMENT);
+		WriteExpression(as_exit->GetExitExpression());
+	} else if (as_for) {
+		WriteTag(FOR_STATEMENT);
+		WriteStatement(as_for->GetInitial());
+		WriteExpression(as_for->GetLoopExpression());
+		WriteStatement(as_for->GetLoopAssignment());
+		WriteBlock(*as_for->GetStatementBlock());
+	} else if (as_if) {
+		WriteTag(IF_STATEMENT);
+		WriteExpression(as_if->GetExpression());
+		WriteBlock(*as_if->GetBlock());
+		WriteOptionalBlock(as_if->GetElseBlock());
+	} else if (as_invoke) {
+		WriteTag(INVOKE_STATEMENT);
+		WriteVariable(as_invoke->GetVariable());
+		WriteArgumentList(as_invoke->GetArgumentList());
+		WriteLocation(as_invoke->GetArgumentListPosition());
+	} else if (as_print) {
+		WriteTag(PRINT_STATEMENT);
+		WriteSigned(as_print->GetLineNumber());
+		WriteExpression(as_print->GetExpression());
+	} else if (as_return) {
+		WriteTag(RETURN_STATEMENT);
+		WriteExpression(as_return->GetExpression());
+	} else if (statement) {
+		//not a statement the parser produces
+		m_failed = true;
+	} else {
+		WriteTag(NO_NODE);
+	}
+}
+
+void SyntaxTreeWriter::WriteDeclaration(
+		const_shared_ptr<DeclarationStatement> declaration) {
+	auto as_struct = dynamic_pointer_cast<const StructDeclarationStatement>(
+			declaration);
+	if (as_struct) {
+		WriteTag(STRUCT_DECLARATION_STATEMENT);
+		WriteLocation(as_struct->GetPosition());
+		WriteString(as_struct->GetName());
+		WriteLocation(as_struct->GetNamePosition());
+		WriteDeclarationList(as_struct->GetMemberDeclarationListRef());
+		WriteLocation(as_struct->GetMemberDeclarationListRefPosition());
+		WriteModifierList(as_struct->GetModifierListRef());
+		WriteLocation(as_struct->GetModifiersLocation());
+		return;
+	}
+
+	//the kind of declaration is implied by its type, as it is in the grammar
+	plain_shared_ptr<TypeSpecifier> type = nullptr;
+	yy::location type_position;
+	if (auto as_primitive = dynamic_pointer_cast<
+			const PrimitiveDeclarationStatement>(declaration)) {
+		type = as_primitive->GetType();
+		type_position = as_primitive->GetTypePosition();
+	} else if (auto as_array = dynamic_pointer_cast<
+			const ArrayDeclarationStatement>(declaration)) {
+		type = as_array->GetType();
+		type_position = as_array->GetTypePosition();
+	} else if (auto as_struct_instantiation = dynamic_pointer_cast<
+			const StructInstantiationStatement>(declaration)) {
+		type = as_struct_instantiation->GetType();
+		type_position = as_struct_instantiation->GetTypePosition();
+	} else if (auto as_function = dynamic_pointer_cast<
+			const FunctionDeclarationStatement>(declaration)) {
+		type = as_function->GetType();
+		type_position = as_function->GetTypePosition();
+	} else if (auto as_sum = dynamic_pointer_cast<
+			const SumDeclarationStatement>(declaration)) {
+		type = as_sum->GetType();
+		type_position = as_sum->GetTypePosition();
+	} else if (!dynamic_pointer_cast<const InferredDeclarationStatement>(
+			declaration)) {
+		m_failed = true;
+		return;
+	}
+
+	WriteTag(DECLARATION_STATEMENT);
+	WriteLocation(declaration->GetPosition());
+	WriteType(type);
+	if (type) {
+		WriteLocation(type_position);
+	}
+	WriteString(declaration->GetName());
+	WriteLocation(declaration->GetNamePosition());
+	WriteExpression(declaration->GetInitializerExpression());
+}
+
+void SyntaxTreeWriter::WriteDeclarationList(DeclarationListRef list) {
+	uint64_t count = 0;
+	for (auto subject = list; !DeclarationList::IsTerminator(subject);
+			subject = subject->GetNext()) {
+		count++;
+	}
+
+	WriteUnsigned(count);
+	for (auto subject = list; !DeclarationList::IsTerminator(subject);
+			subject = subject->GetNext()) {
+		WriteDeclaration(subject->GetData());
+	}
+}
+
+void SyntaxTreeWriter::WriteExpression(
+		const_shared_ptr<Expression> expression) {
+	if (!expression) {
+		WriteTag(NO_NODE);
+		return;
+	}
+
+	auto as_binary = dynamic_pointer_cast<const BinaryExpression>(expression);
+	auto as_constant = dynamic_pointer_cast<const ConstantExpression>(
+			expression);
+	auto as_default_value = dynamic_pointer_cast<const DefaultValueExpression>(
+			expression);
+	auto as_function = dynamic_pointer_cast<const FunctionExpression>(
+			expression);
+	auto as_invoke = dynamic_pointer_cast<const InvokeExpression>(expression);
+	auto as_unary = dynamic_pointer_cast<const UnaryExpression>(expression);
+	auto as_variable = dynamic_pointer_cast<const VariableExpression>(
+			expression);
+	auto as_with = dynamic_pointer_cast<const WithExpression>(expression);
+
+	if (as_binary) {
+		if (dynamic_pointer_cast<const ArithmeticExpression>(expression)) {
+			WriteTag(ARITHMETIC_EXPRESSION);
+		} else if (dynamic_pointer_cast<const ComparisonExpression>(
+				expression)) {
+			WriteTag(COMPARISON_EXPRESSION);
+		} else if (dynamic_pointer_cast<const LogicExpression>(expression)) {
+			WriteTag(LOGIC_EXPRESSION);
+		} else {
+			m_failed = true;
+			return;
+		}
+		WriteLocation(as_binary->GetPosition());
+		WriteUnsigned(as_binary->GetOperator());
+		WriteExpression(as_binary->GetLeft());
+		WriteExpression(as_binary->GetRight());
+	} else if (as_constant) {
+		auto type = specifier_cast<PrimitiveTypeSpecifier>(
+				as_constant->GetTypeSpecifier());
+		const Value& value = as_constant->GetValue();
+		switch (type ? type->GetBasicType() : NONE) {
+		case BOOLEAN:
+			WriteTag(BOOLEAN_CONSTANT_EXPRESSION);
+			WriteLocation(as_constant->GetPosition());
+			WriteUnsigned(value.GetBoolean() ? 1 : 0);
+			break;
+		case INT:
+			WriteTag(INT_CONSTANT_EXPRESSION);
+			WriteLocation(as_constant->GetPosition());
+			WriteSigned(value.GetInt());
+			break;
+		case DOUBLE:
+			WriteTag(DOUBLE_CONSTANT_EXPRESSION);
+			WriteLocation(as_constant->GetPosition());
+			WriteDouble(value.GetDouble());
+			break;
+		case STRING:
+			WriteTag(STRING_CONSTANT_EXPRESSION);
+			WriteLocation(as_constant->GetPosition());
+			WriteString(value.GetReference<string>());
+			break;
+		default:
+			//constants of other types are only made by the optimizer
+			m_failed = true;
+		}
+	} else if (as_default_value) {
+		WriteTag(DEFAULT_VALUE_EXPRESSION);
+		WriteLocation(as_default_value->GetPosition());
+		WriteType(as_default_value->GetTypeSpecifier());
+		WriteLocation(as_default_value->GetTypePosition());
+	} else if (as_function) {
+		WriteTag(FUNCTION_EXPRESSION);
+		WriteLocation(as_function->GetPosition());
+		auto declaration = as_function->GetDeclaration();
+		WriteDeclarationList(declaration->GetParameterList());
+		WriteType(declaration->GetReturnType());
+		WriteBlock(*as_function->GetBody());
+	} else if (as_invoke) {
+		WriteTag(INVOKE_EXPRESSION);
+		WriteLocation(as_invoke->GetPosition());
+		WriteExpression(as_invoke->GetExpression());
+		WriteArgumentList(as_invoke->GetArgumentListRef());
+		WriteLocation(as_invoke->GetArgumentListRefPosition());
+	} else if (as_unary) {
+		WriteTag(UNARY_EXPRESSION);
+		WriteLocation(as_unary->GetPosition());
+		WriteUnsigned(as_unary->GetOperator());
+		WriteExpression(as_unary->GetExpression());
+	} else if (as_variable) {
+		WriteTag(VARIABLE_EXPRESSION);
+		WriteLocation(as_variable->GetPosition());
+		WriteVariable(as_variable->GetVariable());
+	} else if (as_with) {
+		WriteTag(WITH_EXPRESSION);
+		WriteLocation(as_with->GetPosition());
+		WriteExpression(as_with->GetSourceExpression());
+		WriteMemberInstantiationList(as_with->GetMemberInstantiationListRef());
+		WriteLocation(as_with->GetMemberInstantiationListRefPosition());
+	} else {
+		m_failed = true;
+	}
+}
+
+void SyntaxTreeWriter::WriteArgumentList(ArgumentListRef list) {
+	uint64_t count = 0;
+	for (auto subject = list; !ArgumentList::IsTerminator(subject); subject =
+			subject->GetNext()) {
+		count++;
+	}
+
+	WriteUnsigned(count);
+	for (auto subject = list; !ArgumentList::IsTerminator(subject); subject =
+			subject->GetNext()) {
+		WriteExpression(subject->GetData());
+	}
+}
+
+void SyntaxTreeWriter::WriteMemberInstantiationList(
+		MemberInstantiationListRef list) {
+	uint64_t count = 0;
+	for (auto subject = list; !MemberInstantiationList::IsTerminator(subject);
+			subject = subject->GetNext()) {
+		count++;
+	}
+
+	WriteUnsigned(count);
+	for (auto subject = list; !MemberInstantiationList::IsTerminator(subject);
+			subject = subject->GetNext()) {
+		auto instantiation = subject->GetData();
+		WriteString(instantiation->GetName());
+		WriteLocation(instantiation->GetNamePosition());
+		WriteExpression(instantiation->GetExpression());
+	}
+}
+
+void SyntaxTreeWriter::WriteModifierList(ModifierListRef list) {
+	uint64_t count = 0;
+	for (auto subject = list; !ModifierList::IsTerminator(subject); subject =
+			subject->GetNext()) {
+		count++;
+	}
+
+	WriteUnsigned(count);
+	for (auto subject = list; !ModifierList::IsTerminator(subject); subject =
+			subject->GetNext()) {
+		auto modifier = subject->GetData();
+		WriteUnsigned(modifier->GetType());
+		WriteLocation(modifier->GetTypePosition());
+	}
+}
+
+void SyntaxTreeWriter::WriteVariable(const_shared_ptr<Variable> variable) {
+	auto as_array = dynamic_pointer_cast<const ArrayVariable>(variable);
+	auto as_member = dynamic_pointer_cast<const MemberVariable>(variable);
+	auto as_basic = dynamic_pointer_cast<const BasicVariable>(variable);
+
+	if (as_array) {
+		WriteTag(ARRAY_VARIABLE);
+		WriteVariable(as_array->GetBaseVariable());
+		WriteExpression(as_array->GetIndexExpression());
+	} else if (as_member) {
+		WriteTag(MEMBER_VARIABLE);
+		WriteVariable(as_member->GetContainer());
+		WriteVariable(as_member->GetMemberVariable());
+	} else if (as_basic) {
+		WriteTag(BASIC_VARIABLE);
+		WriteString(as_basic->GetName());
+		WriteLocation(as_basic->GetLocation());
+	} else if (variable) {
+		m_failed = true;
+	} else {
+		WriteTag(NO_NODE);
+	}
+}
+
+void SyntaxTreeWriter::WriteType(const_shared_ptr<TypeSpecifier> type) {
+	if (!type) {
+		WriteTag(NO_NODE);
+		return;
+	}
+
+	switch (type->GetKind()) {
+	case TypeSpecifier::PRIMITIVE:
+		WriteTag(PRIMITIVE_TYPE);
+		WriteUnsigned(
+				specifier_cast<PrimitiveTypeSpecifier>(type)->GetBasicType());
+		break;
+	case TypeSpecifier::ARRAY:
+		WriteTag(ARRAY_TYPE);
+		WriteType(
+				specifier_cast<ArrayTypeSpecifier>(type)
+						->GetElementTypeSpecifier());
+		break;
+	case TypeSpecifier::COMPOUND:
+		WriteTag(COMPOUND_TYPE);
+		WriteString(
+				specifier_cast<CompoundTypeSpecifier>(type)->GetTypeName());
+		break;
+	case TypeSpecifier::FUNCTION: {
+		if (dynamic_pointer_cast<const FunctionDeclaration>(type)) {
+			//declarations only appear in function expressions, which write
+			//their parameters themselves
+			m_failed = true;
+			return;
+		}
+		auto as_function = specifier_cast<FunctionTypeSpecifier>(type);
+		WriteTag(FUNCTION_TYPE);
+		WriteTypeList(as_function->GetParameterTypeList());
+		WriteType(as_function->GetReturnType());
+		break;
+	}
+	case TypeSpecifier::SUM:
+		WriteTag(SUM_TYPE);
+		WriteTypeList(specifier_cast<SumTypeSpecifier>(type)->GetTypeList());
+		break;
+	default:
+		m_failed = true;
+	}
+}
+
+void SyntaxTreeWriter::WriteTypeList(TypeSpecifierListRef list) {
+	uint64_t count = 0;
+	for (auto subject = list; !TypeSpecifierList::IsTerminator(subject);
+			subject = subject->GetNext()) {
+		count++;
+	}
+
+	WriteUnsigned(count);
+	for (auto subject = list; !TypeSpecifierList::IsTerminator(subject);
+			subject = subject->GetNext()) {
+		WriteType(subject->GetData());
+	}
+}
+
+void SyntaxTreeWriter::WriteTag(const SyntaxTreeTag tag) {
+	WriteUnsigned(tag);
+}
+
+void SyntaxTreeWriter::WriteLocation(const yy::location& location) {
+	//lines are written relative to the previous location, which is usually on
+	//the same line or close to it. File names are not recorded; the lexer
+	//doesn't set them either.
+	WriteSigned(int64_t(location.begin.line) - int64_t(m_line));
+	WriteUnsigned(location.begin.column);
+	WriteSigned(int64_t(location.end.line) - int64_t(location.begin.line));
+	WriteUnsigned(location.end.column);
+	m_line = location.begin.line;
+}
+
+void SyntaxTreeWriter::WriteString(const_shared_ptr<string> value) {
+	if (!value) {
+		m_failed = true;
+		return;
+	}
+	WriteString(*value);
+}
+
+void SyntaxTreeWriter::WriteString(const string& value) {
+	auto result = m_string_indices.insert(
+			std::make_pair(value, m_string_indices.size()));
+	if (result.second) {
+		WriteUnsigned(m_strings, value.size());
+		m_strings += value;
+	}
+	WriteUnsigned(result.first->second);
+}
+
+void SyntaxTreeWriter::WriteSigned(const int64_t value) {
+	//zigzag encoding, so that small negative values stay small
+	WriteUnsigned(
+			(static_cast<uint64_t>(value) << 1)
+					^ static_cast<uint64_t>(value >> 63));
+}
+
+void SyntaxTreeWriter::WriteUnsigned(uint64_t value) {
+	WriteUnsigned(m_body, value);
+}
+
+void SyntaxTreeWriter::WriteDouble(const double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	for (size_t i = 0; i < sizeof(bits); i++) {
+		m_body += static_cast<char>(bits >> (i * 8));
+	}
+}
+
+void SyntaxTreeWriter::WriteUnsigned(std::string& buffer, uint64_t value) {
+	//seven bits per byte, least significant first; the high bit marks a
+	//continuation
+	while (value >= 0x80) {
+		buffer += static_cast<char>((value & 0x7F) | 0x80);
+		value >>= 7;
+	}
+	buffer += static_cast<char>(value);
+}
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SYNTAX_TREE_WRITER_H_
+#define SYNTAX_TREE_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <defaults.h>
+#include <declaration_statement.h>
+#include <expression.h>
+#include <member_instantiation.h>
+#include <modifier.h>
+#include <statement.h>
+#include <syntax_tree_tag.h>
+#include <type_specifier.h>
+
+class StatementBlock;
+class Variable;
+
+/**
+ * Serializes a syntax tree as it comes out of the parser, so that it can be
+ * rebuilt by a SyntaxTreeReader without parsing the script again.
+ *
+ * The serialized form is a table of the distinct strings in the tree (names and
+ * string constants), followed by the tree itself in prefix order. Integers are
+ * variable-length encoded, so that the common small values (tags, columns,
+ * string indices, line deltas) take a byte or two.
+ *
+ * Only trees that have not been preprocessed can be serialized: preprocessing
+ * and optimization rewrite nodes in place, and the types they compute belong
+ * to a particular execution context.
+ */
+class SyntaxTreeWriter {
+public:
+	SyntaxTreeWriter();
+	virtual ~SyntaxTreeWriter();
+
+	/**
+	 * Serialize the given block. Returns false if the tree contains a node that
+	 * cannot be serialized, in which case the data is incomplete.
+	 */
+	const bool Write(const StatementBlock& block);
+
+	/**
+	 * The serialized tree: the string table followed by the nodes.
+	 */
+	const std::string GetData() const;
+
+private:
+	void WriteBlock(const StatementBlock& block);
+	void WriteOptionalBlock(const_shared_ptr<StatementBlock> block);
+	void WriteStatement(const_shared_ptr<Statement> statement);
+	void WriteDeclaration(const_shared_ptr<DeclarationStatement> declaration);
+	void WriteDeclarationList(DeclarationListRef list);
+	void WriteExpression(const_shared_ptr<Expression> expression);
+	void WriteArgumentList(ArgumentListRef list);
+	void WriteMemberInstantiationList(MemberInstantiationListRef list);
+	void WriteModifierList(ModifierListRef list);
+	void WriteVariable(const_shared_ptr<Variable> variable);
+	void WriteType(const_shared_ptr<TypeSpecifier> type);
+	void WriteTypeList(TypeSpecifierListRef list);
+
+	void WriteTag(const SyntaxTreeTag tag);
+	void WriteLocation(const yy::location& location);
+	void WriteString(const_shared_ptr<string> value);
+	void WriteString(const string& value);
+	void WriteSigned(const int64_t value);
+	void WriteUnsigned(uint64_t value);
+	void WriteDouble(const double value);
+
+	static void WriteUnsigned(std::string& buffer, uint64_t value);
+
+	std::string m_body;
+	std::string m_strings;
+	std::unordered_map<string, uint64_t> m_string_indices;
+	unsigned int m_line;
+	bool m_failed;
+};
+
+#endif /* SYNTAX_TREE_WRITER_H_ */
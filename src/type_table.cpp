@@ -17,6 +17,8 @@
  along with newt.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <vector>
 #include <type_table.h>
 #include <compound_type.h>
 
@@ -27,14 +29,14 @@ TypeTable::TypeTable() :
 TypeTable::~TypeTable() {
 }
 
-void TypeTable::AddType(const string& name,
+void TypeTable::AddType(const Atom& name,
 		const_shared_ptr<CompoundType> definition) {
 	table->insert(
-			pair<const string, const_shared_ptr<CompoundType>>(name,
+			pair<const Atom, const_shared_ptr<CompoundType>>(name,
 					definition));
 }
 
-const_shared_ptr<CompoundType> TypeTable::GetType(const string& name) const {
+const_shared_ptr<CompoundType> TypeTable::GetType(const Atom& name) const {
 	auto result = table->find(name);
 
 	if (result != table->end()) {
@@ -44,26 +46,30 @@ const_shared_ptr<CompoundType> TypeTable::GetType(const string& name) const {
 	return CompoundType::GetDefaultCompoundType();
 }
 
-const_shared_ptr<void> TypeTable::GetDefaultValue(
-		const string& type_name) const {
+const Value TypeTable::GetDefaultValue(const Atom& type_name) const {
 	const_shared_ptr<CompoundType> type = GetType(type_name);
 	if (type != CompoundType::GetDefaultCompoundType()) {
 		return CompoundTypeInstance::GetDefaultInstance(type_name, type);
 	} else {
-		return nullptr;
+		return Value();
 	}
 }
 
 const void TypeTable::print(ostream& os) const {
-	type_map::iterator iter;
-	for (iter = table->begin(); iter != table->end(); ++iter) {
-		os << iter->first << ": " << endl;
-		const_shared_ptr<CompoundType> type = iter->second;
+	std::vector<Atom> names;
+	for (auto iter = table->begin(); iter != table->end(); ++iter) {
+		names.push_back(iter->first);
+	}
+	std::sort(names.begin(), names.end(), Atom::NameLess);
+
+	for (auto iter = names.begin(); iter != names.end(); ++iter) {
+		os << iter->GetName() << ": " << endl;
+		const_shared_ptr<CompoundType> type = table->at(*iter);
 		os << type->ToString(*this, Indent(0));
 	}
 }
 
-volatile_shared_ptr<TypeTable> TypeTable::GetDefault() {
-	static volatile_shared_ptr<TypeTable> instance = make_shared<TypeTable>();
+const_shared_ptr<TypeTable> TypeTable::GetDefault() {
+	static const_shared_ptr<TypeTable> instance = make_shared<TypeTable>();
 	return instance;
 }
@@ -22,30 +22,35 @@
 
 #include <member_declaration.h>
 #include <type.h>
-#include <map>
+#include <value.h>
+#include <unordered_map>
+#include <atom.h>
 
 class CompoundType;
 
 using namespace std;
 
-typedef map<const string, const_shared_ptr<CompoundType>> type_map;
+typedef unordered_map<Atom, const_shared_ptr<CompoundType>> type_map;
 
 class TypeTable {
 public:
 	TypeTable();
 	virtual ~TypeTable();
 
-	void AddType(const string& name, const_shared_ptr<CompoundType> definition);
+	void AddType(const Atom& name, const_shared_ptr<CompoundType> definition);
 
-	const_shared_ptr<CompoundType> GetType(const string& name) const;
+	const_shared_ptr<CompoundType> GetType(const Atom& name) const;
 
-	const_shared_ptr<void> GetDefaultValue(const string& type_name) const;
+	const Value GetDefaultValue(const Atom& type_name) const;
 
 	const void print(ostream &os) const;
 
 	const static string DefaultTypeName;
 
-	static volatile_shared_ptr<TypeTable> GetDefault();
+	/**
+	 * An empty type table. It is shared by every thread, so it is const.
+	 */
+	static const_shared_ptr<TypeTable> GetDefault();
 
 private:
 	const shared_ptr<type_map> table;
@@ -0,0 +1,105 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VALUE_H_
+#define VALUE_H_
+
+#include <type_traits>
+#include <defaults.h>
+
+/**
+ * A runtime value. Booleans, integers and doubles are stored inline; everything
+ * else (strings, arrays, struct instances, sums and functions) is held by reference.
+ *
+ * The kind tag records how the value is stored, not its newt type; the type of a
+ * value is always tracked separately by a TypeSpecifier.
+ */
+class Value {
+public:
+	enum Kind {
+		EMPTY, BOOLEAN, INT, DOUBLE, REFERENCE
+	};
+
+	Value() :
+			m_kind(EMPTY), m_reference() {
+		m_double = 0;
+	}
+
+	explicit Value(const bool value) :
+			m_kind(BOOLEAN), m_reference() {
+		m_double = 0;
+		m_int = value ? 1 : 0;
+	}
+
+	explicit Value(const int value) :
+			m_kind(INT), m_reference() {
+		m_double = 0;
+		m_int = value;
+	}
+
+	explicit Value(const double value) :
+			m_kind(DOUBLE), m_reference() {
+		m_double = value;
+	}
+
+	template<class T> Value(const std::shared_ptr<T>& reference) :
+			m_kind(reference ? REFERENCE : EMPTY), m_reference(reference) {
+		static_assert(!std::is_arithmetic<typename std::remove_const<T>::type>::value,
+				"primitive values must be stored inline");
+		m_double = 0;
+	}
+
+	const Kind GetKind() const {
+		return m_kind;
+	}
+
+	const bool IsEmpty() const {
+		return m_kind == EMPTY;
+	}
+
+	const bool GetBoolean() const {
+		return m_int != 0;
+	}
+
+	const int GetInt() const {
+		return m_int;
+	}
+
+	const double GetDouble() const {
+		return m_double;
+	}
+
+	const plain_shared_ptr<void>& GetReference() const {
+		return m_reference;
+	}
+
+	template<class T> const plain_shared_ptr<T> GetReference() const {
+		return std::static_pointer_cast<const T>(m_reference);
+	}
+
+private:
+	Kind m_kind;
+	union {
+		int m_int;
+		double m_double;
+	};
+	plain_shared_ptr<void> m_reference;
+};
+
+#endif /* VALUE_H_ */
@@ -33,15 +33,14 @@ ArrayVariable::ArrayVariable(const_shared_ptr<Variable> base_variable,
 
 const_shared_ptr<TypeSpecifier> ArrayVariable::GetType(
 		const shared_ptr<ExecutionContext> context) const {
-	auto base_type_as_array = dynamic_pointer_cast<const ArrayTypeSpecifier>(
+	auto base_type_as_array = specifier_cast<ArrayTypeSpecifier>(
 			m_base_variable->GetType(context));
 
 	if (base_type_as_array) {
 		auto base_evaluation = m_base_variable->Evaluate(context);
 
 		if (ErrorList::IsTerminator(base_evaluation->GetErrors())) {
-			auto array = std::static_pointer_cast<const Array>(
-					base_evaluation->GetData());
+			auto array = base_evaluation->GetData().GetReference<Array>();
 			return array->GetElementType();
 		} else {
 			return PrimitiveTypeSpecifier::GetNone();
@@ -61,7 +60,7 @@ const_shared_ptr<string> ArrayVariable::ToString(
 
 	auto errors = evaluation->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
-		buffer << *(static_pointer_cast<const int>(evaluation->GetData()));
+		buffer << evaluation->GetData().GetInt();
 	} else {
 		buffer << "EVALUATION ERROR";
 	}
@@ -84,12 +83,11 @@ const_shared_ptr<ArrayVariable::ValidationResult> ArrayVariable::ValidateOperati
 	errors = base_evaluation->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
 		auto base_type_as_array =
-				dynamic_pointer_cast<const ArrayTypeSpecifier>(
+				specifier_cast<ArrayTypeSpecifier>(
 						m_base_variable->GetType(context));
 
 		if (base_type_as_array) {
-			array = static_pointer_cast<const Array>(
-					base_evaluation->GetData());
+			array = base_evaluation->GetData().GetReference<Array>();
 			const_shared_ptr<TypeSpecifier> index_expression_type =
 					m_expression->GetType(context);
 			if (index_expression_type->IsAssignableTo(
@@ -98,8 +96,8 @@ const_shared_ptr<ArrayVariable::ValidationResult> ArrayVariable::ValidateOperati
 						m_expression->Evaluate(context);
 				errors = index_expression_evaluation->GetErrors();
 				if (ErrorList::IsTerminator(errors)) {
-					const int i = *(static_pointer_cast<const int>(
-							index_expression_evaluation->GetData()));
+					const int i =
+							index_expression_evaluation->GetData().GetInt();
 
 					if (i >= 0) {
 						array_index = i;
@@ -148,7 +146,7 @@ const_shared_ptr<Result> ArrayVariable::Evaluate(
 
 	const_shared_ptr<ValidationResult> validation_result = ValidateOperation(
 			context);
-	plain_shared_ptr<void> result_value;
+	Value result_value;
 	errors = validation_result->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
 		auto array = validation_result->GetArray();
@@ -160,19 +158,19 @@ const_shared_ptr<Result> ArrayVariable::Evaluate(
 					array->GetElementType();
 			if (element_type_specifier->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetBoolean())) {
-				result_value = array->GetValue<bool>(index, *type_table);
+				result_value = array->GetValue(index, *type_table);
 			} else if (element_type_specifier->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetInt())) {
-				result_value = array->GetValue<int>(index, *type_table);
+				result_value = array->GetValue(index, *type_table);
 			} else if (element_type_specifier->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetDouble())) {
-				result_value = array->GetValue<double>(index, *type_table);
+				result_value = array->GetValue(index, *type_table);
 			} else if (element_type_specifier->IsAssignableTo(
 					PrimitiveTypeSpecifier::GetString())) {
-				result_value = array->GetValue<string>(index, *type_table);
+				result_value = array->GetValue(index, *type_table);
 			} else {
 				const_shared_ptr<ArrayTypeSpecifier> as_array =
-						std::dynamic_pointer_cast<const ArrayTypeSpecifier>(
+						specifier_cast<ArrayTypeSpecifier>(
 								element_type_specifier);
 				if (as_array) {
 					//TODO
@@ -180,11 +178,10 @@ const_shared_ptr<Result> ArrayVariable::Evaluate(
 				}
 
 				const_shared_ptr<CompoundTypeSpecifier> as_compound =
-						std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+						specifier_cast<CompoundTypeSpecifier>(
 								element_type_specifier);
 				if (as_compound) {
-					result_value = array->GetValue<CompoundTypeInstance>(index,
-							*type_table);
+					result_value = array->GetValue(index, *type_table);
 				} else {
 					//we should never get here
 					assert(false);
@@ -230,7 +227,7 @@ const ErrorListRef ArrayVariable::AssignValue(
 			const_shared_ptr<TypeSpecifier> element_type_specifier =
 					array->GetElementType();
 			const_shared_ptr<PrimitiveTypeSpecifier> element_as_primitive =
-					std::dynamic_pointer_cast<const PrimitiveTypeSpecifier>(
+					specifier_cast<PrimitiveTypeSpecifier>(
 							element_type_specifier);
 
 			auto type_table = context->GetTypeTable();
@@ -240,12 +237,12 @@ const ErrorListRef ArrayVariable::AssignValue(
 
 				switch (element_type) {
 				case BOOLEAN: {
-					const_shared_ptr<bool> value = array->GetValue<bool>(index,
-							*type_table);
+					const bool value = array->GetValue(index,
+							*type_table).GetBoolean();
 					const_shared_ptr<Result> result =
 							AssignmentStatement::do_op(variable_name,
 									element_type, variable_line,
-									variable_column, *value, expression, op,
+									variable_column, value, expression, op,
 									context);
 
 					errors = result->GetErrors();
@@ -256,12 +253,12 @@ const ErrorListRef ArrayVariable::AssignValue(
 					break;
 				}
 				case INT: {
-					const_shared_ptr<int> value = array->GetValue<int>(index,
-							*type_table);
+					const int value = array->GetValue(index,
+							*type_table).GetInt();
 					const_shared_ptr<Result> result =
 							AssignmentStatement::do_op(variable_name,
 									element_type, variable_line,
-									variable_column, *value, expression, op,
+									variable_column, value, expression, op,
 									context);
 
 					errors = result->GetErrors();
@@ -272,12 +269,12 @@ const ErrorListRef ArrayVariable::AssignValue(
 					break;
 				}
 				case DOUBLE: {
-					const_shared_ptr<double> value = array->GetValue<double>(
-							index, *type_table);
+					const double value = array->GetValue(index,
+							*type_table).GetDouble();
 					const_shared_ptr<Result> result =
 							AssignmentStatement::do_op(variable_name,
 									element_type, variable_line,
-									variable_column, *value, expression, op,
+									variable_column, value, expression, op,
 									context);
 
 					errors = result->GetErrors();
@@ -287,8 +284,8 @@ const ErrorListRef ArrayVariable::AssignValue(
 					break;
 				}
 				case STRING: {
-					const_shared_ptr<string> value = array->GetValue<string>(
-							index, *type_table);
+					const const_shared_ptr<string> value = array->GetValue(
+							index, *type_table).GetReference<string>();
 					const_shared_ptr<Result> result =
 							AssignmentStatement::do_op(variable_name,
 									element_type, variable_line,
@@ -311,23 +308,21 @@ const ErrorListRef ArrayVariable::AssignValue(
 					errors = result->GetErrors();
 					if (ErrorList::IsTerminator(errors)) {
 						const_shared_ptr<ArrayTypeSpecifier> element_as_array =
-								std::dynamic_pointer_cast<
-										const ArrayTypeSpecifier>(
+								specifier_cast<ArrayTypeSpecifier>(
 										element_type_specifier);
 						if (element_as_array) {
 							errors = SetSymbolCore(context, result->GetData());
 						}
 
 						const_shared_ptr<CompoundTypeSpecifier> element_as_compound =
-								std::dynamic_pointer_cast<
-										const CompoundTypeSpecifier>(
+								specifier_cast<CompoundTypeSpecifier>(
 										element_type_specifier);
 						if (element_as_compound) {
 							errors = SetSymbolCore(context, result->GetData());
 						}
 					}
 				} else {
-					errors = errors->From(
+					errors = ErrorList::From(
 							make_shared<Error>(Error::SEMANTIC,
 									Error::ASSIGNMENT_TYPE_ERROR, variable_line,
 									variable_column,
@@ -350,44 +345,41 @@ const ErrorListRef ArrayVariable::AssignValue(
 }
 
 const ErrorListRef ArrayVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<bool> value) const {
-	return SetSymbolCore(context, static_pointer_cast<const void>(value));
+		const shared_ptr<ExecutionContext> context, const bool value) const {
+	return SetSymbolCore(context, Value(value));
 }
 
 const ErrorListRef ArrayVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<int> value) const {
-	return SetSymbolCore(context, static_pointer_cast<const void>(value));
+		const shared_ptr<ExecutionContext> context, const int value) const {
+	return SetSymbolCore(context, Value(value));
 }
 
 const ErrorListRef ArrayVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<double> value) const {
-	return SetSymbolCore(context, static_pointer_cast<const void>(value));
+		const shared_ptr<ExecutionContext> context, const double value) const {
+	return SetSymbolCore(context, Value(value));
 }
 
 const ErrorListRef ArrayVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<string> value) const {
-	return SetSymbolCore(context, static_pointer_cast<const void>(value));
+	return SetSymbolCore(context, value);
 }
 
 const ErrorListRef ArrayVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<Array> value) const {
-	return SetSymbolCore(context, static_pointer_cast<const void>(value));
+	return SetSymbolCore(context, value);
 }
 
 const ErrorListRef ArrayVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<CompoundTypeInstance> value) const {
-	return SetSymbolCore(context, static_pointer_cast<const void>(value));
+	return SetSymbolCore(context, value);
 }
 
 const_shared_ptr<TypeSpecifier> ArrayVariable::GetElementType(
 		const shared_ptr<ExecutionContext> context) const {
-	auto base_type_as_array = dynamic_pointer_cast<const ArrayTypeSpecifier>(
+	auto base_type_as_array = specifier_cast<ArrayTypeSpecifier>(
 			m_base_variable->GetType(context));
 
 	if (base_type_as_array) {
@@ -399,7 +391,7 @@ const_shared_ptr<TypeSpecifier> ArrayVariable::GetElementType(
 
 const ErrorListRef ArrayVariable::SetSymbolCore(
 		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<void> value) const {
+		const Value& value) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
 
 	const_shared_ptr<ValidationResult> validation_result = ValidateOperation(
@@ -416,43 +408,37 @@ const ErrorListRef ArrayVariable::SetSymbolCore(
 
 		if (element_type_specifier->IsAssignableTo(
 				PrimitiveTypeSpecifier::GetBoolean())) {
-			new_array = array->WithValue<bool>(index,
-					static_pointer_cast<const bool>(value), *type_table);
+			new_array = array->WithValue(index, value, *type_table);
 		} else if (element_type_specifier->IsAssignableTo(
 				PrimitiveTypeSpecifier::GetInt())) {
-			new_array = array->WithValue<int>(index,
-					static_pointer_cast<const int>(value), *type_table);
+			new_array = array->WithValue(index, value, *type_table);
 		} else if (element_type_specifier->IsAssignableTo(
 				PrimitiveTypeSpecifier::GetDouble())) {
-			new_array = array->WithValue<double>(index,
-					static_pointer_cast<const double>(value), *type_table);
+			new_array = array->WithValue(index, value, *type_table);
 		} else if (element_type_specifier->IsAssignableTo(
 				PrimitiveTypeSpecifier::GetString())) {
-			new_array = array->WithValue<string>(index,
-					static_pointer_cast<const string>(value), *type_table);
+			new_array = array->WithValue(index, value, *type_table);
 		} else {
 			const_shared_ptr<ArrayTypeSpecifier> as_array =
-					std::dynamic_pointer_cast<const ArrayTypeSpecifier>(
+					specifier_cast<ArrayTypeSpecifier>(
 							element_type_specifier);
 			if (as_array) {
-				new_array = array->WithValue<Array>(index,
-						static_pointer_cast<const Array>(value), *type_table);
+				new_array = array->WithValue(index, value, *type_table);
 			}
 
 			const_shared_ptr<CompoundTypeSpecifier> as_compound =
-					std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+					specifier_cast<CompoundTypeSpecifier>(
 							element_type_specifier);
 			if (as_compound) {
-				new_array = array->WithValue<CompoundTypeInstance>(index,
-						static_pointer_cast<const CompoundTypeInstance>(value),
-						*type_table);
+				new_array = array->WithValue(index, value, *type_table);
 			}
 		}
 
-		const SetResult set_result = context->SetSymbol(*GetName(), new_array);
+		const SetResult set_result = context->SetSymbol(GetNameAtom(),
+				new_array);
 
 		errors = ToErrorListRef(set_result,
-				context->GetSymbol(*GetName(), DEEP)->GetType(),
+				context->GetSymbol(GetNameAtom(), DEEP)->GetType(),
 				array->GetTypeSpecifier());
 	}
 
@@ -470,8 +456,7 @@ const ErrorListRef ArrayVariable::Validate(
 				m_expression->GetType(context);
 		if (index_expression_type->IsAssignableTo(
 				PrimitiveTypeSpecifier::GetInt())) {
-			auto base_type_as_array = dynamic_pointer_cast<
-					const ArrayTypeSpecifier>(
+			auto base_type_as_array = specifier_cast<ArrayTypeSpecifier>(
 					m_base_variable->GetType(context));
 
 			if (!base_type_as_array) {
@@ -43,6 +43,14 @@ public:
 		return false;
 	}
 
+	const_shared_ptr<Variable> GetBaseVariable() const {
+		return m_base_variable;
+	}
+
+	const_shared_ptr<Expression> GetIndexExpression() const {
+		return m_expression;
+	}
+
 //	virtual const_shared_ptr<TypeSpecifier> GetInnerMostElementType(
 //			const shared_ptr<ExecutionContext> context) const;
 
@@ -63,15 +71,15 @@ public:
 protected:
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<bool> value) const;
+			const bool value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<int> value) const;
+			const int value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<double> value) const;
+			const double value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
@@ -124,7 +132,7 @@ private:
 			const shared_ptr<ExecutionContext> context) const;
 
 	const ErrorListRef SetSymbolCore(const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<void> value) const;
+			const Value& value) const;
 };
 
 #endif /* ARRAY_VARIABLE_H_ */
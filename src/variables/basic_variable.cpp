@@ -47,7 +47,7 @@ const_shared_ptr<string> BasicVariable::ToString(
 
 const_shared_ptr<TypeSpecifier> BasicVariable::GetType(
 		const shared_ptr<ExecutionContext> context) const {
-	auto symbol = context->GetSymbol(GetName(), DEEP);
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
 	return symbol->GetType();
 }
 
@@ -55,7 +55,8 @@ const_shared_ptr<Result> BasicVariable::Evaluate(
 		const shared_ptr<ExecutionContext> context) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	const_shared_ptr<Symbol> symbol = context->GetSymbol(GetName(), DEEP);
+	const_shared_ptr<Symbol> symbol = context->GetSymbol(GetNameAtom(),
+			m_reference);
 	auto result_symbol = Symbol::GetDefaultSymbol();
 
 	if (symbol && symbol != Symbol::GetDefaultSymbol()) {
@@ -90,64 +91,64 @@ const ErrorListRef BasicVariable::AssignValue(
 	const int variable_line = GetLocation().begin.line;
 	const int variable_column = GetLocation().begin.column;
 
-	const_shared_ptr<Symbol> symbol = output_context->GetSymbol(variable_name,
-			DEEP);
+	const_shared_ptr<Symbol> symbol = output_context->GetSymbol(GetNameAtom(),
+			m_reference);
 	const_shared_ptr<TypeSpecifier> symbol_type = symbol->GetType();
 	auto symbol_value = symbol->GetValue();
 
 	const_shared_ptr<PrimitiveTypeSpecifier> as_primitive =
-			dynamic_pointer_cast<const PrimitiveTypeSpecifier>(symbol_type);
+			specifier_cast<PrimitiveTypeSpecifier>(symbol_type);
 	if (as_primitive) {
 		const BasicType basic_type = as_primitive->GetBasicType();
 		switch (basic_type) {
 		case BOOLEAN: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, variable_line, variable_column,
-					*(static_pointer_cast<const int>(symbol_value)), expression,
+					symbol_value.GetInt(), expression,
 					op, context);
 
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
 				errors = SetSymbol(output_context,
-						static_pointer_cast<const bool>(result->GetData()));
+						result->GetData().GetBoolean());
 			}
 			break;
 		}
 		case INT: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, variable_line, variable_column,
-					*(static_pointer_cast<const int>(symbol_value)), expression,
+					symbol_value.GetInt(), expression,
 					op, context);
 
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
 				errors = SetSymbol(output_context,
-						static_pointer_cast<const int>(result->GetData()));
+						result->GetData().GetInt());
 			}
 			break;
 		}
 		case DOUBLE: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, variable_line, variable_column,
-					*(static_pointer_cast<const double>(symbol_value)),
+					symbol_value.GetDouble(),
 					expression, op, context);
 
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
 				errors = SetSymbol(output_context,
-						static_pointer_cast<const double>(result->GetData()));
+						result->GetData().GetDouble());
 			}
 			break;
 		}
 		case STRING: {
 			const_shared_ptr<Result> result = AssignmentStatement::do_op(
 					variable_name, basic_type, variable_line, variable_column,
-					static_pointer_cast<const string>(symbol_value), expression,
+					symbol_value.GetReference<string>(), expression,
 					op, context);
 			errors = result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
 				errors = SetSymbol(output_context,
-						static_pointer_cast<const string>(result->GetData()));
+						result->GetData().GetReference<string>());
 			}
 			break;
 		}
@@ -157,8 +158,8 @@ const ErrorListRef BasicVariable::AssignValue(
 	}
 
 	//TODO: don't allow += or -= operations on array specifiers
-	const_shared_ptr<ArrayTypeSpecifier> as_array = std::dynamic_pointer_cast<
-			const ArrayTypeSpecifier>(symbol_type);
+	const_shared_ptr<ArrayTypeSpecifier> as_array =
+			specifier_cast<ArrayTypeSpecifier>(symbol_type);
 	if (as_array) {
 		//re-assigning an array reference
 		const_shared_ptr<Result> expression_evaluation = expression->Evaluate(
@@ -166,8 +167,8 @@ const ErrorListRef BasicVariable::AssignValue(
 
 		errors = expression_evaluation->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto result_as_array = static_pointer_cast<const Array>(
-					expression_evaluation->GetData());
+			auto result_as_array =
+					expression_evaluation->GetData().GetReference<Array>();
 
 			if (result_as_array) {
 				errors = SetSymbol(output_context, result_as_array);
@@ -184,15 +185,16 @@ const ErrorListRef BasicVariable::AssignValue(
 
 //TODO: don't allow += or -= operations on compound type specifiers
 	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(symbol_type);
+			specifier_cast<CompoundTypeSpecifier>(symbol_type);
 	if (as_compound) {
 		const_shared_ptr<Result> expression_evaluation = expression->Evaluate(
 				context);
 
 		errors = expression_evaluation->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto new_instance = static_pointer_cast<const CompoundTypeInstance>(
-					expression_evaluation->GetData());
+			auto new_instance =
+					expression_evaluation->GetData().GetReference<
+							CompoundTypeInstance>();
 
 			//we're assigning a struct reference
 			errors = SetSymbol(output_context, new_instance);
@@ -201,36 +203,35 @@ const ErrorListRef BasicVariable::AssignValue(
 
 //TODO: don't allow += or -= operations on function type specifiers
 	const_shared_ptr<FunctionTypeSpecifier> as_function =
-			std::dynamic_pointer_cast<const FunctionTypeSpecifier>(symbol_type);
+			specifier_cast<FunctionTypeSpecifier>(symbol_type);
 	if (as_function) {
 		const_shared_ptr<Result> expression_evaluation = expression->Evaluate(
 				context);
 
 		errors = expression_evaluation->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto function = static_pointer_cast<const Function>(
-					expression_evaluation->GetData());
+			auto function =
+					expression_evaluation->GetData().GetReference<Function>();
 
 			errors = SetSymbol(output_context, function);
 		}
 	}
 
-	const_shared_ptr<SumTypeSpecifier> as_sum = std::dynamic_pointer_cast<
-			const SumTypeSpecifier>(symbol_type);
+	const_shared_ptr<SumTypeSpecifier> as_sum =
+			specifier_cast<SumTypeSpecifier>(symbol_type);
 	if (as_sum) {
 		const_shared_ptr<Result> expression_evaluation = expression->Evaluate(
 				context);
 
 		errors = expression_evaluation->GetErrors();
 		if (ErrorList::IsTerminator(errors)) {
-			auto sum = static_pointer_cast<const Sum>(symbol->GetValue());
+			auto sum = symbol->GetValue().GetReference<Sum>();
 			auto expression_type = expression->GetType(context);
 
 			plain_shared_ptr<Sum> new_sum;
 			if (*symbol->GetType() == *expression_type) {
 				//we're re-assigning an entire sum
-				new_sum = static_pointer_cast<const Sum>(
-						expression_evaluation->GetData());
+				new_sum = expression_evaluation->GetData().GetReference<Sum>();
 			} else if (expression_type->IsAssignableTo(symbol_type)) {
 				new_sum = sum->WithValue(expression_type,
 						expression_evaluation->GetData());
@@ -246,67 +247,79 @@ const ErrorListRef BasicVariable::AssignValue(
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<bool> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
+		const shared_ptr<ExecutionContext> context, const bool value) const {
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference,
+					PrimitiveTypeSpecifier::GetBoolean(), Value(value)),
 			symbol->GetType(), PrimitiveTypeSpecifier::GetBoolean());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<int> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
+		const shared_ptr<ExecutionContext> context, const int value) const {
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference,
+					PrimitiveTypeSpecifier::GetInt(), Value(value)),
 			symbol->GetType(), PrimitiveTypeSpecifier::GetInt());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<double> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
+		const shared_ptr<ExecutionContext> context, const double value) const {
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference,
+					PrimitiveTypeSpecifier::GetDouble(), Value(value)),
 			symbol->GetType(), PrimitiveTypeSpecifier::GetDouble());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<string> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference,
+					PrimitiveTypeSpecifier::GetString(), value),
 			symbol->GetType(), PrimitiveTypeSpecifier::GetString());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<Array> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
-			symbol->GetType(), value->GetTypeSpecifier());
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference,
+					value->GetTypeSpecifier(), value), symbol->GetType(),
+			value->GetTypeSpecifier());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<CompoundTypeInstance> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
-			symbol->GetType(), value->GetTypeSpecifier());
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference,
+					value->GetTypeSpecifier(), value), symbol->GetType(),
+			value->GetTypeSpecifier());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<Function> value) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), value),
-			symbol->GetType(), value->GetType());
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference, value->GetType(),
+					value), symbol->GetType(), value->GetType());
 }
 
 const ErrorListRef BasicVariable::SetSymbol(
 		const shared_ptr<ExecutionContext> context,
 		const_shared_ptr<Sum> sum) const {
-	auto symbol = context->GetSymbol(*GetName(), DEEP);
-	return ToErrorListRef(context->SetSymbol(*GetName(), sum),
-			symbol->GetType(), sum->GetTag());
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
+	return ToErrorListRef(
+			context->SetSymbol(GetNameAtom(), m_reference, sum->GetType(),
+					sum), symbol->GetType(),
+			sum->GetTag());
 }
 
 const_shared_ptr<Variable> BasicVariable::GetDefaultVariable() {
@@ -322,7 +335,7 @@ const ErrorListRef BasicVariable::Validate(
 		const shared_ptr<ExecutionContext> context) const {
 	ErrorListRef errors = ErrorList::GetTerminator();
 
-	auto symbol = context->GetSymbol(GetName(), DEEP);
+	auto symbol = context->GetSymbol(GetNameAtom(), m_reference);
 
 	if (symbol == nullptr || symbol == Symbol::GetDefaultSymbol()) {
 		errors = ErrorList::From(
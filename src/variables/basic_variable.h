@@ -22,6 +22,7 @@
 
 #include <variable.h>
 #include <assignment_type.h>
+#include <execution_context.h>
 
 class BasicVariable: public Variable {
 public:
@@ -52,18 +53,25 @@ public:
 			const shared_ptr<ExecutionContext> output_context,
 			const AssignmentType op) const;
 
+	/**
+	 * The location of this variable's symbol, as resolved by the most recent lookup.
+	 */
+	SymbolReference& GetReference() const {
+		return m_reference;
+	}
+
 protected:
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<bool> value) const;
+			const bool value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<int> value) const;
+			const int value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<double> value) const;
+			const double value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
@@ -85,6 +93,8 @@ protected:
 			const shared_ptr<ExecutionContext> context,
 			const_shared_ptr<Sum> sum) const;
 
+private:
+	mutable SymbolReference m_reference;
 };
 
 #endif /* VARIABLES_BASIC_VARIABLE_H_ */
@@ -7,6 +7,7 @@
 
 #include <compound_type.h>
 #include <member_variable.h>
+#include <basic_variable.h>
 #include <execution_context.h>
 #include <symbol_table.h>
 #include <sstream>
@@ -16,7 +17,8 @@
 MemberVariable::MemberVariable(const_shared_ptr<Variable> container,
 		const_shared_ptr<Variable> member_variable) :
 		Variable(container->GetName(), container->GetLocation()), m_container(
-				container), m_member_variable(member_variable) {
+				container), m_member_variable(member_variable), m_member_as_basic(
+				dynamic_pointer_cast<const BasicVariable>(member_variable)) {
 }
 
 MemberVariable::~MemberVariable() {
@@ -27,13 +29,13 @@ const_shared_ptr<TypeSpecifier> MemberVariable::GetType(
 	const_shared_ptr<TypeSpecifier> container_type_specifier =
 			m_container->GetType(context);
 	const_shared_ptr<CompoundTypeSpecifier> as_compound_type =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+			specifier_cast<CompoundTypeSpecifier>(
 					container_type_specifier);
 	if (as_compound_type) {
 		const_shared_ptr<CompoundTypeInstance> instance =
-				std::static_pointer_cast<const CompoundTypeInstance>(
-						as_compound_type->DefaultValue(
-								*context->GetTypeTable()));
+				as_compound_type->DefaultValue(
+						*context->GetTypeTable()).GetReference<
+						CompoundTypeInstance>();
 		auto new_context = context->WithContents(instance->GetDefinition());
 		const_shared_ptr<TypeSpecifier> result = m_member_variable->GetType(
 				new_context);
@@ -58,7 +60,7 @@ const_shared_ptr<Result> MemberVariable::Evaluate(
 	const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 			context);
 	const_shared_ptr<CompoundTypeSpecifier> as_compound =
-			std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+			specifier_cast<CompoundTypeSpecifier>(
 					container_type);
 
 	if (container_type != PrimitiveTypeSpecifier::GetNone()) {
@@ -68,10 +70,23 @@ const_shared_ptr<Result> MemberVariable::Evaluate(
 
 			errors = container_result->GetErrors();
 			if (ErrorList::IsTerminator(errors)) {
-				auto instance = static_pointer_cast<const CompoundTypeInstance>(
-						container_result->GetData());
+				auto instance =
+						container_result->GetData().GetReference<
+								CompoundTypeInstance>();
 				volatile_shared_ptr<SymbolContext> new_symbol_context =
 						instance->GetDefinition();
+
+				if (m_member_as_basic) {
+					//instances of a type share its layout, so this resolves once per type
+					auto symbol = new_symbol_context->GetLocalSymbol(
+							m_member_as_basic->GetNameAtom(),
+							m_member_as_basic->GetReference());
+					if (symbol != Symbol::GetDefaultSymbol()) {
+						return make_shared<Result>(symbol->GetValue(),
+								errors);
+					}
+				}
+
 				auto new_context = context->WithContents(new_symbol_context);
 				const_shared_ptr<Result> member_result =
 						m_member_variable->Evaluate(new_context);
@@ -93,14 +108,12 @@ const_shared_ptr<Result> MemberVariable::Evaluate(
 				errors);
 	}
 
-	const_shared_ptr<Result> result = make_shared<Result>(
-			const_shared_ptr<void>(nullptr), errors);
+	const_shared_ptr<Result> result = make_shared<Result>(Value(), errors);
 	return result;
 }
 
 const ErrorListRef MemberVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<bool> value) const {
+		const shared_ptr<ExecutionContext> context, const bool value) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
 	const_shared_ptr<Result> container_result = m_container->Evaluate(context);
 
@@ -111,13 +124,14 @@ const ErrorListRef MemberVariable::SetSymbol(
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					container_result->GetData());
-			const string member_name = *(m_member_variable->GetName());
+			auto instance =
+					container_result->GetData().GetReference<
+							CompoundTypeInstance>();
+			const Atom& member_name = m_member_variable->GetNameAtom();
 			set_result = instance->GetDefinition()->SetSymbol(member_name,
 					value);
 		} else {
@@ -132,8 +146,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 }
 
 const ErrorListRef MemberVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<int> value) const {
+		const shared_ptr<ExecutionContext> context, const int value) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
 
 	const_shared_ptr<Result> container_result = m_container->Evaluate(context);
@@ -145,13 +158,14 @@ const ErrorListRef MemberVariable::SetSymbol(
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					container_result->GetData());
-			const string member_name = *(m_member_variable->GetName());
+			auto instance =
+					container_result->GetData().GetReference<
+							CompoundTypeInstance>();
+			const Atom& member_name = m_member_variable->GetNameAtom();
 			set_result = instance->GetDefinition()->SetSymbol(member_name,
 					value);
 		} else {
@@ -166,8 +180,7 @@ const ErrorListRef MemberVariable::SetSymbol(
 }
 
 const ErrorListRef MemberVariable::SetSymbol(
-		const shared_ptr<ExecutionContext> context,
-		const_shared_ptr<double> value) const {
+		const shared_ptr<ExecutionContext> context, const double value) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
 
 	const_shared_ptr<Result> container_result = m_container->Evaluate(context);
@@ -179,13 +192,14 @@ const ErrorListRef MemberVariable::SetSymbol(
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					container_result->GetData());
-			const string member_name = *(m_member_variable->GetName());
+			auto instance =
+					container_result->GetData().GetReference<
+							CompoundTypeInstance>();
+			const Atom& member_name = m_member_variable->GetNameAtom();
 			set_result = instance->GetDefinition()->SetSymbol(member_name,
 					value);
 		} else {
@@ -213,13 +227,14 @@ const ErrorListRef MemberVariable::SetSymbol(
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					container_result->GetData());
-			const string member_name = *(m_member_variable->GetName());
+			auto instance =
+					container_result->GetData().GetReference<
+							CompoundTypeInstance>();
+			const Atom& member_name = m_member_variable->GetNameAtom();
 			set_result = instance->GetDefinition()->SetSymbol(member_name,
 					value);
 		} else {
@@ -244,8 +259,9 @@ const ErrorListRef MemberVariable::AssignValue(
 	errors = container_evaluation->GetErrors();
 	if (ErrorList::IsTerminator(errors)) {
 		//we're assigning a struct member reference
-		auto struct_value = static_pointer_cast<const CompoundTypeInstance>(
-				container_evaluation->GetData());
+		auto struct_value =
+				container_evaluation->GetData().GetReference<
+						CompoundTypeInstance>();
 		shared_ptr<SymbolContext> definition = struct_value->GetDefinition();
 
 		const auto new_parent_context = SymbolContextList::From(context,
@@ -274,13 +290,14 @@ const ErrorListRef MemberVariable::SetSymbol(
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					container_result->GetData());
-			const string member_name = *(m_member_variable->GetName());
+			auto instance =
+					container_result->GetData().GetReference<
+							CompoundTypeInstance>();
+			const Atom& member_name = m_member_variable->GetNameAtom();
 			set_result = instance->GetDefinition()->SetSymbol(member_name,
 					value);
 		} else {
@@ -308,13 +325,14 @@ const ErrorListRef MemberVariable::SetSymbol(
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
-			auto instance = static_pointer_cast<const CompoundTypeInstance>(
-					container_result->GetData());
-			const string member_name = *(m_member_variable->GetName());
+			auto instance =
+					container_result->GetData().GetReference<
+							CompoundTypeInstance>();
+			const Atom& member_name = m_member_variable->GetNameAtom();
 			set_result = instance->GetDefinition()->SetSymbol(member_name,
 					value);
 		} else {
@@ -332,13 +350,13 @@ const ErrorListRef MemberVariable::Validate(
 		const shared_ptr<ExecutionContext> context) const {
 	ErrorListRef errors(ErrorList::GetTerminator());
 
-	auto symbol = context->GetSymbol(m_container->GetName(), DEEP);
+	auto symbol = context->GetSymbol(m_container->GetNameAtom(), DEEP);
 
 	if (symbol && symbol != Symbol::GetDefaultSymbol()) {
 		const_shared_ptr<TypeSpecifier> container_type = m_container->GetType(
 				context);
 		const_shared_ptr<CompoundTypeSpecifier> as_compound =
-				std::dynamic_pointer_cast<const CompoundTypeSpecifier>(
+				specifier_cast<CompoundTypeSpecifier>(
 						container_type);
 
 		if (as_compound) {
@@ -11,6 +11,8 @@
 #include <variable.h>
 #include <assignment_type.h>
 
+class BasicVariable;
+
 class MemberVariable: public Variable {
 public:
 	MemberVariable(const_shared_ptr<Variable> container_variable,
@@ -45,15 +47,15 @@ public:
 protected:
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<bool> value) const;
+			const bool value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<int> value) const;
+			const int value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<double> value) const;
+			const double value) const;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
@@ -70,6 +72,8 @@ protected:
 private:
 	const_shared_ptr<Variable> m_container;
 	const_shared_ptr<Variable> m_member_variable;
+	//set if the member is a plain member name, which can be read from its slot directly
+	const_shared_ptr<BasicVariable> m_member_as_basic;
 };
 
 #endif /* MEMBER_VARIABLE_H_ */
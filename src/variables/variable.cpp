@@ -27,7 +27,7 @@
 #include "expression.h"
 
 Variable::Variable(const_shared_ptr<string> name, yy::location location) :
-		m_name(name), m_location(location) {
+		m_name(name), m_name_atom(*name), m_location(location) {
 	assert(name);
 }
 
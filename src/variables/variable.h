@@ -45,6 +45,13 @@ public:
 		return m_name;
 	}
 
+	/**
+	 * The interned name, which symbol lookups should use.
+	 */
+	const Atom& GetNameAtom() const {
+		return m_name_atom;
+	}
+
 	const yy::location GetLocation() const {
 		return m_location;
 	}
@@ -63,15 +70,15 @@ public:
 protected:
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<bool> value) const = 0;
+			const bool value) const = 0;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<int> value) const = 0;
+			const int value) const = 0;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
-			const_shared_ptr<double> value) const = 0;
+			const double value) const = 0;
 
 	virtual const ErrorListRef SetSymbol(
 			const shared_ptr<ExecutionContext> context,
@@ -91,6 +98,7 @@ protected:
 
 private:
 	const_shared_ptr<string> m_name;
+	const Atom m_name_atom;
 	const yy::location m_location;
 };
 
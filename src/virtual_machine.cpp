@@ -0,0 +1,768 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <virtual_machine.h>
+#include <iostream>
+#include <algorithm>
+#include <assert.h>
+#include <compiler.h>
+#include <execution_context.h>
+#include <statement_block.h>
+#include <for_statement.h>
+#include <expression.h>
+#include <basic_variable.h>
+#include <function.h>
+#include <function_declaration.h>
+#include <declaration_statement.h>
+#include <symbol.h>
+#include <primitive_type_specifier.h>
+#include <error.h>
+#include <utils.h>
+#include <profiler.h>
+#include <statistics.h>
+
+//dispatch through a table of label addresses where the compiler supports it
+#if defined(__GNUC__)
+#define USE_COMPUTED_GOTO 1
+#else
+#define USE_COMPUTED_GOTO 0
+#endif
+
+#if USE_COMPUTED_GOTO
+#define TARGET(name) TARGET_##name: STATISTICS_COUNT_INSTRUCTION(name);
+#define DISPATCH() goto *dispatch_table[pc->opcode]
+#else
+#define TARGET(name) case name: STATISTICS_COUNT_INSTRUCTION(name);
+#define DISPATCH() continue
+#endif
+
+//a computed goto leaves the scope of a handler without running destructors, so
+//any local that owns a reference must go out of scope before the next dispatch
+#define NEXT() do { ++pc; DISPATCH(); } while (0)
+#define JUMP_TO(index) do { pc = instructions + (index); DISPATCH(); } while (0)
+#define CHECK_ERRORS() if (!ErrorList::IsTerminator(errors)) { return errors; }
+
+static const_shared_ptr<Symbol> GetVariableSymbol(
+		const BasicVariable& variable,
+		const shared_ptr<ExecutionContext> execution_context,
+		ErrorListRef& errors) {
+	auto symbol = execution_context->GetSymbol(variable.GetNameAtom(),
+			variable.GetReference());
+	if (symbol == Symbol::GetDefaultSymbol()) {
+		errors = ErrorList::From(
+				make_shared<Error>(Error::SEMANTIC, Error::UNDECLARED_VARIABLE,
+						variable.GetLocation().begin.line,
+						variable.GetLocation().begin.column,
+						*variable.GetName()), errors);
+	}
+	return symbol;
+}
+
+static const ErrorListRef DivisionByZero(const Error::ErrorCode code,
+		const yy::location location) {
+	return ErrorList::From(
+			make_shared<Error>(Error::SEMANTIC, code, location.begin.line,
+					location.begin.column), ErrorList::GetTerminator());
+}
+
+VirtualMachine::VirtualMachine() :
+		m_registers(), m_top(0), m_programs(), m_tail_function(), m_tail_call_site(
+				nullptr), m_tail_arguments(), m_arguments() {
+}
+
+VirtualMachine::~VirtualMachine() {
+}
+
+const ErrorListRef VirtualMachine::Execute(const StatementBlock& block,
+		const shared_ptr<ExecutionContext> execution_context) {
+	return Run(*GetProgram(block, execution_context), execution_context);
+}
+
+const ErrorListRef VirtualMachine::Call(const Function& function,
+		const CallSite& call_site, const Register* arguments, Register& result,
+		const shared_ptr<ExecutionContext> invocation_context) {
+	//lay the call out as an INVOKE would, in a frame of its own
+	const size_t base = m_top;
+	const size_t count = call_site.argument_types.size();
+	m_top += count + 1;
+	if (m_registers.size() < m_top) {
+		m_registers.resize(std::max(m_top, 2 * m_registers.size()));
+	}
+
+	m_registers[base] = Register();
+	std::copy(arguments, arguments + count, m_registers.begin() + base + 1);
+
+	auto errors = Invoke(function, call_site, base, invocation_context);
+	result = std::move(m_registers[base]);
+
+	for (size_t i = base; i < m_top; i++) {
+		m_registers[i].reference = nullptr;
+	}
+	m_top = base;
+
+	return errors;
+}
+
+const_shared_ptr<Program> VirtualMachine::GetProgram(
+		const StatementBlock& block,
+		const shared_ptr<ExecutionContext> execution_context,
+		const_shared_ptr<TypeSpecifier> return_type) {
+	auto existing = m_programs.find(&block);
+	if (existing != m_programs.end()) {
+		return existing->second;
+	}
+
+	Compiler compiler;
+	auto program = compiler.Compile(block, execution_context, return_type);
+	m_programs[&block] = program;
+	return program;
+}
+
+const ErrorListRef VirtualMachine::Run(const Program& program,
+		shared_ptr<ExecutionContext> execution_context) {
+	const size_t frame = m_top;
+	m_top += program.GetRegisterCount();
+	if (m_registers.size() < m_top) {
+		m_registers.resize(std::max(m_top, 2 * m_registers.size()));
+	}
+
+	auto errors = Dispatch(program, execution_context, frame);
+
+	//release references held by this frame
+	for (size_t i = frame; i < m_top; i++) {
+		m_registers[i].reference = nullptr;
+	}
+	m_top = frame;
+
+	return errors;
+}
+
+const ErrorListRef VirtualMachine::Dispatch(const Program& program,
+		shared_ptr<ExecutionContext> execution_context, const size_t frame) {
+#if USE_COMPUTED_GOTO
+#define LABEL_ADDRESS(name) &&TARGET_##name,
+	static const void* const dispatch_table[] = { OPCODES(LABEL_ADDRESS) };
+#undef LABEL_ADDRESS
+#endif
+
+	ErrorListRef errors = ErrorList::GetTerminator();
+	const Instruction* const instructions = &program.GetInstructions()[0];
+	const Instruction* pc = instructions;
+	Register* r = &m_registers[frame];
+	std::vector<shared_ptr<ExecutionContext>> parent_contexts;
+
+#if USE_COMPUTED_GOTO
+	DISPATCH();
+#else
+	for (;;) {
+		switch (pc->opcode) {
+#endif
+
+	TARGET(HALT) {
+		return errors;
+	}
+
+	TARGET(MOVE) {
+		r[pc->a] = r[pc->b];
+		NEXT();
+	}
+
+	TARGET(LOAD_INT) {
+		r[pc->a].int_value = pc->b;
+		NEXT();
+	}
+
+	TARGET(LOAD_DOUBLE) {
+		r[pc->a].double_value = program.GetDouble(pc->b);
+		NEXT();
+	}
+
+	TARGET(LOAD_REFERENCE) {
+		r[pc->a].reference = program.GetReference(pc->b);
+		NEXT();
+	}
+
+	TARGET(LOAD_BOOLEAN_SYMBOL) {
+		r[pc->a].int_value = GetVariableSymbol(*program.GetVariable(pc->b),
+				execution_context, errors)->GetValue().GetBoolean();
+		CHECK_ERRORS();
+		NEXT();
+	}
+
+	TARGET(LOAD_INT_SYMBOL) {
+		r[pc->a].int_value = GetVariableSymbol(*program.GetVariable(pc->b),
+				execution_context, errors)->GetValue().GetInt();
+		CHECK_ERRORS();
+		NEXT();
+	}
+
+	TARGET(LOAD_DOUBLE_SYMBOL) {
+		r[pc->a].double_value = GetVariableSymbol(*program.GetVariable(pc->b),
+				execution_context, errors)->GetValue().GetDouble();
+		CHECK_ERRORS();
+		NEXT();
+	}
+
+	TARGET(LOAD_REFERENCE_SYMBOL) {
+		r[pc->a].reference = GetVariableSymbol(*program.GetVariable(pc->b),
+				execution_context, errors)->GetValue().GetReference();
+		CHECK_ERRORS();
+		NEXT();
+	}
+
+	TARGET(STORE_BOOLEAN_SYMBOL) {
+		{
+			auto& variable = program.GetVariable(pc->b);
+			const Value value(r[pc->a].int_value != 0);
+			errors = ToErrorListRef(
+					execution_context->SetSymbol(variable->GetNameAtom(),
+							variable->GetReference(),
+							PrimitiveTypeSpecifier::GetBoolean(), value),
+					variable->GetLocation(), variable->GetName(),
+					PrimitiveTypeSpecifier::GetBoolean(),
+					PrimitiveTypeSpecifier::GetBoolean());
+			CHECK_ERRORS();
+		}
+		NEXT();
+	}
+
+	TARGET(STORE_INT_SYMBOL) {
+		{
+			auto& variable = program.GetVariable(pc->b);
+			const Value value(r[pc->a].int_value);
+			errors = ToErrorListRef(
+					execution_context->SetSymbol(variable->GetNameAtom(),
+							variable->GetReference(),
+							PrimitiveTypeSpecifier::GetInt(), value),
+					variable->GetLocation(), variable->GetName(),
+					PrimitiveTypeSpecifier::GetInt(),
+					PrimitiveTypeSpecifier::GetInt());
+			CHECK_ERRORS();
+		}
+		NEXT();
+	}
+
+	TARGET(STORE_DOUBLE_SYMBOL) {
+		{
+			auto& variable = program.GetVariable(pc->b);
+			const Value value(r[pc->a].double_value);
+			errors = ToErrorListRef(
+					execution_context->SetSymbol(variable->GetNameAtom(),
+							variable->GetReference(),
+							PrimitiveTypeSpecifier::GetDouble(), value),
+					variable->GetLocation(), variable->GetName(),
+					PrimitiveTypeSpecifier::GetDouble(),
+					PrimitiveTypeSpecifier::GetDouble());
+			CHECK_ERRORS();
+		}
+		NEXT();
+	}
+
+	TARGET(STORE_STRING_SYMBOL) {
+		{
+			auto& variable = program.GetVariable(pc->b);
+			const_shared_ptr<string> value = static_pointer_cast<const string>(
+					r[pc->a].reference);
+			errors = ToErrorListRef(
+					execution_context->SetSymbol(variable->GetNameAtom(),
+							variable->GetReference(),
+							PrimitiveTypeSpecifier::GetString(), value),
+					variable->GetLocation(), variable->GetName(),
+					PrimitiveTypeSpecifier::GetString(),
+					PrimitiveTypeSpecifier::GetString());
+			CHECK_ERRORS();
+		}
+		NEXT();
+	}
+
+	TARGET(INT_TO_DOUBLE) {
+		const int value = r[pc->a].int_value;
+		r[pc->a].double_value = value;
+		NEXT();
+	}
+
+	TARGET(BOOLEAN_TO_STRING) {
+		r[pc->a].reference = AsString((bool) r[pc->a].int_value);
+		NEXT();
+	}
+
+	TARGET(INT_TO_STRING) {
+		r[pc->a].reference = AsString(r[pc->a].int_value);
+		NEXT();
+	}
+
+	TARGET(DOUBLE_TO_STRING) {
+		r[pc->a].reference = AsString(r[pc->a].double_value);
+		NEXT();
+	}
+
+	TARGET(INT_TO_BOOLEAN) {
+		r[pc->a].int_value = r[pc->a].int_value != 0;
+		NEXT();
+	}
+
+	TARGET(DOUBLE_TO_BOOLEAN) {
+		const double value = r[pc->a].double_value;
+		r[pc->a].int_value = value != 0;
+		NEXT();
+	}
+
+	TARGET(ADD_INT) {
+		r[pc->a].int_value += r[pc->b].int_value;
+		NEXT();
+	}
+
+	TARGET(SUBTRACT_INT) {
+		r[pc->a].int_value -= r[pc->b].int_value;
+		NEXT();
+	}
+
+	TARGET(MULTIPLY_INT) {
+		r[pc->a].int_value *= r[pc->b].int_value;
+		NEXT();
+	}
+
+	TARGET(DIVIDE_INT) {
+		if (r[pc->b].int_value == 0) {
+			return DivisionByZero(Error::DIVIDE_BY_ZERO,
+					program.GetLocation(pc->c));
+		}
+		r[pc->a].int_value /= r[pc->b].int_value;
+		NEXT();
+	}
+
+	TARGET(MODULUS_INT) {
+		if (r[pc->b].int_value == 0) {
+			return DivisionByZero(Error::MOD_BY_ZERO,
+					program.GetLocation(pc->c));
+		}
+		r[pc->a].int_value %= r[pc->b].int_value;
+		NEXT();
+	}
+
+	TARGET(ADD_DOUBLE) {
+		r[pc->a].double_value += r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(SUBTRACT_DOUBLE) {
+		r[pc->a].double_value -= r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(MULTIPLY_DOUBLE) {
+		r[pc->a].double_value *= r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(DIVIDE_DOUBLE) {
+		if (r[pc->b].double_value == 0.0) {
+			return DivisionByZero(Error::DIVIDE_BY_ZERO,
+					program.GetLocation(pc->c));
+		}
+		r[pc->a].double_value /= r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(CONCATENATE) {
+		const string& left = *static_cast<const string*>(r[pc->a].reference.get());
+		const string& right =
+				*static_cast<const string*>(r[pc->b].reference.get());
+		r[pc->a].reference = make_shared<string>(left + right);
+		NEXT();
+	}
+
+#define COMPARISON(name, field, op) \
+	TARGET(name) { \
+		r[pc->a].int_value = r[pc->a].field op r[pc->b].field; \
+		NEXT(); \
+	}
+
+#define STRING_COMPARISON(name, op) \
+	TARGET(name) { \
+		const bool result = *static_cast<const string*>(r[pc->a].reference.get()) \
+				op *static_cast<const string*>(r[pc->b].reference.get()); \
+		r[pc->a].int_value = result; \
+		NEXT(); \
+	}
+
+	COMPARISON(EQUAL_INT, int_value, ==)
+	COMPARISON(NOT_EQUAL_INT, int_value, !=)
+	COMPARISON(LESS_THAN_INT, int_value, <)
+	COMPARISON(LESS_THAN_EQUAL_INT, int_value, <=)
+	COMPARISON(GREATER_THAN_INT, int_value, >)
+	COMPARISON(GREATER_THAN_EQUAL_INT, int_value, >=)
+
+	TARGET(EQUAL_DOUBLE) {
+		const double left = r[pc->a].double_value;
+		r[pc->a].int_value = left == r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(NOT_EQUAL_DOUBLE) {
+		const double left = r[pc->a].double_value;
+		r[pc->a].int_value = left != r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(LESS_THAN_DOUBLE) {
+		const double left = r[pc->a].double_value;
+		r[pc->a].int_value = left < r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(LESS_THAN_EQUAL_DOUBLE) {
+		const double left = r[pc->a].double_value;
+		r[pc->a].int_value = left <= r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(GREATER_THAN_DOUBLE) {
+		const double left = r[pc->a].double_value;
+		r[pc->a].int_value = left > r[pc->b].double_value;
+		NEXT();
+	}
+
+	TARGET(GREATER_THAN_EQUAL_DOUBLE) {
+		const double left = r[pc->a].double_value;
+		r[pc->a].int_value = left >= r[pc->b].double_value;
+		NEXT();
+	}
+
+	STRING_COMPARISON(EQUAL_STRING, ==)
+	STRING_COMPARISON(NOT_EQUAL_STRING, !=)
+	STRING_COMPARISON(LESS_THAN_STRING, <)
+	STRING_COMPARISON(LESS_THAN_EQUAL_STRING, <=)
+	STRING_COMPARISON(GREATER_THAN_STRING, >)
+	STRING_COMPARISON(GREATER_THAN_EQUAL_STRING, >=)
+
+#undef COMPARISON
+#undef STRING_COMPARISON
+
+	TARGET(NEGATE_INT) {
+		r[pc->a].int_value = -r[pc->a].int_value;
+		NEXT();
+	}
+
+	TARGET(NEGATE_DOUBLE) {
+		r[pc->a].double_value = -r[pc->a].double_value;
+		NEXT();
+	}
+
+	TARGET(LOGICAL_NOT) {
+		r[pc->a].int_value = !r[pc->a].int_value;
+		NEXT();
+	}
+
+	TARGET(JUMP) {
+		//loops jump back to their condition, so jumps are profiler safepoints
+		if (Profiler::IsSamplePending()) {
+			Profiler::GetActive()->Sample(
+					program.GetLine(pc - instructions));
+		}
+		JUMP_TO(pc->b);
+	}
+
+	TARGET(JUMP_IF_FALSE) {
+		if (!r[pc->a].int_value) {
+			JUMP_TO(pc->b);
+		}
+		NEXT();
+	}
+
+	TARGET(JUMP_IF_TRUE) {
+		if (r[pc->a].int_value) {
+			JUMP_TO(pc->b);
+		}
+		NEXT();
+	}
+
+	TARGET(JUMP_IF_HALTED) {
+		if (execution_context->GetReturnValue() != Symbol::GetDefaultSymbol()
+				|| execution_context->GetExitCode()) {
+			JUMP_TO(pc->b);
+		}
+		NEXT();
+	}
+
+	TARGET(ENTER_BLOCK) {
+		parent_contexts.push_back(execution_context);
+		execution_context = program.GetLoop(pc->b)->GetBlockContext(
+				execution_context);
+		NEXT();
+	}
+
+	TARGET(LEAVE_BLOCK) {
+		execution_context = parent_contexts.back();
+		parent_contexts.pop_back();
+		NEXT();
+	}
+
+	TARGET(PRINT_BOOLEAN) {
+		std::cout << (bool) r[pc->a].int_value << "\n";
+		NEXT();
+	}
+
+	TARGET(PRINT_INT) {
+		std::cout << r[pc->a].int_value << "\n";
+		NEXT();
+	}
+
+	TARGET(PRINT_DOUBLE) {
+		std::cout << r[pc->a].double_value << "\n";
+		NEXT();
+	}
+
+	TARGET(PRINT_STRING) {
+		std::cout << *static_cast<const string*>(r[pc->a].reference.get())
+				<< "\n";
+		NEXT();
+	}
+
+	TARGET(RETURN_BOOLEAN) {
+		execution_context->SetReturnValue(
+				make_shared<Symbol>(r[pc->a].int_value != 0));
+		NEXT();
+	}
+
+	TARGET(RETURN_INT) {
+		execution_context->SetReturnValue(
+				make_shared<Symbol>(r[pc->a].int_value));
+		NEXT();
+	}
+
+	TARGET(RETURN_DOUBLE) {
+		execution_context->SetReturnValue(
+				make_shared<Symbol>(r[pc->a].double_value));
+		NEXT();
+	}
+
+	TARGET(RETURN_STRING) {
+		execution_context->SetReturnValue(
+				make_shared<Symbol>(
+						static_pointer_cast<const string>(
+								r[pc->a].reference)));
+		NEXT();
+	}
+
+	TARGET(EXIT) {
+		execution_context->SetExitCode(make_shared<int>(r[pc->a].int_value));
+		NEXT();
+	}
+
+	TARGET(EXECUTE) {
+		STATISTICS_COUNT(STATEMENTS, *program.GetStatement(pc->b));
+		errors = program.GetStatement(pc->b)->execute(execution_context);
+		CHECK_ERRORS();
+		NEXT();
+	}
+
+#define EVALUATE(name, field, getter) \
+	TARGET(name) { \
+		{ \
+			auto result = program.GetExpression(pc->b)->Evaluate( \
+					execution_context); \
+			errors = result->GetErrors(); \
+			CHECK_ERRORS(); \
+			auto& value = result->GetData(); \
+			if (!value.IsEmpty()) { \
+				r[pc->a].field = value.getter(); \
+			} \
+		} \
+		NEXT(); \
+	}
+
+	EVALUATE(EVALUATE_BOOLEAN, int_value, GetBoolean)
+	EVALUATE(EVALUATE_INT, int_value, GetInt)
+	EVALUATE(EVALUATE_DOUBLE, double_value, GetDouble)
+
+#undef EVALUATE
+
+	TARGET(EVALUATE_REFERENCE) {
+		{
+			auto result = program.GetExpression(pc->b)->Evaluate(
+					execution_context);
+			errors = result->GetErrors();
+			CHECK_ERRORS();
+			r[pc->a].reference = result->GetData().GetReference();
+		}
+		NEXT();
+	}
+
+	TARGET(INVOKE) {
+		if (Profiler::IsSamplePending()) {
+			Profiler::GetActive()->Sample(
+					program.GetLine(pc - instructions));
+		}
+
+		{
+			auto function = static_pointer_cast<const Function>(
+					r[pc->a].reference);
+			errors = Invoke(*function, program.GetCallSite(pc->c),
+					frame + pc->a, execution_context);
+			CHECK_ERRORS();
+		}
+
+		//the register file may have grown during the call
+		r = &m_registers[frame];
+		NEXT();
+	}
+
+	TARGET(TAIL_INVOKE) {
+		//the arguments are copied out, since this frame is released before the call
+		m_tail_function = static_pointer_cast<const Function>(
+				r[pc->a].reference);
+		m_tail_call_site = &program.GetCallSite(pc->c);
+		m_tail_arguments.assign(r + pc->a + 1, r + pc->a + 1 + pc->b);
+		NEXT();
+	}
+
+#if !USE_COMPUTED_GOTO
+		default:
+			assert(false);
+			return errors;
+		}
+	}
+#endif
+}
+
+const ErrorListRef VirtualMachine::BindArguments(const Function& function,
+		const CallSite& call_site, const Register* arguments,
+		const shared_ptr<ExecutionContext> function_execution_context,
+		const shared_ptr<ExecutionContext> invocation_context) {
+	ErrorListRef errors = ErrorList::GetTerminator();
+
+	//bind arguments, which the compiler has already converted to the parameter types
+	DeclarationListRef parameter = function.GetType()->GetParameterList();
+	for (size_t i = 0; i < call_site.argument_types.size(); i++) {
+		const_shared_ptr<DeclarationStatement> declaration =
+				parameter->GetData();
+		const Register& argument = arguments[i];
+
+		plain_shared_ptr<Symbol> symbol;
+		switch (call_site.argument_types[i]) {
+		case BOOLEAN:
+			symbol = make_shared<Symbol>(argument.int_value != 0);
+			break;
+		case INT:
+			symbol = make_shared<Symbol>(argument.int_value);
+			break;
+		case DOUBLE:
+			symbol = make_shared<Symbol>(argument.double_value);
+			break;
+		default:
+			symbol = make_shared<Symbol>(
+					static_pointer_cast<const string>(argument.reference));
+			break;
+		}
+
+		if (!function.BindArgument(i, declaration, symbol,
+				function_execution_context)) {
+			errors = ErrorList::From(
+					make_shared<Error>(Error::SEMANTIC,
+							Error::PREVIOUS_DECLARATION,
+							declaration->GetNamePosition().begin.line,
+							declaration->GetNamePosition().begin.column,
+							*declaration->GetName()), errors);
+		}
+
+		parameter = parameter->GetNext();
+	}
+
+	return ErrorList::Concatenate(errors,
+			function.BindDefaultParameters(parameter,
+					function_execution_context, invocation_context));
+}
+
+const ErrorListRef VirtualMachine::Invoke(const Function& function,
+		const CallSite& call_site, const size_t base,
+		const shared_ptr<ExecutionContext> invocation_context) {
+	ErrorListRef errors = ErrorList::GetTerminator();
+
+	const Function* callee = &function;
+	const CallSite* callee_site = &call_site;
+	plain_shared_ptr<Function> tail_function;
+	shared_ptr<ExecutionContext> caller_context = invocation_context;
+	const Register* arguments = m_registers.data() + base + 1;
+	Value value;
+	ProfiledCall profiled_call(*call_site.name, call_site.line);
+
+	//each tail call replaces the frame of the function that made it
+	while (true) {
+		auto function_execution_context = callee->CreateExecutionContext(
+				caller_context);
+		errors = BindArguments(*callee, *callee_site, arguments,
+				function_execution_context, caller_context);
+		CHECK_ERRORS();
+
+		auto final_execution_context = callee->GetFinalExecutionContext(
+				function_execution_context);
+		auto body = callee->GetBody();
+		errors = callee->PreprocessBody(final_execution_context);
+		CHECK_ERRORS();
+
+		errors = Run(
+				*GetProgram(*body, final_execution_context,
+						callee->GetType()->GetReturnType()),
+				final_execution_context);
+		if (!m_tail_function) {
+			value = callee->GetReturnValue(final_execution_context);
+			CHECK_ERRORS();
+			break;
+		}
+
+		//the arguments are read from a buffer of their own, since the call
+		//may itself make a tail call
+		tail_function = std::move(m_tail_function);
+		callee = tail_function.get();
+		callee_site = m_tail_call_site;
+		m_arguments.swap(m_tail_arguments);
+
+		Profiler* profiler = Profiler::GetActive();
+		if (profiler) {
+			profiler->Rename(*callee_site->name);
+		}
+		arguments = m_arguments.data();
+		caller_context = final_execution_context;
+	}
+
+	Register& result = m_registers[base];
+	switch (call_site.result_type) {
+	case BOOLEAN:
+		if (!value.IsEmpty()) {
+			result.int_value = value.GetBoolean();
+		}
+		break;
+	case INT:
+		if (!value.IsEmpty()) {
+			result.int_value = value.GetInt();
+		}
+		break;
+	case DOUBLE:
+		if (!value.IsEmpty()) {
+			result.double_value = value.GetDouble();
+		}
+		break;
+	default:
+		result.reference = value.GetReference();
+		break;
+	}
+
+	return errors;
+}
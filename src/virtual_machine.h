@@ -0,0 +1,96 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIRTUAL_MACHINE_H_
+#define VIRTUAL_MACHINE_H_
+
+#include <vector>
+#include <unordered_map>
+#include <bytecode.h>
+#include <statement.h>
+
+class StatementBlock;
+class Function;
+class TypeSpecifier;
+
+/**
+ * Executes statement blocks by compiling them to bytecode and running the result on a
+ * register machine. Execution contexts are shared with the tree-walking interpreter,
+ * so the two may be mixed freely.
+ */
+class VirtualMachine {
+public:
+	VirtualMachine();
+	virtual ~VirtualMachine();
+
+	/**
+	 * Execute a preprocessed statement block in the given context.
+	 */
+	const ErrorListRef Execute(const StatementBlock& block,
+			const shared_ptr<ExecutionContext> execution_context);
+
+	/**
+	 * Invoke a function from outside of any running program. The arguments, one
+	 * for each argument type of the call site, must already have been converted
+	 * to the types of the parameters they are bound to. The result is stored in
+	 * the given register.
+	 */
+	const ErrorListRef Call(const Function& function, const CallSite& call_site,
+			const Register* arguments, Register& result,
+			const shared_ptr<ExecutionContext> invocation_context);
+
+private:
+	const_shared_ptr<Program> GetProgram(const StatementBlock& block,
+			const shared_ptr<ExecutionContext> execution_context,
+			const_shared_ptr<TypeSpecifier> return_type = nullptr);
+
+	const ErrorListRef Run(const Program& program,
+			shared_ptr<ExecutionContext> execution_context);
+	const ErrorListRef Dispatch(const Program& program,
+			shared_ptr<ExecutionContext> execution_context, const size_t frame);
+
+	/**
+	 * Invoke a function. The arguments are read from the registers following the base
+	 * register, and the result is stored in the base register.
+	 */
+	const ErrorListRef Invoke(const Function& function,
+			const CallSite& call_site, const size_t base,
+			const shared_ptr<ExecutionContext> invocation_context);
+
+	/**
+	 * Bind the arguments of an invocation, followed by the defaults of any remaining
+	 * parameters.
+	 */
+	const ErrorListRef BindArguments(const Function& function,
+			const CallSite& call_site, const Register* arguments,
+			const shared_ptr<ExecutionContext> function_execution_context,
+			const shared_ptr<ExecutionContext> invocation_context);
+
+	std::vector<Register> m_registers;
+	size_t m_top;
+	std::unordered_map<const StatementBlock*, plain_shared_ptr<Program>> m_programs;
+
+	//the call left by a TAIL_INVOKE, to be made by the enclosing Invoke
+	plain_shared_ptr<Function> m_tail_function;
+	const CallSite* m_tail_call_site;
+	std::vector<Register> m_tail_arguments;
+	std::vector<Register> m_arguments;
+};
+
+#endif /* VIRTUAL_MACHINE_H_ */
@@ -0,0 +1,156 @@
+/*
+ Copyright (C) 2015 The newt Authors.
+
+ This file is part of newt.
+
+ newt is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ newt is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with newt.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//test: use scripts through the embedding API from several threads, checking
+//the results of their calls. Run under AddressSanitizer, it also checks that
+//no thread is left holding the state of a script that has been destroyed.
+
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <script.h>
+
+namespace {
+//enough calls for the cycle collector to run during them
+const int CALLS = 3000;
+
+const std::shared_ptr<Script> Load(const std::string& file_name) {
+	std::vector<std::string> errors;
+	auto script = Script::Load(file_name, errors);
+	for (auto error : errors) {
+		std::cerr << error << std::endl;
+	}
+	return script;
+}
+
+const bool Call(ScriptFunction& function, const int argument) {
+	std::vector<ScriptValue> arguments(1, ScriptValue(argument));
+	ScriptValue result;
+	std::vector<std::string> errors;
+	if (!function.Call(arguments, result, errors)) {
+		for (auto error : errors) {
+			std::cerr << error << std::endl;
+		}
+		return false;
+	}
+
+	if (result.GetInt() != argument + 1) {
+		std::cerr << function.GetName() << "(" << argument << ") returned "
+				<< result.ToString() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+const bool CallRepeatedly(ScriptFunction& function, const int calls) {
+	for (int i = 0; i < calls; i++) {
+		if (!Call(function, i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//call a script on a thread that outlives it
+const bool TestScriptDestroyedBeforeThread(const std::string& file_name) {
+	auto script = Load(file_name);
+	if (!script) {
+		return false;
+	}
+	auto function = script->GetFunction("f");
+
+	std::promise<bool> called;
+	std::promise<void> destroyed;
+	std::thread worker([&]() {
+		called.set_value(CallRepeatedly(*function, 10));
+		destroyed.get_future().wait();
+	});
+
+	const bool result = called.get_future().get();
+	function = nullptr;
+	script = nullptr;
+	destroyed.set_value();
+	worker.join();
+	return result;
+}
+
+//hand a script from thread to thread, one at a time
+const bool TestScriptMovedBetweenThreads(const std::string& file_name) {
+	auto script = Load(file_name);
+	if (!script) {
+		return false;
+	}
+	auto function = script->GetFunction("f");
+
+	for (int i = 0; i < 4; i++) {
+		bool result = false;
+		std::thread worker([&]() {
+			result = CallRepeatedly(*function, CALLS);
+		});
+		worker.join();
+		if (!result) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//load and call a script of its own on each of several threads at once
+const bool TestScriptsOnConcurrentThreads(const std::string& file_name) {
+	const int thread_count = 4;
+	std::vector<std::future<bool>> results;
+	for (int i = 0; i < thread_count; i++) {
+		results.push_back(std::async(std::launch::async, [&]() {
+			auto script = Load(file_name);
+			return script && CallRepeatedly(*script->GetFunction("f"), CALLS);
+		}));
+	}
+
+	bool result = true;
+	for (auto& thread_result : results) {
+		result = thread_result.get() && result;
+	}
+	return result;
+}
+}
+
+int main(int argc, char *argv[]) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <script>" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const std::string file_name = argv[1];
+	if (!TestScriptDestroyedBeforeThread(file_name)) {
+		std::cerr << "Failed: script destroyed before thread" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (!TestScriptMovedBetweenThreads(file_name)) {
+		std::cerr << "Failed: script moved between threads" << std::endl;
+		return EXIT_FAILURE;
+	}
+	if (!TestScriptsOnConcurrentThreads(file_name)) {
+		std::cerr << "Failed: scripts on concurrent threads" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}